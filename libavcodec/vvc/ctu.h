@@ -24,6 +24,7 @@
 #define AVCODEC_VVC_CTU_H
 
 #include "libavcodec/cabac.h"
+#include "libavcodec/defs.h"
 #include "libavutil/mem_internal.h"
 
 #include "dec.h"
@@ -47,7 +48,9 @@
 
 #define MAX_PB_SIZE             128
 #define MAX_SCALING_RATIO       8
-#define EDGE_EMU_BUFFER_STRIDE  ((MAX_PB_SIZE + 32) * MAX_SCALING_RATIO)
+#define EDGE_EMU_BUFFER_STRIDE  (MAX_PB_SIZE + 32)
+// a reference picture may be up to MAX_SCALING_RATIO times the size of the current picture
+#define EDGE_EMU_BUFFER_STRIDE_SCALED (EDGE_EMU_BUFFER_STRIDE * MAX_SCALING_RATIO)
 
 #define CHROMA_EXTRA_BEFORE     1
 #define CHROMA_EXTRA_AFTER      2
@@ -69,8 +72,10 @@
 #define MAX_NUM_HMVP_CANDS      5
 
 #define SAO_PADDING_SIZE        1
+#define SAO_STRIDE              (2 * MAX_PB_SIZE + AV_INPUT_BUFFER_PADDING_SIZE)
 
 #define ALF_PADDING_SIZE        8
+#define ALF_PADDED_STRIDE       (MAX_CTU_SIZE + 2 * ALF_PADDING_SIZE)
 #define ALF_BLOCK_SIZE          4
 
 #define ALF_BORDER_LUMA         3
@@ -378,13 +383,15 @@ typedef struct VVCLocalContext {
 
     /* *2 for high bit depths */
     DECLARE_ALIGNED(32, uint8_t, edge_emu_buffer)[EDGE_EMU_BUFFER_STRIDE * EDGE_EMU_BUFFER_STRIDE * 2];
+    // EDGE_EMU_BUFFER_STRIDE_SCALED squared, from VVCFrameContext.edge_emu_scaled_pool while running inter
+    uint8_t *edge_emu_buffer_scaled;
     DECLARE_ALIGNED(32, int16_t, tmp)[MAX_PB_SIZE * MAX_PB_SIZE];
     DECLARE_ALIGNED(32, int16_t, tmp1)[MAX_PB_SIZE * MAX_PB_SIZE];
     DECLARE_ALIGNED(32, int16_t, tmp2)[MAX_PB_SIZE * MAX_PB_SIZE];
     DECLARE_ALIGNED(32, uint8_t, ciip_tmp)[MAX_PB_SIZE * MAX_PB_SIZE * 2];
-    DECLARE_ALIGNED(32, uint8_t, sao_buffer)[(MAX_CTU_SIZE + 2 * SAO_PADDING_SIZE) * EDGE_EMU_BUFFER_STRIDE * 2];
-    DECLARE_ALIGNED(32, uint8_t, alf_buffer_luma)[(MAX_CTU_SIZE + 2 * ALF_PADDING_SIZE) * EDGE_EMU_BUFFER_STRIDE * 2];
-    DECLARE_ALIGNED(32, uint8_t, alf_buffer_chroma)[(MAX_CTU_SIZE + 2 * ALF_PADDING_SIZE) * EDGE_EMU_BUFFER_STRIDE * 2];
+    DECLARE_ALIGNED(32, uint8_t, sao_buffer)[(MAX_CTU_SIZE + 2 * SAO_PADDING_SIZE) * SAO_STRIDE + AV_INPUT_BUFFER_PADDING_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, alf_buffer_luma)[(MAX_CTU_SIZE + 2 * ALF_PADDING_SIZE) * ALF_PADDED_STRIDE * 2];
+    DECLARE_ALIGNED(32, uint8_t, alf_buffer_chroma)[(MAX_CTU_SIZE + 2 * ALF_PADDING_SIZE) * ALF_PADDED_STRIDE * 2];
     DECLARE_ALIGNED(32, int32_t, alf_gradient_tmp)[ALF_GRADIENT_SIZE * ALF_GRADIENT_SIZE * ALF_NUM_DIR];
 
     struct {
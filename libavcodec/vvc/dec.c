@@ -331,6 +331,7 @@ static void pic_arrays_free(VVCFrameContext *fc)
     frame_context_for_each_tl(fc, tl_free);
     ff_refstruct_pool_uninit(&fc->rpl_tab_pool);
     ff_refstruct_pool_uninit(&fc->tab_dmvr_mvf_pool);
+    ff_refstruct_pool_uninit(&fc->edge_emu_scaled_pool);
 
     memset(&fc->tab.sz, 0, sizeof(fc->tab.sz));
 }
@@ -366,6 +367,18 @@ static int pic_arrays_init(VVCContext *s, VVCFrameContext *fc)
             return AVERROR(ENOMEM);
     }
 
+    // the scaled edge emulation buffer is too large for every VVCLocalContext, take it from a pool
+    if (fc->tab.sz.ref_pic_resampling != sps->r->sps_ref_pic_resampling_enabled_flag ||
+        fc->tab.sz.pixel_shift != sps->pixel_shift) {
+        ff_refstruct_pool_uninit(&fc->edge_emu_scaled_pool);
+        if (sps->r->sps_ref_pic_resampling_enabled_flag) {
+            fc->edge_emu_scaled_pool = ff_refstruct_pool_alloc(
+                EDGE_EMU_BUFFER_STRIDE_SCALED * EDGE_EMU_BUFFER_STRIDE_SCALED << sps->pixel_shift, 0);
+            if (!fc->edge_emu_scaled_pool)
+                return AVERROR(ENOMEM);
+        }
+    }
+
     fc->tab.sz.ctu_count          = pps->ctb_count;
     fc->tab.sz.ctu_size           = 1 << sps->ctb_log2_size_y << sps->ctb_log2_size_y;
     fc->tab.sz.pic_size_in_min_cb = pps->min_cb_width * pps->min_cb_height;
@@ -377,6 +390,7 @@ static int pic_arrays_init(VVCContext *s, VVCFrameContext *fc)
     fc->tab.sz.ctu_height         = pps->ctb_height;
     fc->tab.sz.chroma_format_idc  = sps->r->sps_chroma_format_idc;
     fc->tab.sz.pixel_shift        = sps->pixel_shift;
+    fc->tab.sz.ref_pic_resampling = sps->r->sps_ref_pic_resampling_enabled_flag;
     fc->tab.sz.bs_width           = (fc->ps.pps->width >> 2) + 1;
     fc->tab.sz.bs_height          = (fc->ps.pps->height >> 2) + 1;
 
@@ -138,6 +138,7 @@ typedef struct VVCFrameContext {
 
     struct FFRefStructPool *tab_dmvr_mvf_pool;
     struct FFRefStructPool *rpl_tab_pool;
+    struct FFRefStructPool *edge_emu_scaled_pool;   ///< only when sps_ref_pic_resampling_enabled_flag is set
 
     struct FFRefStructPool *cu_pool;
     struct FFRefStructPool *tu_pool;
@@ -211,6 +212,7 @@ typedef struct VVCFrameContext {
             int bs_width;
             int bs_height;
             int ibc_buffer_width;       ///< IbcBufWidth
+            int ref_pic_resampling;
         } sz;
     } tab;
 } VVCFrameContext;
@@ -64,6 +64,19 @@ static int vvc_sad(const int16_t *src0, const int16_t *src1, int dx, int dy,
     return sad;
 }
 
+// all the SADs of the 5x5 DMVR search window, in raster order, except the centre one,
+// which the caller already has from the early exit test
+static void vvc_dmvr_sad(int *sad, const int16_t *src0, const int16_t *src1,
+    const int block_w, const int block_h)
+{
+    for (int dy = 0; dy < 5; dy++) {
+        for (int dx = 0; dx < 5; dx++) {
+            if (dx != 2 || dy != 2)
+                sad[dy * 5 + dx] = vvc_sad(src0, src1, dx, dy, block_w, block_h);
+        }
+    }
+}
+
 typedef struct IntraEdgeParams {
     uint8_t* top;
     uint8_t* left;
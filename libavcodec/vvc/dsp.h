@@ -100,6 +100,8 @@ typedef struct VVCInterDSPContext {
     void (*apply_bdof)(uint8_t *dst, ptrdiff_t dst_stride, int16_t *src0, int16_t *src1, int block_w, int block_h);
 
     int (*sad)(const int16_t *src0, const int16_t *src1, int dx, int dy, int block_w, int block_h);
+    // the centre entry sad[12] is unspecified, the SIMD versions compute it with the rest of the row
+    void (*dmvr_sad)(int *sad, const int16_t *src0, const int16_t *src1, int block_w, int block_h);
     void (*dmvr[2][2])(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride, int height,
         intptr_t mx, intptr_t my, int width);
 } VVCInterDSPContext;
@@ -108,6 +110,9 @@ struct VVCLocalContext;
 
 typedef struct VVCIntraDSPContext {
     void (*intra_cclm_pred)(const struct VVCLocalContext *lc, int x0, int y0, int w, int h);
+    void (*cclm_downsample_luma[3 /* 4:2:2, 4:2:0 collocated, 4:2:0 */])(uint8_t *pdsy, const uint8_t *src,
+        ptrdiff_t stride, int w, int h, int avail_t, int avail_l);
+    void (*cclm_linear_pred)(uint8_t *dst, ptrdiff_t stride, const uint8_t *pdsy, int w, int h, int a, int b, int k);
     void (*lmcs_scale_chroma)(struct VVCLocalContext *lc, int *dst, const int *coeff, int w, int h, int x0_cu, int y0_cu);
     void (*intra_pred)(const struct VVCLocalContext *lc, int x0, int y0, int w, int h, int c_idx);
     void (*pred_planar)(uint8_t *src, const uint8_t *top, const uint8_t *left, int w, int h, ptrdiff_t stride);
@@ -120,6 +125,7 @@ typedef struct VVCIntraDSPContext {
         int w, int h, ptrdiff_t stride, int c_idx, int mode, int ref_idx, int filter_flag, int need_pdpc);
     void (*pred_angular_h)(uint8_t *src, const uint8_t *_top, const uint8_t *_left, int w, int h, ptrdiff_t stride,
         int c_idx, int mode, int ref_idx, int filter_flag, int need_pdpc);
+    void (*ibc_copy)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride, int w, int h);
 } VVCIntraDSPContext;
 
 typedef struct VVCItxDSPContext {
@@ -128,11 +134,18 @@ typedef struct VVCItxDSPContext {
     void (*pred_residual_joint)(int *buf, int width, int height, int c_sign, int shift);
 
     void (*itx[N_TX_TYPE][N_TX_SIZE])(int *coeffs, ptrdiff_t step, size_t nz);
+    void (*inv_lfnst)(int *v, const int *u, int no_zero_size, int n_tr_s,
+        int pred_mode_intra, int lfnst_idx, int log2_transform_range);
     void (*transform_bdpcm)(int *coeffs, int width, int height, int vertical, int log2_transform_range);
+    // scale_m holds width entries per row, the SIMD versions read it in groups of 8,
+    // so up to 7 bytes past the last entry must be readable
+    void (*dequant)(int *coeffs, ptrdiff_t stride, int width, int height, const uint8_t *scale_m,
+        int scale, int bd_shift, int log2_transform_range);
 } VVCItxDSPContext;
 
 typedef struct VVCLMCSDSPContext {
     void (*filter)(uint8_t *dst, ptrdiff_t dst_stride, int width, int height, const void *lut);
+    void (*scale_chroma)(int *dst, const int *coeff, int width, int height, int chroma_scale);
 } VVCLMCSDSPContext;
 
 typedef struct VVCLFDSPContext {
@@ -94,6 +94,24 @@ static void FUNC(transform_bdpcm)(int *coeffs, const int width, const int height
     }
 }
 
+// scale_m holds width entries per row
+static void FUNC(dequant)(int *coeffs, const ptrdiff_t stride, const int width, const int height,
+    const uint8_t *scale_m, const int scale, const int bd_shift, const int log2_transform_range)
+{
+    const int bd_offset = (1 << bd_shift) >> 1;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (coeffs[x]) {
+                const int coeff = ((int64_t)coeffs[x] * scale * *scale_m + bd_offset) >> bd_shift;
+                coeffs[x] = av_clip_intp2(coeff, log2_transform_range);
+            }
+            scale_m++;
+        }
+        coeffs += stride;
+    }
+}
+
 static void FUNC(ff_vvc_itx_dsp_init)(VVCItxDSPContext *const itx)
 {
 #define VVC_ITX(TYPE, type, s)                                                  \
@@ -109,6 +127,8 @@ static void FUNC(ff_vvc_itx_dsp_init)(VVCItxDSPContext *const itx)
     itx->add_residual_joint          = FUNC(add_residual_joint);
     itx->pred_residual_joint         = FUNC(pred_residual_joint);
     itx->transform_bdpcm             = FUNC(transform_bdpcm);
+    itx->dequant                     = FUNC(dequant);
+    itx->inv_lfnst                   = ff_vvc_inv_lfnst_1d;
     VVC_ITX(DCT2, dct2, 2)
     VVC_ITX(DCT2, dct2, 64)
     VVC_ITX_COMMON(DCT2, dct2)
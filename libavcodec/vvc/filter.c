@@ -240,7 +240,7 @@ void ff_vvc_sao_filter(VVCLocalContext *lc, int x, int y)
             const int h = fc->ps.pps->height >> fc->ps.sps->vshift[c_idx];
             const int sh = fc->ps.sps->pixel_shift;
 
-            dst_stride = 2*MAX_PB_SIZE + AV_INPUT_BUFFER_PADDING_SIZE;
+            dst_stride = SAO_STRIDE;
             dst = lc->sao_buffer + dst_stride + AV_INPUT_BUFFER_PADDING_SIZE;
 
             if (!edges[TOP]) {
@@ -1205,7 +1205,7 @@ void ff_vvc_alf_filter(VVCLocalContext *lc, const int x0, const int y0)
     const int ry            = y0 >> fc->ps.sps->ctb_log2_size_y;
     const int ctb_size_y    = fc->ps.sps->ctb_size_y;
     const int ps            = fc->ps.sps->pixel_shift;
-    const int padded_stride = EDGE_EMU_BUFFER_STRIDE << ps;
+    const int padded_stride = ALF_PADDED_STRIDE << ps;
     const int padded_offset = padded_stride * ALF_PADDING_SIZE + (ALF_PADDING_SIZE << ps);
     const int c_end         = fc->ps.sps->r->sps_chroma_format_idc ? VVC_MAX_SAMPLE_ARRAYS : 1;
     const int subpic_idx    = lc->sc->sh.r->curr_subpic_idx;
@@ -35,6 +35,20 @@ static void FUNC(lmcs_filter_luma)(uint8_t *_dst, ptrdiff_t dst_stride, const in
     }
 }
 
+// 8.7.5.3 Picture reconstruction with luma dependent chroma residual scaling process for chroma samples
+static void FUNC(lmcs_scale_chroma_residual)(int *dst, const int *coeff, const int width, const int height,
+    const int chroma_scale)
+{
+    for (int i = 0; i < width * height; i++) {
+        const int c = av_clip_intp2(coeff[i], BIT_DEPTH);
+
+        if (c > 0)
+            dst[i] = (c * chroma_scale + (1 << 10)) >> 11;
+        else
+            dst[i] = -((-c * chroma_scale + (1 << 10)) >> 11);
+    }
+}
+
 static av_always_inline int16_t FUNC(alf_clip)(pixel curr, pixel v0, pixel v1, int16_t clip)
 {
     return av_clip(v0 - curr, -clip, clip) + av_clip(v1 - curr, -clip, clip);
@@ -839,7 +853,8 @@ static int FUNC(vvc_v_loop_ladf_level)(const uint8_t *pix, ptrdiff_t stride)
 
 static void FUNC(ff_vvc_lmcs_dsp_init)(VVCLMCSDSPContext *const lmcs)
 {
-    lmcs->filter = FUNC(lmcs_filter_luma);
+    lmcs->filter       = FUNC(lmcs_filter_luma);
+    lmcs->scale_chroma = FUNC(lmcs_scale_chroma_residual);
 }
 
 static void FUNC(ff_vvc_lf_dsp_init)(VVCLFDSPContext *const lf)
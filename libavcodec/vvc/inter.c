@@ -44,7 +44,9 @@ static void subpic_width_height(int *pic_width, int *pic_height,
     *pic_height = pps->subpic_height[subpic_idx] >> sps->vshift[is_chroma];
 }
 
-static int emulated_edge(const VVCLocalContext *lc, uint8_t *dst, const uint8_t **src, ptrdiff_t *src_stride, const VVCFrame *src_frame,
+// dst_stride is in samples
+static int emulated_edge(const VVCLocalContext *lc, uint8_t *dst, const int dst_stride,
+    const uint8_t **src, ptrdiff_t *src_stride, const VVCFrame *src_frame,
     int x_off, int y_off, const int block_w, const int block_h, const int is_chroma)
 {
     const VVCFrameContext *fc = lc->fc;
@@ -62,7 +64,7 @@ static int emulated_edge(const VVCLocalContext *lc, uint8_t *dst, const uint8_t
     if (x_off < extra_before || y_off < extra_before ||
         x_off >= pic_width - block_w - extra_after ||
         y_off >= pic_height - block_h - extra_after) {
-        const ptrdiff_t edge_emu_stride = EDGE_EMU_BUFFER_STRIDE << fc->ps.sps->pixel_shift;
+        const ptrdiff_t edge_emu_stride = dst_stride << fc->ps.sps->pixel_shift;
         int offset     = extra_before * *src_stride      + (extra_before << fc->ps.sps->pixel_shift);
         int buf_offset = extra_before * edge_emu_stride + (extra_before << fc->ps.sps->pixel_shift);
 
@@ -143,7 +145,7 @@ static void emulated_edge_bilinear(const VVCLocalContext *lc, uint8_t *dst, cons
 }
 
 #define MC_EMULATED_EDGE(dst, src, src_stride, x_off, y_off)                                                \
-    emulated_edge(lc, dst, src, src_stride, ref, x_off, y_off, block_w, block_h, is_chroma)
+    emulated_edge(lc, dst, EDGE_EMU_BUFFER_STRIDE, src, src_stride, ref, x_off, y_off, block_w, block_h, is_chroma)
 
 #define MC_EMULATED_EDGE_DMVR(dst, src, src_stride, x_sb, y_sb, x_off, y_off)                               \
     emulated_edge_dmvr(lc, dst, src, src_stride, x_sb, y_sb, x_off, y_off, block_w, block_h, is_chroma)
@@ -373,7 +375,8 @@ static void emulated_edge_scaled(VVCLocalContext *lc, const uint8_t **src, ptrdi
 
     *src  += y0 * *src_stride + (x0 * (1 << fc->ps.sps->pixel_shift));
 
-    emulated_edge(lc, lc->edge_emu_buffer, src, src_stride, ref, x0, y0, src_width, *src_height, is_chroma);
+    emulated_edge(lc, lc->edge_emu_buffer_scaled, EDGE_EMU_BUFFER_STRIDE_SCALED, src, src_stride, ref,
+        x0, y0, src_width, *src_height, is_chroma);
 }
 
 static void mc_scaled(VVCLocalContext *lc, int16_t *dst, const VVCRefPic *refp, const Mv *mv,
@@ -769,11 +772,13 @@ static void dmvr_mv_refine(VVCLocalContext *lc, MvField *mvf, MvField *orig_mv,
 
     if (min_sad >= block_w * block_h) {
         int dmv[2];
+        fc->vvcdsp.inter.dmvr_sad(&sad[0][0], tmp[L0], tmp[L1], block_w, block_h);
+        // the centre of dmvr_sad() is unspecified, use the one computed for the early exit
+        sad[sr_range][sr_range] = min_sad;
         // 8.5.3.4 Array entry selection process
         for (dy = 0; dy < SAD_ARRAY_SIZE; dy++) {
             for (dx = 0; dx < SAD_ARRAY_SIZE; dx++) {
                 if (dx != sr_range || dy != sr_range) {
-                    sad[dy][dx] = fc->vvcdsp.inter.sad(lc->tmp, lc->tmp1, dx, dy, block_w, block_h);
                     if (sad[dy][dx] < min_sad) {
                         min_sad = sad[dy][dx];
                         min_dx = dx;
@@ -22,7 +22,7 @@
 
 #include "libavcodec/h26x/h2656_inter_template.c"
 
-#define TMP_STRIDE EDGE_EMU_BUFFER_STRIDE
+#define TMP_STRIDE EDGE_EMU_BUFFER_STRIDE_SCALED
 static void av_always_inline FUNC(put_scaled)(uint8_t *_dst, const ptrdiff_t _dst_stride,
     const uint8_t *const _src, ptrdiff_t _src_stride, const int src_height,
     const int _x, const int _y, const int dx, const int dy,
@@ -114,15 +114,15 @@ static void FUNC(put_uni_chroma_scaled)(uint8_t *_dst, const ptrdiff_t _dst_stri
 
 static void av_always_inline FUNC(put_uni_w_scaled)(uint8_t *_dst, const ptrdiff_t _dst_stride,
     const uint8_t *const _src, ptrdiff_t _src_stride, const int src_height,
-    const int _x, const int _y, const int dx, const int dy, const int denom, const int wx, const int _ox,
-    const int height, const int8_t *hf, const int8_t *vf, const int width, const int is_chroma)
+    const int _x, const int _y, const int dx, const int dy, const int height, const int denom, const int wx,
+    const int _ox, const int8_t *hf, const int8_t *vf, const int width, const int is_chroma)
 {
     int16_t tmp_array[TMP_STRIDE * MAX_PB_SIZE];
     int16_t *tmp                 = tmp_array;
     pixel *dst                   = (pixel*)_dst;
     const ptrdiff_t dst_stride   = _dst_stride / sizeof(pixel);
     const ptrdiff_t src_stride   = _src_stride / sizeof(pixel);
-    const int shift              = FFMAX(2, 14 - BIT_DEPTH);
+    const int shift              = denom + FFMAX(2, 14 - BIT_DEPTH);
     const int offset             = 1 << (shift - 1);
     const int ox                 = _ox * (1 << (BIT_DEPTH - 8));
     const int taps               = is_chroma ? VVC_INTER_CHROMA_TAPS : VVC_INTER_LUMA_TAPS;
@@ -165,18 +165,18 @@ static void av_always_inline FUNC(put_uni_w_scaled)(uint8_t *_dst, const ptrdiff
 
 static void FUNC(put_uni_luma_w_scaled)(uint8_t *_dst, const ptrdiff_t _dst_stride,
     const uint8_t *_src, ptrdiff_t _src_stride, const int src_height,
-    const int x, const int y, const int dx, const int dy, const int denom, const int wx, const int ox,
-    const int height, const int8_t *hf, const int8_t *vf, const int width)
+    const int x, const int y, const int dx, const int dy, const int height, const int denom, const int wx,
+    const int ox, const int8_t *hf, const int8_t *vf, const int width)
 {
-    FUNC(put_uni_w_scaled)(_dst, _dst_stride, _src, _src_stride, src_height, x, y, dx, dy, denom, wx, ox, height, hf, vf, width, 0);
+    FUNC(put_uni_w_scaled)(_dst, _dst_stride, _src, _src_stride, src_height, x, y, dx, dy, height, denom, wx, ox, hf, vf, width, 0);
 }
 
 static void FUNC(put_uni_chroma_w_scaled)(uint8_t *_dst, const ptrdiff_t _dst_stride,
     const uint8_t *_src, ptrdiff_t _src_stride, const int src_height,
-    const int x, const int y, const int dx, const int dy, const int denom, const int wx, const int ox,
-    const int height, const int8_t *hf, const int8_t *vf, const int width)
+    const int x, const int y, const int dx, const int dy, const int height, const int denom, const int wx,
+    const int ox, const int8_t *hf, const int8_t *vf, const int width)
 {
-    FUNC(put_uni_w_scaled)(_dst, _dst_stride, _src, _src_stride, src_height, x, y, dx, dy,  denom, wx, ox, height, hf, vf, width, 1);
+    FUNC(put_uni_w_scaled)(_dst, _dst_stride, _src, _src_stride, src_height, x, y, dx, dy, height, denom, wx, ox, hf, vf, width, 1);
 }
 
 #undef TMP_STRIDE
@@ -627,6 +627,7 @@ static void FUNC(ff_vvc_inter_dsp_init)(VVCInterDSPContext *const inter)
     inter->apply_bdof           = FUNC(apply_bdof);
     inter->prof_grad_filter     = FUNC(prof_grad_filter);
     inter->sad                  = vvc_sad;
+    inter->dmvr_sad             = vvc_dmvr_sad;
 }
 
 #undef FUNCS
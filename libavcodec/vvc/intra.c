@@ -20,12 +20,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 #include "libavutil/frame.h"
-#include "libavutil/imgutils.h"
 
 #include "data.h"
 #include "inter.h"
 #include "intra.h"
-#include "itx_1d.h"
 
 static int is_cclm(enum IntraPredMode mode)
 {
@@ -82,8 +80,8 @@ static void ilfnst_transform(const VVCLocalContext *lc, TransformBlock *tb)
         int yc = ff_vvc_diag_scan_y[2][2][x];
         u[x] = tb->coeffs[w * yc + xc];
     }
-    ff_vvc_inv_lfnst_1d(v, u, non_zero_size, n_lfnst_out_size, pred_mode_intra,
-                        cu->lfnst_idx, sps->log2_transform_range);
+    lc->fc->vvcdsp.itx.inv_lfnst(v, u, non_zero_size, n_lfnst_out_size, pred_mode_intra,
+                                 cu->lfnst_idx, sps->log2_transform_range);
     if (transpose) {
         int *dst = tb->coeffs;
         const int *src = v;
@@ -414,35 +412,21 @@ static const uint8_t* derive_scale_m(const VVCLocalContext *lc, const TransformB
     return scale_m;
 }
 
-//8.7.3 Scaling process for transform coefficients
-static av_always_inline int scale_coeff(const TransformBlock *tb, int coeff,
-    const int scale, const int scale_m, const int log2_transform_range)
-{
-    coeff = ((int64_t) coeff * scale * scale_m + tb->bd_offset) >> tb->bd_shift;
-    coeff = av_clip_intp2(coeff, log2_transform_range);
-    return coeff;
-}
-
 static void dequant(const VVCLocalContext *lc, const TransformUnit *tu, TransformBlock *tb)
 {
     uint8_t tmp[MAX_TB_SIZE * MAX_TB_SIZE];
+    const VVCFrameContext *fc       = lc->fc;
     const H266RawSliceHeader *rsh   = lc->sc->sh.r;
-    const VVCSPS *sps               = lc->fc->ps.sps;
+    const VVCSPS *sps               = fc->ps.sps;
     const uint8_t *scale_m          = derive_scale_m(lc, tb, tmp);
     int scale;
 
     derive_qp(lc, tu, tb);
     scale = derive_scale(tb, rsh->sh_dep_quant_used_flag);
 
-    for (int y = tb->min_scan_y; y <= tb->max_scan_y; y++) {
-        for (int x = tb->min_scan_x; x <= tb->max_scan_x; x++) {
-            int *coeff = tb->coeffs + y * tb->tb_width + x;
-
-            if (*coeff)
-                *coeff = scale_coeff(tb, *coeff, scale, *scale_m, sps->log2_transform_range);
-            scale_m++;
-        }
-    }
+    fc->vvcdsp.itx.dequant(tb->coeffs + tb->min_scan_y * tb->tb_width + tb->min_scan_x, tb->tb_width,
+        tb->max_scan_x - tb->min_scan_x + 1, tb->max_scan_y - tb->min_scan_y + 1,
+        scale_m, scale, tb->bd_shift, sps->log2_transform_range);
 }
 
 //transmatrix[0][0]
@@ -614,13 +598,13 @@ static void intra_block_copy(const VVCLocalContext *lc, const int c_idx)
     const uint8_t *ibc_buf    = IBC_POS(c_idx, ref_x, ref_y);
     uint8_t *dst              = POS(c_idx, cu->x0, cu->y0);
 
-    av_image_copy_plane(dst, dst_stride, ibc_buf, ibc_stride, rw << ps, h);
+    fc->vvcdsp.intra.ibc_copy(dst, dst_stride, ibc_buf, ibc_stride, rw, h);
 
     if (w > rw) {
         //wrap around, left part
         ibc_buf = IBC_POS(c_idx, 0, ref_y);
         dst  += rw << ps;
-        av_image_copy_plane(dst, dst_stride, ibc_buf, ibc_stride, (w - rw) << ps, h);
+        fc->vvcdsp.intra.ibc_copy(dst, dst_stride, ibc_buf, ibc_stride, w - rw, h);
     }
 }
 
@@ -654,7 +638,7 @@ static void ibc_fill_vir_buf(const VVCLocalContext *lc, const CodingUnit *cu)
         const uint8_t *src   = POS(c_idx, cu->x0, cu->y0);
         uint8_t *ibc_buf     = IBC_POS(c_idx, x, y);
 
-        av_image_copy_plane(ibc_buf, ibc_stride, src, src_stride, cu->cb_width >> hs << ps , cu->cb_height >> vs);
+        fc->vvcdsp.intra.ibc_copy(ibc_buf, ibc_stride, src, src_stride, cu->cb_width >> hs, cu->cb_height >> vs);
     }
 }
 
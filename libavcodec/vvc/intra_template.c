@@ -26,22 +26,17 @@
 
 #define POS(x, y) src[(x) + stride * (y)]
 
-static av_always_inline void FUNC(cclm_linear_pred)(VVCFrameContext *fc, const int x0, const int y0,
-    const int w, const int h, const pixel* pdsy, const int *a, const int *b, const int *k)
+static void FUNC(cclm_linear_pred)(uint8_t *_dst, const ptrdiff_t stride, const uint8_t *_pdsy,
+    const int w, const int h, const int a, const int b, const int k)
 {
-    const VVCSPS *sps = fc->ps.sps;
-    for (int i = 0; i < VVC_MAX_SAMPLE_ARRAYS - 1; i++) {
-        const int c_idx = i + 1;
-        const int x = x0 >> sps->hshift[c_idx];
-        const int y = y0 >> sps->vshift[c_idx];
-        const ptrdiff_t stride = fc->frame->linesize[c_idx] / sizeof(pixel);
-        pixel *src = (pixel*)fc->frame->data[c_idx] + x + y * stride;
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                const int dsy = pdsy[y * w + x];
-                const int pred = ((dsy * a[i]) >> k[i]) + b[i];
-                POS(x, y) = CLIP(pred);
-            }
+    pixel *src        = (pixel *)_dst;
+    const pixel *pdsy = (const pixel *)_pdsy;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const int dsy = pdsy[y * w + x];
+            const int pred = ((dsy * a) >> k) + b;
+            POS(x, y) = CLIP(pred);
         }
     }
 }
@@ -279,23 +274,13 @@ static av_always_inline void FUNC(cclm_get_params)(const VVCLocalContext *lc,
 #undef TOP
 #undef LEFT
 
-static av_always_inline void FUNC(cclm_get_luma_rec_pixels)(const VVCFrameContext *fc,
-    const int x0, const int y0, const int w, const int h, const int avail_t, const int avail_l,
-    pixel *pdsy)
+static av_always_inline void FUNC(cclm_downsample_luma)(pixel *pdsy, const pixel *source,
+    const ptrdiff_t stride, const int w, const int h, const int avail_t, const int avail_l,
+    const int vs, const int collocated)
 {
-    const int hs            = fc->ps.sps->hshift[1];
-    const int vs            = fc->ps.sps->vshift[1];
-    const ptrdiff_t stride  = fc->frame->linesize[0] / sizeof(pixel);
-    const pixel *source     = (pixel*)fc->frame->data[0] + x0 + y0 * stride;
     const pixel *left       = source - avail_l;
     const pixel *top        = source - avail_t * stride;
 
-    const VVCSPS *sps = fc->ps.sps;
-    if (!hs && !vs) {
-        for (int i = 0; i < h; i++)
-            memcpy(pdsy + i * w, source + i * stride, w * sizeof(pixel));
-        return;
-    }
     for (int i = 0; i < h; i++) {
         const pixel *src  = source;
         const pixel *l = left;
@@ -309,7 +294,7 @@ static av_always_inline void FUNC(cclm_get_luma_rec_pixels)(const VVCFrameContex
             }
 
         } else {
-            if (sps->r->sps_chroma_vertical_collocated_flag)  {
+            if (collocated)  {
                 for (int j = 0; j < w; j++) {
                     pixel pred  = (*l + *t + 4 * POS(0, 0) + POS(1, 0) + POS(0, 1) + 4) >> 3;
                     pdsy[i * w + j] = pred;
@@ -333,6 +318,43 @@ static av_always_inline void FUNC(cclm_get_luma_rec_pixels)(const VVCFrameContex
     }
 }
 
+static void FUNC(cclm_downsample_luma_422)(uint8_t *pdsy, const uint8_t *src, const ptrdiff_t stride,
+    const int w, const int h, const int avail_t, const int avail_l)
+{
+    FUNC(cclm_downsample_luma)((pixel *)pdsy, (const pixel *)src, stride, w, h, avail_t, avail_l, 0, 0);
+}
+
+static void FUNC(cclm_downsample_luma_420_collocated)(uint8_t *pdsy, const uint8_t *src, const ptrdiff_t stride,
+    const int w, const int h, const int avail_t, const int avail_l)
+{
+    FUNC(cclm_downsample_luma)((pixel *)pdsy, (const pixel *)src, stride, w, h, avail_t, avail_l, 1, 1);
+}
+
+static void FUNC(cclm_downsample_luma_420)(uint8_t *pdsy, const uint8_t *src, const ptrdiff_t stride,
+    const int w, const int h, const int avail_t, const int avail_l)
+{
+    FUNC(cclm_downsample_luma)((pixel *)pdsy, (const pixel *)src, stride, w, h, avail_t, avail_l, 1, 0);
+}
+
+static av_always_inline void FUNC(cclm_get_luma_rec_pixels)(const VVCFrameContext *fc,
+    const int x0, const int y0, const int w, const int h, const int avail_t, const int avail_l,
+    pixel *pdsy)
+{
+    const int hs            = fc->ps.sps->hshift[1];
+    const int vs            = fc->ps.sps->vshift[1];
+    const ptrdiff_t stride  = fc->frame->linesize[0] / sizeof(pixel);
+    const pixel *source     = (pixel*)fc->frame->data[0] + x0 + y0 * stride;
+
+    const VVCSPS *sps = fc->ps.sps;
+    if (!hs && !vs) {
+        for (int i = 0; i < h; i++)
+            memcpy(pdsy + i * w, source + i * stride, w * sizeof(pixel));
+        return;
+    }
+    fc->vvcdsp.intra.cclm_downsample_luma[vs ? 2 - sps->r->sps_chroma_vertical_collocated_flag : 0](
+        (uint8_t *)pdsy, (const uint8_t *)source, stride, w, h, avail_t, avail_l);
+}
+
 static av_always_inline void FUNC(cclm_pred_default)(VVCFrameContext *fc,
     const int x, const int y, const int w, const int h, const int avail_t, const int avail_l)
 {
@@ -371,7 +393,13 @@ static void FUNC(intra_cclm_pred)(const VVCLocalContext *lc, const int x0, const
     }
     FUNC(cclm_get_luma_rec_pixels)(fc, x0, y0, w, h, avail_t, avail_l, dsy);
     FUNC(cclm_get_params) (lc, x0, y0, w, h, avail_t, avail_l, a, b, k);
-    FUNC(cclm_linear_pred)(fc, x0, y0, w, h, dsy, a, b, k);
+    for (int i = 0; i < VVC_MAX_SAMPLE_ARRAYS - 1; i++) {
+        const int c_idx        = i + 1;
+        const ptrdiff_t stride = fc->frame->linesize[c_idx] / sizeof(pixel);
+        pixel *src = (pixel*)fc->frame->data[c_idx] + x + y * stride;
+
+        fc->vvcdsp.intra.cclm_linear_pred((uint8_t *)src, stride, (const uint8_t *)dsy, w, h, a[i], b[i], k[i]);
+    }
 }
 
 static int FUNC(lmcs_sum_samples)(const pixel *start, ptrdiff_t stride, const int avail, const int target_size)
@@ -433,18 +461,7 @@ static void FUNC(lmcs_scale_chroma)(VVCLocalContext *lc, int *dst, const int *co
 {
     const int chroma_scale = FUNC(lmcs_derive_chroma_scale)(lc, x0_cu, y0_cu);
 
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            const int c = av_clip_intp2(*coeff, BIT_DEPTH);
-
-            if (c > 0)
-                *dst = (c * chroma_scale + (1 << 10)) >> 11;
-            else
-                *dst = -((-c * chroma_scale + (1 << 10)) >> 11);
-            coeff++;
-            dst++;
-        }
-    }
+    lc->fc->vvcdsp.lmcs.scale_chroma(dst, coeff, width, height, chroma_scale);
 }
 
 static av_always_inline void FUNC(ref_filter)(const pixel *left, const pixel *top,
@@ -1000,10 +1017,24 @@ static void FUNC(pred_angular_h)(uint8_t *_src, const uint8_t *_top, const uint8
     }
 }
 
+static void FUNC(ibc_copy)(uint8_t *dst, const ptrdiff_t dst_stride, const uint8_t *src, const ptrdiff_t src_stride,
+    const int w, const int h)
+{
+    for (int y = 0; y < h; y++) {
+        memcpy(dst, src, w * sizeof(pixel));
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
 static void FUNC(ff_vvc_intra_dsp_init)(VVCIntraDSPContext *const intra)
 {
     intra->lmcs_scale_chroma  = FUNC(lmcs_scale_chroma);
     intra->intra_cclm_pred    = FUNC(intra_cclm_pred);
+    intra->cclm_downsample_luma[0] = FUNC(cclm_downsample_luma_422);
+    intra->cclm_downsample_luma[1] = FUNC(cclm_downsample_luma_420_collocated);
+    intra->cclm_downsample_luma[2] = FUNC(cclm_downsample_luma_420);
+    intra->cclm_linear_pred   = FUNC(cclm_linear_pred);
     intra->intra_pred         = FUNC(intra_pred);
     intra->pred_planar        = FUNC(pred_planar);
     intra->pred_mip           = FUNC(pred_mip);
@@ -1012,4 +1043,5 @@ static void FUNC(ff_vvc_intra_dsp_init)(VVCIntraDSPContext *const intra)
     intra->pred_h             = FUNC(pred_h);
     intra->pred_angular_v     = FUNC(pred_angular_v);
     intra->pred_angular_h     = FUNC(pred_angular_h);
+    intra->ibc_copy           = FUNC(ibc_copy);
 }
@@ -404,6 +404,10 @@ static int add_candidate_ref(VVCContext *s, VVCFrameContext *fc, RefPicList *lis
         ref->pps->r->pps_pic_width_in_luma_samples != fc->ref->pps->r->pps_pic_width_in_luma_samples ||
         ref->pps->r->pps_pic_height_in_luma_samples != fc->ref->pps->r->pps_pic_height_in_luma_samples;
 
+    // the scaled edge emulation buffer only exists when resampling is enabled
+    if (refp->is_scaled && !fc->ps.sps->r->sps_ref_pic_resampling_enabled_flag)
+        return AVERROR_INVALIDDATA;
+
     if (!check_candidate_ref(fc->ref, refp))
         return AVERROR_INVALIDDATA;
 
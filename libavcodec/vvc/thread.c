@@ -22,6 +22,7 @@
 
 #include <stdatomic.h>
 
+#include "libavcodec/refstruct.h"
 #include "libavutil/executor.h"
 #include "libavutil/mem.h"
 #include "libavutil/thread.h"
@@ -444,8 +445,16 @@ static int run_inter(VVCContext *s, VVCLocalContext *lc, VVCTask *t)
     VVCFrameContext *fc = lc->fc;
     const CTU *ctu      = fc->tab.ctus + t->rs;
 
+    if (fc->edge_emu_scaled_pool) {
+        lc->edge_emu_buffer_scaled = ff_refstruct_pool_get(fc->edge_emu_scaled_pool);
+        if (!lc->edge_emu_buffer_scaled)
+            return AVERROR(ENOMEM);
+    }
+
     ff_vvc_predict_inter(lc, t->rs);
 
+    ff_refstruct_unref(&lc->edge_emu_buffer_scaled);
+
     if (ctu->has_dmvr)
         report_frame_progress(fc, t->ry, VVC_PROGRESS_MV);
 
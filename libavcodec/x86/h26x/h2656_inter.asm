@@ -22,21 +22,16 @@
 ; */
 %include "libavutil/x86/x86util.asm"
 
-SECTION_RODATA 32
-cextern pw_255
-cextern pw_512
-cextern pw_2048
-cextern pw_1023
-cextern pw_1024
-cextern pw_4096
-cextern pw_8192
-%define scale_8 pw_512
-%define scale_10 pw_2048
-%define scale_12 pw_8192
-%define max_pixels_8 pw_255
-%define max_pixels_10 pw_1023
-max_pixels_12:          times 16 dw ((1 << 12)-1)
-cextern pb_0
+SECTION_RODATA 64
+; the constants are 64 bytes so they can be used as zmm operands
+scale_8:                times 32 dw 1 << 9
+scale_10:               times 32 dw 1 << 11
+scale_12:               times 32 dw 1 << 13
+min_pixels:             times 32 dw 0
+max_pixels_10:          times 32 dw ((1 << 10)-1)
+max_pixels_12:          times 32 dw ((1 << 12)-1)
+; qword order of the 16-bit results of 8-bit samples unpacked in-lane in zmm
+mc_8bpc_order:          dq 0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15
 
 SECTION .text
 %macro SIMPLE_LOAD 4    ;width, bitd, tab, r1
@@ -63,12 +58,21 @@ SECTION .text
 %endif
 %endmacro
 
+; sign extend the low half of a register
+%macro PMOVSXBW_LOW 1
+%if mmsize == 64
+    pmovsxbw       %1, ymm%1
+%else
+    pmovsxbw       %1, xmm%1
+%endif
+%endmacro
+
 %macro MC_4TAP_FILTER 4 ; bitdepth, filter, a, b,
     VPBROADCASTW   %3, [%2q + 0 * 2]  ; coeff 0, 1
     VPBROADCASTW   %4, [%2q + 1 * 2]  ; coeff 2, 3
 %if %1 != 8
-    pmovsxbw       %3, xmm%3
-    pmovsxbw       %4, xmm%4
+    PMOVSXBW_LOW   %3
+    PMOVSXBW_LOW   %4
 %endif
 %endmacro
 
@@ -78,11 +82,11 @@ SECTION .text
     VPBROADCASTW  m14, [hfq + 0 * 2]  ; hf 0, 1
     VPBROADCASTW  m15, [hfq + 1 * 2]  ; hf 2, 3
 
-    pmovsxbw      m12, xm12
-    pmovsxbw      m13, xm13
+    PMOVSXBW_LOW  m12
+    PMOVSXBW_LOW  m13
 %if %1 != 8
-    pmovsxbw      m14, xm14
-    pmovsxbw      m15, xm15
+    PMOVSXBW_LOW  m14
+    PMOVSXBW_LOW  m15
 %endif
     lea           r3srcq, [srcstrideq*3]
 %endmacro
@@ -104,18 +108,25 @@ SECTION .text
 %endif
 
 %if %1 != 8
-    pmovsxbw                          m12, xm12
-    pmovsxbw                          m13, xm13
-    pmovsxbw                          m14, xm14
-    pmovsxbw                          m15, xm15
+    PMOVSXBW_LOW                      m12
+    PMOVSXBW_LOW                      m13
+    PMOVSXBW_LOW                      m14
+    PMOVSXBW_LOW                      m15
     %if %0 == 3
     MC_8TAP_SAVE_FILTER     %3 + 4*mmsize, m12, m13, m14, m15
     %endif
 %elif %0 == 3
+%if mmsize == 64
+    pmovsxbw                          m8, ym12
+    pmovsxbw                          m9, ym13
+    pmovsxbw                         m10, ym14
+    pmovsxbw                         m11, ym15
+%else
     pmovsxbw                          m8, xm12
     pmovsxbw                          m9, xm13
     pmovsxbw                         m10, xm14
     pmovsxbw                         m11, xm15
+%endif
     MC_8TAP_SAVE_FILTER     %3 + 4*mmsize, m8, m9, m10, m11
 %endif
 
@@ -306,8 +317,19 @@ SECTION .text
 %endif
 %endmacro
 %macro PEL_10STORE32 3
+%if mmsize == 64
+    movu            [%1], %2
+%else
     PEL_10STORE16     %1, %2, %3
     movu         [%1+32], %3
+%endif
+%endmacro
+%macro PEL_10STORE64 3
+    movu            [%1], %2
+    movu         [%1+64], %3
+%endmacro
+%macro PEL_12STORE32 3
+    movu            [%1], %2
 %endmacro
 
 %macro PEL_8STORE2 3
@@ -338,6 +360,20 @@ SECTION .text
 %macro PEL_8STORE32 3
     movu          [%1], %2
 %endmacro
+%macro PEL_8STORE64 3
+    movu          [%1], %2
+%endmacro
+
+; restore the sample order of the 16-bit results of 8-bit samples unpacked in-lane,
+; %1, %2: the results of the low and high unpack, %3, %4: temporaries
+%macro MC_8BPC_ORDER_ZMM 4
+    mova              %3, [mc_8bpc_order]
+    vpermi2q          %3, %1, %2
+    mova              %4, [mc_8bpc_order + 64]
+    vpermi2q          %4, %1, %2
+    SWAP              %1, %3
+    SWAP              %2, %4
+%endmacro
 
 %macro LOOP_END 3
     add              %1q, dststrideq             ; dst += dststride
@@ -349,7 +385,12 @@ SECTION .text
 
 %macro MC_PIXEL_COMPUTE 2-3 ;width, bitdepth
 %if %2 == 8
-%if cpuflag(avx2) && %0 ==3
+%if mmsize == 64 && %0 == 3
+    vextracti64x4 ym1, m0, 1
+    pmovzxbw      m1, ym1
+    psllw         m1, 14-%2
+    pmovzxbw      m0, ym0
+%elif cpuflag(avx2) && %0 ==3
 %if %1 > 16
     vextracti128 xm1, m0, 1
     pmovzxbw      m1, xm1
@@ -380,7 +421,9 @@ SECTION .text
 %define %%reg3 m3
 %endif
 %if %1 == 8
-%if cpuflag(avx2) && (%0 == 5)
+%if mmsize == 64
+    ; the order is restored after the filter
+%elif cpuflag(avx2) && (%0 == 5)
 %if %2 > 16
     vperm2i128    m10, m0, m1, q0301
 %endif
@@ -400,6 +443,23 @@ SECTION .text
     pmaddubsw      %%reg3, %4
     paddw          %%reg1, %%reg3
 %endif
+%if mmsize == 64 && (%0 == 5)
+    MC_8BPC_ORDER_ZMM m0, m1, m8, m9
+%endif
+%elif cpuflag(avx512icl)
+    pmaddwd        %%reg0, %3
+    vpdpwssd       %%reg0, %%reg2, %4
+%if %2 > 4
+    pmaddwd        %%reg1, %3
+    vpdpwssd       %%reg1, %%reg3, %4
+%if %1 != 8
+    psrad          %%reg1, %1-8
+%endif
+%endif
+%if %1 != 8
+    psrad          %%reg0, %1-8
+%endif
+    packssdw       %%reg0, %%reg1
 %else
     pmaddwd        %%reg0, %3
     pmaddwd        %%reg2, %4
@@ -429,6 +489,26 @@ SECTION .text
     paddw             m0, m2
     paddw             m4, m6
     paddw             m0, m4
+%elif cpuflag(avx512icl)
+    pmaddwd           m0, [%3q+4*mmsize]
+    vpdpwssd          m0, m2, [%3q+5*mmsize]
+    pmaddwd           m4, [%3q+6*mmsize]
+    vpdpwssd          m4, m6, [%3q+7*mmsize]
+    paddd             m0, m4
+%if %2 != 8
+    psrad             m0, %2-8
+%endif
+%if %1 > 4
+    pmaddwd           m1, [%3q+4*mmsize]
+    vpdpwssd          m1, m3, [%3q+5*mmsize]
+    pmaddwd           m5, [%3q+6*mmsize]
+    vpdpwssd          m5, m7, [%3q+7*mmsize]
+    paddd             m1, m5
+%if %2 != 8
+    psrad             m1, %2-8
+%endif
+%endif
+    p%4               m0, m1
 %else
     pmaddwd           m0, [%3q+4*mmsize]
     pmaddwd           m2, [%3q+5*mmsize]
@@ -459,7 +539,9 @@ SECTION .text
 
 %macro MC_8TAP_COMPUTE 2-3     ; width, bitdepth
 %if %2 == 8
-%if cpuflag(avx2) && (%0 == 3)
+%if mmsize == 64
+    ; the order is restored after the filter
+%elif cpuflag(avx2) && (%0 == 3)
 
     vperm2i128 m10, m0,  m1, q0301
     vinserti128 m0, m0, xm1, 1
@@ -495,6 +577,28 @@ SECTION .text
     paddw             m5, m7
     paddw             m1, m5
 %endif
+%if mmsize == 64 && (%0 == 3)
+    MC_8BPC_ORDER_ZMM m0, m1, m9, m11
+%endif
+%elif cpuflag(avx512icl)
+    pmaddwd           m0, m12
+    vpdpwssd          m0, m2, m13
+    pmaddwd           m4, m14
+    vpdpwssd          m4, m6, m15
+    paddd             m0, m4
+%if %2 != 8
+    psrad             m0, %2-8
+%endif
+%if %1 > 4
+    pmaddwd           m1, m12
+    vpdpwssd          m1, m3, m13
+    pmaddwd           m5, m14
+    vpdpwssd          m5, m7, m15
+    paddd             m1, m5
+%if %2 != 8
+    psrad             m1, %2-8
+%endif
+%endif
 %else
     pmaddwd           m0, m12
     pmaddwd           m2, m13
@@ -528,9 +632,9 @@ SECTION .text
 %if %2 == 8
     packuswb          %3, %4
 %else
-    CLIPW             %3, [pb_0], [max_pixels_%2]
+    CLIPW             %3, [min_pixels], [max_pixels_%2]
 %if (%1 > 8 && notcpuflag(avx)) || %1 > 16
-    CLIPW             %4, [pb_0], [max_pixels_%2]
+    CLIPW             %4, [min_pixels], [max_pixels_%2]
 %endif
 %endif
 %endmacro
@@ -1140,4 +1244,27 @@ H2656PUT_4TAP_HV 16, 12
 
 %endif
 
+%if HAVE_AVX512ICL_EXTERNAL
+INIT_ZMM avx512icl
+
+H2656PUT_PIXELS  64, 8
+H2656PUT_PIXELS  32, 10
+H2656PUT_PIXELS  32, 12
+
+H2656PUT_8TAP 64,  8
+H2656PUT_8TAP 32, 10
+H2656PUT_8TAP 32, 12
+
+H2656PUT_8TAP_HV 32, 10
+H2656PUT_8TAP_HV 32, 12
+
+H2656PUT_4TAP 64,  8
+H2656PUT_4TAP 32, 10
+H2656PUT_4TAP 32, 12
+
+H2656PUT_4TAP_HV 32, 10
+H2656PUT_4TAP_HV 32, 12
+
+%endif
+
 %endif
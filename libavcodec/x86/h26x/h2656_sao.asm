@@ -1,5 +1,5 @@
 ;******************************************************************************
-;* SIMD optimized SAO functions for HEVC 8bit decoding
+;* SIMD optimized SAO functions for HEVC/VVC 8bit decoding
 ;*
 ;* Copyright (c) 2013 Pierre-Edouard LEPERE
 ;* Copyright (c) 2014 James Almer
@@ -36,7 +36,7 @@ SECTION .text
 ;SAO Band Filter
 ;******************************************************************************
 
-%macro HEVC_SAO_BAND_FILTER_INIT 0
+%macro H2656_SAO_BAND_FILTER_INIT 0
     and            leftq, 31
     movd             xm0, leftd
     add            leftq, 1
@@ -88,7 +88,7 @@ DEFINE_ARGS dst, src, dststride, srcstride, offset, height
     mov          heightd, r7m
 %endmacro
 
-%macro HEVC_SAO_BAND_FILTER_COMPUTE 2
+%macro H2656_SAO_BAND_FILTER_COMPUTE 2
     psraw             %1, %2, 3
 %if ARCH_X86_64
     pcmpeqw          m10, %1, m0
@@ -119,18 +119,18 @@ DEFINE_ARGS dst, src, dststride, srcstride, offset, height
 %endif ; ARCH
 %endmacro
 
-;void ff_hevc_sao_band_filter_<width>_8_<opt>(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
-;                                             int16_t *sao_offset_val, int sao_left_class, int width, int height);
-%macro HEVC_SAO_BAND_FILTER 2
-cglobal hevc_sao_band_filter_%1_8, 6, 6, 15, 7*mmsize*ARCH_X86_32, dst, src, dststride, srcstride, offset, left
-    HEVC_SAO_BAND_FILTER_INIT
+;void ff_h2656_sao_band_filter_<width>_8_<opt>(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+;                                              int16_t *sao_offset_val, int sao_left_class, int width, int height);
+%macro H2656_SAO_BAND_FILTER 2
+cglobal h2656_sao_band_filter_%1_8, 6, 6, 15, 7*mmsize*ARCH_X86_32, dst, src, dststride, srcstride, offset, left
+    H2656_SAO_BAND_FILTER_INIT
 
 align 16
 .loop:
 %if %1 == 8
     movq              m8, [srcq]
     punpcklbw         m8, m14
-    HEVC_SAO_BAND_FILTER_COMPUTE m9, m8
+    H2656_SAO_BAND_FILTER_COMPUTE m9, m8
     packuswb          m8, m14
     movq          [dstq], m8
 %endif ; %1 == 8
@@ -139,28 +139,28 @@ align 16
 %rep %2
     mova             m13, [srcq + i]
     punpcklbw         m8, m13, m14
-    HEVC_SAO_BAND_FILTER_COMPUTE m9,  m8
+    H2656_SAO_BAND_FILTER_COMPUTE m9,  m8
     punpckhbw        m13, m14
-    HEVC_SAO_BAND_FILTER_COMPUTE m9, m13
+    H2656_SAO_BAND_FILTER_COMPUTE m9, m13
     packuswb          m8, m13
     mova      [dstq + i], m8
 %assign i i+mmsize
 %endrep
 
-%if %1 == 48
+%if %1 - %2 * mmsize == 16
 INIT_XMM cpuname
 
     mova             m13, [srcq + i]
     punpcklbw         m8, m13, m14
-    HEVC_SAO_BAND_FILTER_COMPUTE m9,  m8
+    H2656_SAO_BAND_FILTER_COMPUTE m9,  m8
     punpckhbw        m13, m14
-    HEVC_SAO_BAND_FILTER_COMPUTE m9, m13
+    H2656_SAO_BAND_FILTER_COMPUTE m9, m13
     packuswb          m8, m13
     mova      [dstq + i], m8
 %if cpuflag(avx2)
 INIT_YMM cpuname
 %endif
-%endif ; %1 == 48
+%endif ; %1 - %2 * mmsize == 16
 
     add             dstq, dststrideq             ; dst += dststride
     add             srcq, srcstrideq             ; src += srcstride
@@ -170,38 +170,46 @@ INIT_YMM cpuname
 %endmacro
 
 
-%macro HEVC_SAO_BAND_FILTER_FUNCS 0
-HEVC_SAO_BAND_FILTER  8, 0
-HEVC_SAO_BAND_FILTER 16, 1
-HEVC_SAO_BAND_FILTER 32, 2
-HEVC_SAO_BAND_FILTER 48, 2
-HEVC_SAO_BAND_FILTER 64, 4
+%macro H2656_SAO_BAND_FILTER_FUNCS 0
+H2656_SAO_BAND_FILTER  8, 0
+H2656_SAO_BAND_FILTER 16, 1
+H2656_SAO_BAND_FILTER 32, 2
+H2656_SAO_BAND_FILTER 48, 2
+H2656_SAO_BAND_FILTER 64, 4
+H2656_SAO_BAND_FILTER 80, 5
+H2656_SAO_BAND_FILTER 96, 6
+H2656_SAO_BAND_FILTER 112, 7
+H2656_SAO_BAND_FILTER 128, 8
 %endmacro
 
 INIT_XMM sse2
-HEVC_SAO_BAND_FILTER_FUNCS
+H2656_SAO_BAND_FILTER_FUNCS
 INIT_XMM avx
-HEVC_SAO_BAND_FILTER_FUNCS
+H2656_SAO_BAND_FILTER_FUNCS
 
 %if HAVE_AVX2_EXTERNAL
 INIT_XMM avx2
-HEVC_SAO_BAND_FILTER  8, 0
-HEVC_SAO_BAND_FILTER 16, 1
+H2656_SAO_BAND_FILTER  8, 0
+H2656_SAO_BAND_FILTER 16, 1
 INIT_YMM avx2
-HEVC_SAO_BAND_FILTER 32, 1
-HEVC_SAO_BAND_FILTER 48, 1
-HEVC_SAO_BAND_FILTER 64, 2
+H2656_SAO_BAND_FILTER 32, 1
+H2656_SAO_BAND_FILTER 48, 1
+H2656_SAO_BAND_FILTER 64, 2
+H2656_SAO_BAND_FILTER 80, 2
+H2656_SAO_BAND_FILTER 96, 3
+H2656_SAO_BAND_FILTER 112, 3
+H2656_SAO_BAND_FILTER 128, 4
 %endif
 
 ;******************************************************************************
 ;SAO Edge Filter
 ;******************************************************************************
 
-%define MAX_PB_SIZE  64
+; MAX_PB_SIZE is defined per codec before the edge filters are instantiated
 %define PADDING_SIZE 64 ; AV_INPUT_BUFFER_PADDING_SIZE
 %define EDGE_SRCSTRIDE 2 * MAX_PB_SIZE + PADDING_SIZE
 
-%macro HEVC_SAO_EDGE_FILTER_INIT 0
+%macro H2656_SAO_EDGE_FILTER_INIT 0
 %if WIN64
     movsxd           eoq, dword eom
 %elif ARCH_X86_64
@@ -220,7 +228,7 @@ HEVC_SAO_BAND_FILTER 64, 2
     add        b_strideq, tmpq
 %endmacro
 
-%macro HEVC_SAO_EDGE_FILTER_COMPUTE 1
+%macro H2656_SAO_EDGE_FILTER_COMPUTE 1
     pminub            m4, m1, m2
     pminub            m5, m1, m3
     pcmpeqb           m2, m4
@@ -249,22 +257,22 @@ HEVC_SAO_BAND_FILTER 64, 2
 %endif
 %endmacro
 
-;void ff_hevc_sao_edge_filter_<width>_8_<opt>(uint8_t *_dst, uint8_t *_src, ptrdiff_t stride_dst, int16_t *sao_offset_val,
-;                                             int eo, int width, int height);
-%macro HEVC_SAO_EDGE_FILTER 2-3
+;void ff_<codec>_sao_edge_filter_<width>_8_<opt>(uint8_t *_dst, uint8_t *_src, ptrdiff_t stride_dst, int16_t *sao_offset_val,
+;                                                int eo, int width, int height);
+%macro H2656_SAO_EDGE_FILTER 3-4
 %if ARCH_X86_64
-cglobal hevc_sao_edge_filter_%1_8, 4, 9, 8, dst, src, dststride, offset, eo, a_stride, b_stride, height, tmp
+cglobal %1_sao_edge_filter_%2_8, 4, 9, 8, dst, src, dststride, offset, eo, a_stride, b_stride, height, tmp
 %define tmp2q heightq
-    HEVC_SAO_EDGE_FILTER_INIT
+    H2656_SAO_EDGE_FILTER_INIT
     mov          heightd, r6m
 
 %else ; ARCH_X86_32
-cglobal hevc_sao_edge_filter_%1_8, 1, 6, 8, dst, src, dststride, a_stride, b_stride, height
+cglobal %1_sao_edge_filter_%2_8, 1, 6, 8, dst, src, dststride, a_stride, b_stride, height
 %define eoq   srcq
 %define tmpq  heightq
 %define tmp2q dststrideq
 %define offsetq heightq
-    HEVC_SAO_EDGE_FILTER_INIT
+    H2656_SAO_EDGE_FILTER_INIT
     mov             srcq, srcm
     mov          offsetq, r3m
     mov       dststrideq, dststridem
@@ -287,31 +295,31 @@ cglobal hevc_sao_edge_filter_%1_8, 1, 6, 8, dst, src, dststride, a_stride, b_str
 align 16
 .loop:
 
-%if %1 == 8
+%if %2 == 8
     movq              m1, [srcq]
     movq              m2, [srcq + a_strideq]
     movq              m3, [srcq + b_strideq]
-    HEVC_SAO_EDGE_FILTER_COMPUTE %1
+    H2656_SAO_EDGE_FILTER_COMPUTE %2
     movq          [dstq], m3
 %endif
 
 %assign i 0
-%rep %2
+%rep %3
     mova              m1, [srcq + i]
     movu              m2, [srcq + a_strideq + i]
     movu              m3, [srcq + b_strideq + i]
-    HEVC_SAO_EDGE_FILTER_COMPUTE %1
-    mov%3     [dstq + i], m3
+    H2656_SAO_EDGE_FILTER_COMPUTE %2
+    mov%4     [dstq + i], m3
 %assign i i+mmsize
 %endrep
 
-%if %1 == 48
+%if %2 - %3 * mmsize == 16
 INIT_XMM cpuname
 
     mova              m1, [srcq + i]
     movu              m2, [srcq + a_strideq + i]
     movu              m3, [srcq + b_strideq + i]
-    HEVC_SAO_EDGE_FILTER_COMPUTE %1
+    H2656_SAO_EDGE_FILTER_COMPUTE %2
     mova      [dstq + i], m3
 %if cpuflag(avx2)
 INIT_YMM cpuname
@@ -325,16 +333,36 @@ INIT_YMM cpuname
     RET
 %endmacro
 
+%macro H2656_SAO_EDGE_FILTER_FUNCS 1
 INIT_XMM ssse3
-HEVC_SAO_EDGE_FILTER  8, 0
-HEVC_SAO_EDGE_FILTER 16, 1, a
-HEVC_SAO_EDGE_FILTER 32, 2, a
-HEVC_SAO_EDGE_FILTER 48, 2, a
-HEVC_SAO_EDGE_FILTER 64, 4, a
+H2656_SAO_EDGE_FILTER %1,  8, 0
+H2656_SAO_EDGE_FILTER %1, 16, 1, a
+H2656_SAO_EDGE_FILTER %1, 32, 2, a
+H2656_SAO_EDGE_FILTER %1, 48, 2, a
+H2656_SAO_EDGE_FILTER %1, 64, 4, a
+%if MAX_PB_SIZE > 64
+H2656_SAO_EDGE_FILTER %1, 80, 5, a
+H2656_SAO_EDGE_FILTER %1, 96, 6, a
+H2656_SAO_EDGE_FILTER %1, 112, 7, a
+H2656_SAO_EDGE_FILTER %1, 128, 8, a
+%endif
 
 %if HAVE_AVX2_EXTERNAL
 INIT_YMM avx2
-HEVC_SAO_EDGE_FILTER 32, 1, a
-HEVC_SAO_EDGE_FILTER 48, 1, u
-HEVC_SAO_EDGE_FILTER 64, 2, a
+H2656_SAO_EDGE_FILTER %1, 32, 1, a
+H2656_SAO_EDGE_FILTER %1, 48, 1, u
+H2656_SAO_EDGE_FILTER %1, 64, 2, a
+%if MAX_PB_SIZE > 64
+H2656_SAO_EDGE_FILTER %1, 80, 2, u
+H2656_SAO_EDGE_FILTER %1, 96, 3, a
+H2656_SAO_EDGE_FILTER %1, 112, 3, u
+H2656_SAO_EDGE_FILTER %1, 128, 4, a
+%endif
 %endif
+%endmacro
+
+%define MAX_PB_SIZE 64
+H2656_SAO_EDGE_FILTER_FUNCS hevc
+
+%define MAX_PB_SIZE 128
+H2656_SAO_EDGE_FILTER_FUNCS vvc
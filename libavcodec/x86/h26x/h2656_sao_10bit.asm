@@ -1,5 +1,5 @@
 ;******************************************************************************
-;* SIMD optimized SAO functions for HEVC 10/12bit decoding
+;* SIMD optimized SAO functions for HEVC/VVC 10/12bit decoding
 ;*
 ;* Copyright (c) 2013 Pierre-Edouard LEPERE
 ;* Copyright (c) 2014 James Almer
@@ -39,7 +39,7 @@ SECTION .text
 ;SAO Band Filter
 ;******************************************************************************
 
-%macro HEVC_SAO_BAND_FILTER_INIT 1
+%macro H2656_SAO_BAND_FILTER_INIT 1
     and            leftq, 31
     movd             xm0, leftd
     add            leftq, 1
@@ -92,11 +92,11 @@ DEFINE_ARGS dst, src, dststride, srcstride, offset, height
     mov          heightd, r7m
 %endmacro
 
-;void ff_hevc_sao_band_filter_<width>_<depth>_<opt>(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
-;                                                   int16_t *sao_offset_val, int sao_left_class, int width, int height);
-%macro HEVC_SAO_BAND_FILTER 3
-cglobal hevc_sao_band_filter_%2_%1, 6, 6, 15, 7*mmsize*ARCH_X86_32, dst, src, dststride, srcstride, offset, left
-    HEVC_SAO_BAND_FILTER_INIT %1
+;void ff_h2656_sao_band_filter_<width>_<depth>_<opt>(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+;                                                    int16_t *sao_offset_val, int sao_left_class, int width, int height);
+%macro H2656_SAO_BAND_FILTER 3
+cglobal h2656_sao_band_filter_%2_%1, 6, 6, 15, 7*mmsize*ARCH_X86_32, dst, src, dststride, srcstride, offset, left
+    H2656_SAO_BAND_FILTER_INIT %1
 
 align 16
 .loop:
@@ -148,48 +148,64 @@ align 16
     RET
 %endmacro
 
-%macro HEVC_SAO_BAND_FILTER_FUNCS 0
-HEVC_SAO_BAND_FILTER 10,  8, 1
-HEVC_SAO_BAND_FILTER 10, 16, 2
-HEVC_SAO_BAND_FILTER 10, 32, 4
-HEVC_SAO_BAND_FILTER 10, 48, 6
-HEVC_SAO_BAND_FILTER 10, 64, 8
-
-HEVC_SAO_BAND_FILTER 12,  8, 1
-HEVC_SAO_BAND_FILTER 12, 16, 2
-HEVC_SAO_BAND_FILTER 12, 32, 4
-HEVC_SAO_BAND_FILTER 12, 48, 6
-HEVC_SAO_BAND_FILTER 12, 64, 8
+%macro H2656_SAO_BAND_FILTER_FUNCS 0
+H2656_SAO_BAND_FILTER 10,  8, 1
+H2656_SAO_BAND_FILTER 10, 16, 2
+H2656_SAO_BAND_FILTER 10, 32, 4
+H2656_SAO_BAND_FILTER 10, 48, 6
+H2656_SAO_BAND_FILTER 10, 64, 8
+H2656_SAO_BAND_FILTER 10,  80, 10
+H2656_SAO_BAND_FILTER 10,  96, 12
+H2656_SAO_BAND_FILTER 10, 112, 14
+H2656_SAO_BAND_FILTER 10, 128, 16
+
+H2656_SAO_BAND_FILTER 12,  8, 1
+H2656_SAO_BAND_FILTER 12, 16, 2
+H2656_SAO_BAND_FILTER 12, 32, 4
+H2656_SAO_BAND_FILTER 12, 48, 6
+H2656_SAO_BAND_FILTER 12, 64, 8
+H2656_SAO_BAND_FILTER 12,  80, 10
+H2656_SAO_BAND_FILTER 12,  96, 12
+H2656_SAO_BAND_FILTER 12, 112, 14
+H2656_SAO_BAND_FILTER 12, 128, 16
 %endmacro
 
 INIT_XMM sse2
-HEVC_SAO_BAND_FILTER_FUNCS
+H2656_SAO_BAND_FILTER_FUNCS
 INIT_XMM avx
-HEVC_SAO_BAND_FILTER_FUNCS
+H2656_SAO_BAND_FILTER_FUNCS
 
 %if HAVE_AVX2_EXTERNAL
 INIT_XMM avx2
-HEVC_SAO_BAND_FILTER 10,  8, 1
+H2656_SAO_BAND_FILTER 10,  8, 1
 INIT_YMM avx2
-HEVC_SAO_BAND_FILTER 10, 16, 1
-HEVC_SAO_BAND_FILTER 10, 32, 2
-HEVC_SAO_BAND_FILTER 10, 48, 3
-HEVC_SAO_BAND_FILTER 10, 64, 4
+H2656_SAO_BAND_FILTER 10, 16, 1
+H2656_SAO_BAND_FILTER 10, 32, 2
+H2656_SAO_BAND_FILTER 10, 48, 3
+H2656_SAO_BAND_FILTER 10, 64, 4
+H2656_SAO_BAND_FILTER 10,  80, 5
+H2656_SAO_BAND_FILTER 10,  96, 6
+H2656_SAO_BAND_FILTER 10, 112, 7
+H2656_SAO_BAND_FILTER 10, 128, 8
 
 INIT_XMM avx2
-HEVC_SAO_BAND_FILTER 12,  8, 1
+H2656_SAO_BAND_FILTER 12,  8, 1
 INIT_YMM avx2
-HEVC_SAO_BAND_FILTER 12, 16, 1
-HEVC_SAO_BAND_FILTER 12, 32, 2
-HEVC_SAO_BAND_FILTER 12, 48, 3
-HEVC_SAO_BAND_FILTER 12, 64, 4
+H2656_SAO_BAND_FILTER 12, 16, 1
+H2656_SAO_BAND_FILTER 12, 32, 2
+H2656_SAO_BAND_FILTER 12, 48, 3
+H2656_SAO_BAND_FILTER 12, 64, 4
+H2656_SAO_BAND_FILTER 12,  80, 5
+H2656_SAO_BAND_FILTER 12,  96, 6
+H2656_SAO_BAND_FILTER 12, 112, 7
+H2656_SAO_BAND_FILTER 12, 128, 8
 %endif
 
 ;******************************************************************************
 ;SAO Edge Filter
 ;******************************************************************************
 
-%define MAX_PB_SIZE  64
+; MAX_PB_SIZE is defined per codec before the edge filters are instantiated
 %define PADDING_SIZE 64 ; AV_INPUT_BUFFER_PADDING_SIZE
 %define EDGE_SRCSTRIDE 2 * MAX_PB_SIZE + PADDING_SIZE
 
@@ -202,7 +218,7 @@ HEVC_SAO_BAND_FILTER 12, 64, 4
 %endif
 %endmacro
 
-%macro HEVC_SAO_EDGE_FILTER_INIT 0
+%macro H2656_SAO_EDGE_FILTER_INIT 0
 %if WIN64
     movsxd           eoq, dword eom
 %elif ARCH_X86_64
@@ -221,19 +237,19 @@ HEVC_SAO_BAND_FILTER 12, 64, 4
     add        b_strideq, tmpq
 %endmacro
 
-;void ff_hevc_sao_edge_filter_<width>_<depth>_<opt>(uint8_t *_dst, uint8_t *_src, ptrdiff_t stride_dst, int16_t *sao_offset_val,
-;                                                   int eo, int width, int height);
-%macro HEVC_SAO_EDGE_FILTER 3
+;void ff_<codec>_sao_edge_filter_<width>_<depth>_<opt>(uint8_t *_dst, uint8_t *_src, ptrdiff_t stride_dst, int16_t *sao_offset_val,
+;                                                      int eo, int width, int height);
+%macro H2656_SAO_EDGE_FILTER 4
 %if ARCH_X86_64
-cglobal hevc_sao_edge_filter_%2_%1, 4, 9, 16, dst, src, dststride, offset, eo, a_stride, b_stride, height, tmp
+cglobal %1_sao_edge_filter_%3_%2, 4, 9, 16, dst, src, dststride, offset, eo, a_stride, b_stride, height, tmp
 %define tmp2q heightq
-    HEVC_SAO_EDGE_FILTER_INIT
+    H2656_SAO_EDGE_FILTER_INIT
     mov          heightd, r6m
     add        a_strideq, a_strideq
     add        b_strideq, b_strideq
 
 %else ; ARCH_X86_32
-cglobal hevc_sao_edge_filter_%2_%1, 1, 6, 8, 5*mmsize, dst, src, dststride, a_stride, b_stride, height
+cglobal %1_sao_edge_filter_%3_%2, 1, 6, 8, 5*mmsize, dst, src, dststride, a_stride, b_stride, height
 %define eoq   srcq
 %define tmpq  heightq
 %define tmp2q dststrideq
@@ -243,7 +259,7 @@ cglobal hevc_sao_edge_filter_%2_%1, 1, 6, 8, 5*mmsize, dst, src, dststride, a_st
 %define m10 m3
 %define m11 m4
 %define m12 m5
-    HEVC_SAO_EDGE_FILTER_INIT
+    H2656_SAO_EDGE_FILTER_INIT
     mov             srcq, srcm
     mov          offsetq, r3m
     mov       dststrideq, dststridem
@@ -285,7 +301,7 @@ align 16
 .loop:
 
 %assign i 0
-%rep %3
+%rep %4
     mova              m1, [srcq + i]
     movu              m2, [srcq+a_strideq + i]
     movu              m3, [srcq+b_strideq + i]
@@ -326,7 +342,7 @@ align 16
     paddw             m2, m7
     paddw             m2, m1
     paddw             m2, m5
-    CLIPW             m2, m0, [pw_mask %+ %1]
+    CLIPW             m2, m0, [pw_mask %+ %2]
     mova      [dstq + i], m2
 %assign i i+mmsize
 %endrep
@@ -338,33 +354,41 @@ align 16
     RET
 %endmacro
 
+%macro H2656_SAO_EDGE_FILTER_FUNCS 2
 INIT_XMM sse2
-HEVC_SAO_EDGE_FILTER 10,  8, 1
-HEVC_SAO_EDGE_FILTER 10, 16, 2
-HEVC_SAO_EDGE_FILTER 10, 32, 4
-HEVC_SAO_EDGE_FILTER 10, 48, 6
-HEVC_SAO_EDGE_FILTER 10, 64, 8
-
-HEVC_SAO_EDGE_FILTER 12,  8, 1
-HEVC_SAO_EDGE_FILTER 12, 16, 2
-HEVC_SAO_EDGE_FILTER 12, 32, 4
-HEVC_SAO_EDGE_FILTER 12, 48, 6
-HEVC_SAO_EDGE_FILTER 12, 64, 8
+H2656_SAO_EDGE_FILTER %1, %2,  8, 1
+H2656_SAO_EDGE_FILTER %1, %2, 16, 2
+H2656_SAO_EDGE_FILTER %1, %2, 32, 4
+H2656_SAO_EDGE_FILTER %1, %2, 48, 6
+H2656_SAO_EDGE_FILTER %1, %2, 64, 8
+%if MAX_PB_SIZE > 64
+H2656_SAO_EDGE_FILTER %1, %2,  80, 10
+H2656_SAO_EDGE_FILTER %1, %2,  96, 12
+H2656_SAO_EDGE_FILTER %1, %2, 112, 14
+H2656_SAO_EDGE_FILTER %1, %2, 128, 16
+%endif
 
 %if HAVE_AVX2_EXTERNAL
 INIT_XMM avx2
-HEVC_SAO_EDGE_FILTER 10,  8, 1
-INIT_YMM avx2
-HEVC_SAO_EDGE_FILTER 10, 16, 1
-HEVC_SAO_EDGE_FILTER 10, 32, 2
-HEVC_SAO_EDGE_FILTER 10, 48, 3
-HEVC_SAO_EDGE_FILTER 10, 64, 4
-
-INIT_XMM avx2
-HEVC_SAO_EDGE_FILTER 12,  8, 1
+H2656_SAO_EDGE_FILTER %1, %2,  8, 1
 INIT_YMM avx2
-HEVC_SAO_EDGE_FILTER 12, 16, 1
-HEVC_SAO_EDGE_FILTER 12, 32, 2
-HEVC_SAO_EDGE_FILTER 12, 48, 3
-HEVC_SAO_EDGE_FILTER 12, 64, 4
+H2656_SAO_EDGE_FILTER %1, %2, 16, 1
+H2656_SAO_EDGE_FILTER %1, %2, 32, 2
+H2656_SAO_EDGE_FILTER %1, %2, 48, 3
+H2656_SAO_EDGE_FILTER %1, %2, 64, 4
+%if MAX_PB_SIZE > 64
+H2656_SAO_EDGE_FILTER %1, %2,  80, 5
+H2656_SAO_EDGE_FILTER %1, %2,  96, 6
+H2656_SAO_EDGE_FILTER %1, %2, 112, 7
+H2656_SAO_EDGE_FILTER %1, %2, 128, 8
 %endif
+%endif
+%endmacro
+
+%define MAX_PB_SIZE 64
+H2656_SAO_EDGE_FILTER_FUNCS hevc, 10
+H2656_SAO_EDGE_FILTER_FUNCS hevc, 12
+
+%define MAX_PB_SIZE 128
+H2656_SAO_EDGE_FILTER_FUNCS vvc, 10
+H2656_SAO_EDGE_FILTER_FUNCS vvc, 12
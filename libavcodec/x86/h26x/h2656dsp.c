@@ -98,4 +98,25 @@ MC_REP_FUNCS_AVX2(4tap_h)
 MC_REP_FUNCS_AVX2(4tap_v)
 MC_REP_FUNCS_AVX2(4tap_hv)
 #endif
+
+#if HAVE_AVX512ICL_EXTERNAL
+
+#define MC_REP_FUNCS_16BPC_AVX512ICL(fname)        \
+    mc_rep_funcs(fname,10, 32, 64, avx512icl)      \
+    mc_rep_funcs(fname,10, 32,128, avx512icl)      \
+    mc_rep_funcs(fname,12, 32, 64, avx512icl)      \
+    mc_rep_funcs(fname,12, 32,128, avx512icl)      \
+
+#define MC_REP_FUNCS_AVX512ICL(fname)              \
+    mc_rep_funcs(fname, 8, 64,128, avx512icl)      \
+    MC_REP_FUNCS_16BPC_AVX512ICL(fname)            \
+
+MC_REP_FUNCS_AVX512ICL(pixels)
+MC_REP_FUNCS_AVX512ICL(8tap_h)
+MC_REP_FUNCS_AVX512ICL(8tap_v)
+MC_REP_FUNCS_16BPC_AVX512ICL(8tap_hv)
+MC_REP_FUNCS_AVX512ICL(4tap_h)
+MC_REP_FUNCS_AVX512ICL(4tap_v)
+MC_REP_FUNCS_16BPC_AVX512ICL(4tap_hv)
+#endif
 #endif
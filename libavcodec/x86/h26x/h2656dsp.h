@@ -100,4 +100,50 @@ H2656_MC_8TAP_PROTOTYPES_AVX2(4tap_h);
 H2656_MC_8TAP_PROTOTYPES_AVX2(4tap_v);
 H2656_MC_8TAP_PROTOTYPES_AVX2(4tap_hv);
 
+#define H2656_MC_PROTOTYPES_16BPC_AVX512ICL(fname)        \
+    H2656_PEL_PROTOTYPE(fname##32 ,10, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##64 ,10, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##128,10, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##32 ,12, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##64 ,12, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##128,12, avx512icl)         \
+
+#define H2656_MC_PROTOTYPES_AVX512ICL(fname)              \
+    H2656_PEL_PROTOTYPE(fname##64 , 8, avx512icl);        \
+    H2656_PEL_PROTOTYPE(fname##128, 8, avx512icl);        \
+    H2656_MC_PROTOTYPES_16BPC_AVX512ICL(fname)            \
+
+H2656_MC_PROTOTYPES_AVX512ICL(pixels);
+H2656_MC_PROTOTYPES_AVX512ICL(8tap_h);
+H2656_MC_PROTOTYPES_AVX512ICL(8tap_v);
+H2656_MC_PROTOTYPES_16BPC_AVX512ICL(8tap_hv);
+H2656_MC_PROTOTYPES_AVX512ICL(4tap_h);
+H2656_MC_PROTOTYPES_AVX512ICL(4tap_v);
+H2656_MC_PROTOTYPES_16BPC_AVX512ICL(4tap_hv);
+
+#define H2656_SAO_BAND_FILTER_PROTOTYPE(w, bitd, opt) \
+void ff_h2656_sao_band_filter_##w##_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
+    const int16_t *sao_offset_val, int sao_left_class, int width, int height)
+
+#define H2656_SAO_BAND_FILTER_PROTOTYPES(bitd, opt)     \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(8,   bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(16,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(32,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(48,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(64,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(80,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(96,  bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(112, bitd, opt);    \
+    H2656_SAO_BAND_FILTER_PROTOTYPE(128, bitd, opt)
+
+H2656_SAO_BAND_FILTER_PROTOTYPES( 8, sse2);
+H2656_SAO_BAND_FILTER_PROTOTYPES(10, sse2);
+H2656_SAO_BAND_FILTER_PROTOTYPES(12, sse2);
+H2656_SAO_BAND_FILTER_PROTOTYPES( 8,  avx);
+H2656_SAO_BAND_FILTER_PROTOTYPES(10,  avx);
+H2656_SAO_BAND_FILTER_PROTOTYPES(12,  avx);
+H2656_SAO_BAND_FILTER_PROTOTYPES( 8, avx2);
+H2656_SAO_BAND_FILTER_PROTOTYPES(10, avx2);
+H2656_SAO_BAND_FILTER_PROTOTYPES(12, avx2);
+
 #endif
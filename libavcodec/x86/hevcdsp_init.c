@@ -726,34 +726,12 @@ mc_bi_w_funcs(qpel_v, 12, sse4)
 mc_bi_w_funcs(qpel_hv, 12, sse4)
 #endif //ARCH_X86_64 && HAVE_SSE4_EXTERNAL
 
-#define SAO_BAND_FILTER_FUNCS(bitd, opt)                                                                                   \
-void ff_hevc_sao_band_filter_8_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,  \
-                                              const int16_t *sao_offset_val, int sao_left_class, int width, int height);         \
-void ff_hevc_sao_band_filter_16_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
-                                               const int16_t *sao_offset_val, int sao_left_class, int width, int height);        \
-void ff_hevc_sao_band_filter_32_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
-                                               const int16_t *sao_offset_val, int sao_left_class, int width, int height);        \
-void ff_hevc_sao_band_filter_48_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
-                                               const int16_t *sao_offset_val, int sao_left_class, int width, int height);        \
-void ff_hevc_sao_band_filter_64_##bitd##_##opt(uint8_t *_dst, const uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
-                                               const int16_t *sao_offset_val, int sao_left_class, int width, int height);
-
-SAO_BAND_FILTER_FUNCS(8,  sse2)
-SAO_BAND_FILTER_FUNCS(10, sse2)
-SAO_BAND_FILTER_FUNCS(12, sse2)
-SAO_BAND_FILTER_FUNCS(8,   avx)
-SAO_BAND_FILTER_FUNCS(10,  avx)
-SAO_BAND_FILTER_FUNCS(12,  avx)
-SAO_BAND_FILTER_FUNCS(8,  avx2)
-SAO_BAND_FILTER_FUNCS(10, avx2)
-SAO_BAND_FILTER_FUNCS(12, avx2)
-
-#define SAO_BAND_INIT(bitd, opt) do {                                       \
-    c->sao_band_filter[0]      = ff_hevc_sao_band_filter_8_##bitd##_##opt;  \
-    c->sao_band_filter[1]      = ff_hevc_sao_band_filter_16_##bitd##_##opt; \
-    c->sao_band_filter[2]      = ff_hevc_sao_band_filter_32_##bitd##_##opt; \
-    c->sao_band_filter[3]      = ff_hevc_sao_band_filter_48_##bitd##_##opt; \
-    c->sao_band_filter[4]      = ff_hevc_sao_band_filter_64_##bitd##_##opt; \
+#define SAO_BAND_INIT(bitd, opt) do {                                        \
+    c->sao_band_filter[0]      = ff_h2656_sao_band_filter_8_##bitd##_##opt;  \
+    c->sao_band_filter[1]      = ff_h2656_sao_band_filter_16_##bitd##_##opt; \
+    c->sao_band_filter[2]      = ff_h2656_sao_band_filter_32_##bitd##_##opt; \
+    c->sao_band_filter[3]      = ff_h2656_sao_band_filter_48_##bitd##_##opt; \
+    c->sao_band_filter[4]      = ff_h2656_sao_band_filter_64_##bitd##_##opt; \
 } while (0)
 
 #define SAO_EDGE_FILTER_FUNCS(bitd, opt)                                                                      \
@@ -875,8 +853,8 @@ void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth)
             c->add_residual[3] = ff_hevc_add_residual_32_8_avx;
         }
         if (EXTERNAL_AVX2(cpu_flags)) {
-            c->sao_band_filter[0] = ff_hevc_sao_band_filter_8_8_avx2;
-            c->sao_band_filter[1] = ff_hevc_sao_band_filter_16_8_avx2;
+            c->sao_band_filter[0] = ff_h2656_sao_band_filter_8_8_avx2;
+            c->sao_band_filter[1] = ff_h2656_sao_band_filter_16_8_avx2;
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
             c->idct_dc[2] = ff_hevc_idct_16x16_dc_8_avx2;
@@ -1043,7 +1021,7 @@ void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth)
             SAO_BAND_INIT(10, avx);
         }
         if (EXTERNAL_AVX2(cpu_flags)) {
-            c->sao_band_filter[0] = ff_hevc_sao_band_filter_8_10_avx2;
+            c->sao_band_filter[0] = ff_h2656_sao_band_filter_8_10_avx2;
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
             c->idct_dc[2] = ff_hevc_idct_16x16_dc_10_avx2;
@@ -1241,7 +1219,7 @@ void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth)
             SAO_BAND_INIT(12, avx);
         }
         if (EXTERNAL_AVX2(cpu_flags)) {
-            c->sao_band_filter[0] = ff_hevc_sao_band_filter_8_12_avx2;
+            c->sao_band_filter[0] = ff_h2656_sao_band_filter_8_12_avx2;
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
             c->idct_dc[2] = ff_hevc_idct_16x16_dc_12_avx2;
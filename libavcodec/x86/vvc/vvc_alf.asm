@@ -23,13 +23,13 @@
 
 %include "libavutil/x86/x86util.asm"
 
-SECTION_RODATA
+SECTION_RODATA 64
 
 %macro PARAM_SHUFFE 1
 %assign i (%1  * 2)
 %assign j ((i + 1) << 8) + (i)
 param_shuffe_ %+ %1:
-%rep 2
+%rep 4
     times 4 dw j
     times 4 dw (j + 0x0808)
 %endrep
@@ -62,9 +62,39 @@ SECTION .text
 ;%4 clip or filter
 %macro LOAD_LUMA_PARAMS_W16 4
     lea                 offsetq, [3 * xq]                       ;xq * ALF_NUM_COEFF_LUMA / ALF_BLOCK_SIZE
+%if mmsize == 64
+    ; the next 16 pixels in the high half, they are shuffled the same way
+    movu                   ym%1, [%4q + 2 * offsetq + 0 * 32]
+    movu                   ym%2, [%4q + 2 * offsetq + 1 * 32]
+    movu                   ym%3, [%4q + 2 * offsetq + 2 * 32]
+    vinserti64x4            m%1, m%1, [%4q + 2 * offsetq + 3 * 32], 1
+    vinserti64x4            m%2, m%2, [%4q + 2 * offsetq + 4 * 32], 1
+    vinserti64x4            m%3, m%3, [%4q + 2 * offsetq + 5 * 32], 1
+%else
     movu                    m%1, [%4q + 2 * offsetq + 0 * 32]   ; 2 * for sizeof(int16_t)
     movu                    m%2, [%4q + 2 * offsetq + 1 * 32]
     movu                    m%3, [%4q + 2 * offsetq + 2 * 32]
+%endif
+%endmacro
+
+; shufpd with the 256-bit immediate repeated for both halves of a zmm
+%macro SHUFPD_W16 4
+%if mmsize == 64
+    shufpd                  %1, %2, %3, (%4) | ((%4) << 4)
+%else
+    shufpd                  %1, %2, %3, %4
+%endif
+%endmacro
+
+; load the params of 2 blocks, already in the order the ymm shuffles below produce
+%macro LOAD_LUMA_PARAMS_W8 4
+    lea                 offsetq, [3 * xq]
+    movq                    m%1, [%4q + 2 * offsetq + 0 * 8]
+    movhps                  m%1, [%4q + 2 * offsetq + 3 * 8]
+    movq                    m%2, [%4q + 2 * offsetq + 1 * 8]
+    movhps                  m%2, [%4q + 2 * offsetq + 4 * 8]
+    movq                    m%3, [%4q + 2 * offsetq + 2 * 8]
+    movhps                  m%3, [%4q + 2 * offsetq + 5 * 8]
 %endmacro
 
 %macro LOAD_LUMA_PARAMS_W16 6
@@ -73,15 +103,15 @@ SECTION .text
     ;m%2 = 07 06 05 04
     ;m%3 = 11 10 09 08
 
-    shufpd                  m%5, m%1, m%2, 0011b        ;06 02 05 01
-    shufpd                  m%6, m%3, m%5, 1001b        ;06 10 01 09
+    SHUFPD_W16              m%5, m%1, m%2, 0011b        ;06 02 05 01
+    SHUFPD_W16              m%6, m%3, m%5, 1001b        ;06 10 01 09
 
-    shufpd                  m%1, m%1, m%6, 1100b        ;06 03 09 00
-    shufpd                  m%2, m%2, m%6, 0110b        ;10 07 01 04
-    shufpd                  m%3, m%3, m%5, 0110b        ;02 11 05 08
+    SHUFPD_W16              m%1, m%1, m%6, 1100b        ;06 03 09 00
+    SHUFPD_W16              m%2, m%2, m%6, 0110b        ;10 07 01 04
+    SHUFPD_W16              m%3, m%3, m%5, 0110b        ;02 11 05 08
 
     vpermpd                 m%1, m%1, 01111000b         ;09 06 03 00
-    shufpd                  m%2, m%2, m%2, 1001b        ;10 07 04 01
+    SHUFPD_W16              m%2, m%2, m%2, 1001b        ;10 07 04 01
     vpermpd                 m%3, m%3, 10000111b         ;11 08 05 02
 %endmacro
 
@@ -89,15 +119,24 @@ SECTION .text
 ; %4    clip or filter
 ; %5-%6 tmp
 %macro LOAD_LUMA_PARAMS 6
+%if mmsize == 16
+    LOAD_LUMA_PARAMS_W8  %1, %2, %3, %4
+%else
     LOAD_LUMA_PARAMS_W16 %1, %2, %3, %4, %5, %6
+%endif
 %endmacro
 
 %macro LOAD_CHROMA_PARAMS 4
     ; LOAD_CHROMA_PARAMS_W %+ WIDTH %1, %2, %3, %4
     movq                   xm%1, [%3q]
     movd                   xm%2, [%3q + 8]
+%if mmsize == 16
+    punpcklqdq              m%1, m%1
+    punpcklqdq              m%2, m%2
+%else
     vpbroadcastq            m%1, xm%1
     vpbroadcastq            m%2, xm%2
+%endif
 %endmacro
 
 %macro LOAD_PARAMS 0
@@ -272,7 +311,7 @@ SECTION .text
     psrad             m1, SHIFT
     jmp      %%shift_end
 %%near_vb:
-    vpbroadcastd      m9, [dd448]
+    VPBROADCASTD      m9, [dd448]
     paddd             m0, m9
     paddd             m1, m9
     psrad             m0, SHIFT + 3
@@ -287,8 +326,8 @@ SECTION .text
 ; output: m0, m1
 ; temp:   s0q...s1q
 %macro FILTER_VB 1
-    vpbroadcastd      m0, [dw64]
-    vpbroadcastd      m1, [dw64]
+    VPBROADCASTD      m0, [dw64]
+    VPBROADCASTD      m1, [dw64]
 
     GET_SRCS %1
 %if LUMA
@@ -328,6 +367,11 @@ SECTION .text
 %macro STORE_PIXELS 2
     %if ps == 2
         movu         %1, m%2
+    %elif mmsize == 64
+        vpmovwb      %1, m%2
+    %elif mmsize == 16
+        packuswb    m%2, m%2
+        movq         %1, m%2
     %else
         packuswb    m%2, m%2
         vpermq      m%2, m%2, 0x8
@@ -402,7 +446,7 @@ cglobal vvc_alf_filter_%2_%1bpc, 11, 15, 16, 0-0x28, dst, dst_stride, src, src_s
     offset, x, s5, s6
 %define ps (%1 / 8) ; pixel size
     movd            xm15, pixel_maxd
-    vpbroadcastw     m15, xm15
+    SPLATW           m15, xm15
     pxor             m14, m14
 
 .loop:
@@ -414,9 +458,9 @@ cglobal vvc_alf_filter_%2_%1bpc, 11, 15, 16, 0-0x28, dst, dst_stride, src, src_s
         LOAD_PARAMS
         FILTER_16x4
 
-        add         srcq, 16 * ps
-        add         dstq, 16 * ps
-        add           xd, 16
+        add         srcq, mmsize / 2 * ps
+        add         dstq, mmsize / 2 * ps
+        add           xd, mmsize / 2
         cmp           xd, widthd
         jl       .loop_w
 
@@ -461,6 +505,11 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 
     add               widthd, ALF_GRADIENT_BORDER * 2
     add              heightd, ALF_GRADIENT_BORDER * 2
+%if mmsize == 16
+    ; keep the row stride of the ymm version, classify expects it
+    add               widthd, 15
+    and               widthd, ~15
+%endif
 
     xor                   yd, yd
 
@@ -500,8 +549,7 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
         pblendw           m0, m1, m6, 0x55
         paddw             m0, m0                       ; c
 
-        movu              m1, [CLASSIFY_SHUFFE]
-        pshufb            m1, m0, m1                   ; d
+        pshufb            m1, m0, [CLASSIFY_SHUFFE]    ; d
 
         paddw             m9, m14                      ; n + s
         psubw             m9, m0                       ; (n + s) - c
@@ -524,17 +572,23 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
         phaddw            m8,  m10                     ; di,  each word represent 2x2 pixels
         phaddw            m0,  m9, m8                  ; all = each word represent 4x2 pixels, order is v_h_d0_d1 x 4
 
+%if mmsize == 32
         vinserti128      m15, m15, xm0, 1
+%endif
         pblendw           m1,  m0, m15, 0xaa           ; t
 
         phaddw            m1,  m0                      ; each word represent 8x2 pixels, adjacent word share 4x2 pixels
 
+%if mmsize == 32
         vextracti128    xm15, m0, 1                    ; prev
+%else
+        mova             m15, m0                       ; prev
+%endif
 
         movu [gradient_sumq], m1
 
-        add    gradient_sumq, 32
-        add               xd, 16
+        add    gradient_sumq, mmsize
+        add               xd, mmsize / 2
         cmp               xd, widthd
         jl           .loop_w
 
@@ -548,9 +602,14 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 ; SAVE_CLASSIFY_PARAM_W16(dest, src)
 %macro SAVE_CLASSIFY_PARAM_W16 2
     lea                   tempq, [%1q + xq]
+%if mmsize == 16
+    movq                [tempq], m%2
+    movhps     [tempq + widthq], m%2
+%else
     movu                [tempq], xm%2
     vperm2i128              m%2, m%2, m%2, 1
     movu       [tempq + widthq], xm%2
+%endif
 %endmacro
 
 ; SAVE_CLASSIFY_PARAM_W8
@@ -570,6 +629,12 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 ; SAVE_CLASSIFY_PARAM_W(dest, src)
 %macro SAVE_CLASSIFY_PARAM_W 2
     lea                  tempq, [%1q + xq]
+%if mmsize == 16
+    ; only 4 columns are left for xmm
+    movd               [tempq], m%2
+    psrldq                 m%2, 8
+    movd      [tempq + widthq], m%2
+%else
     cmp                     wd, 8
     jl %%w4
     SAVE_CLASSIFY_PARAM_W8 tempq, %2
@@ -580,6 +645,7 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 %%w4:
     SAVE_CLASSIFY_PARAM_W4 tempq, %2
 %%end:
+%endif
 %endmacro
 
 %macro ALF_CLASSIFY_H8 0
@@ -591,16 +657,17 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 
     pcmpeqb          m11, m11
     movd            xm13, yd
-    vpbroadcastd     m13, xm13
+    VPBROADCASTD     m13, xm13
     movd            xm12, vb_posd
-    vpbroadcastd     m12, xm12
+    VPBROADCASTD     m12, xm12
     pcmpeqd          m13, m12       ; y == vb_pos
     pandn            m13, m11       ; y != vb_pos
 
-    vpbroadcastd     m14, [dw3]
-    pblendvb         m14, m14, [dd2], m13    ; ac
+    VPBROADCASTD     m14, [dw3]
+    paddd            m14, m13       ; ac, 2 for y != vb_pos
 
-    pblendvb          m3, m15, [gradq + sum_stride3q], m13
+    movu              m3, [gradq + sum_stride3q]
+    pand              m3, m13
 
     ; extent to dword to avoid overflow
     punpcklwd         m4, m0, m15
@@ -623,7 +690,8 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
 
     lea            gradq, [gradq + 2 * sum_strideq]
 
-    pblendvb         m10, m15, [gradq], m13
+    movu             m10, [gradq]
+    pand             m10, m13
 
     movu             m11, [gradq + sum_strideq]
     movu             m12, [gradq + 2 * sum_strideq]
@@ -670,11 +738,13 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
     pminsd            m9, m2, m3         ; d0
 
     ; *transpose_idx = dir_d * 2 + dir_hv;
-    vpbroadcastd     m10, [dw3]
+    VPBROADCASTD     m10, [dw3]
     paddd            m11, m7, m7
     paddd            m11, m4
     paddd            m10, m11
+%if mmsize == 32
     vpermq           m10, m10, 11011000b
+%endif
     SAVE_CLASSIFY_PARAM transpose_idx, 10
 
     psrlq            m10, m8, 32
@@ -683,35 +753,55 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
     psrlq             m1,  m9, 32
     psrlq             m2,  m5, 32
     pmuldq            m3,  m1, m2        ; d0 * hv1 high
+%if cpuflag(avx2)
     pcmpgtq          m10, m12, m3        ; dir1 - 1 high
+%else
+    ; no pcmpgtq before sse4.2, the products are positive so the sign of the difference is enough
+    psubq             m3, m12
+    psrad            m10, m3, 31         ; dir1 - 1 high, in the odd dwords
+%endif
 
     pmuldq            m1, m8, m6         ; d1 * hv0 low
     pmuldq            m2, m9, m5         ; d0 * hv1 low
+%if cpuflag(avx2)
     pcmpgtq           m1, m2             ; dir1 - 1 low
 
     vpblendd          m1, m1, m10, 0xaa  ; dir1 - 1
 
     pblendvb          m2, m5, m8, m1     ; hvd1
     pblendvb          m3, m6, m9, m1     ; hvd0
+%else
+    psubq             m2, m1
+    psrad             m2, 31
+    pshufd            m1, m2, q3311      ; dir1 - 1 low
+    pblendw           m1, m10, 0xcc      ; dir1 - 1
+
+    ; pblendvb would need the mask in m0
+    pand              m4, m8, m1
+    pandn             m2, m1, m5
+    por               m2, m4             ; hvd1
+    pand             m12, m9, m1
+    pandn             m3, m1, m6
+    por               m3, m12            ; hvd0
+%endif
 
     movd             xm5, bit_depthd
-    vpbroadcastd      m5, xm5
 
     ;*class_idx = arg_var[av_clip_uintp2(sum_hv * ac >> (BIT_DEPTH - 1), 4)];
     pmulld            m0, m14            ; sum_hv * ac
-    vpsrlvd           m0, m0, m5
+    psrld             m0, xm5
     pminsd            m0, [dd15]
     movu              m6, [ARG_VAR_SHUFFE]
     pshufb            m6, m0             ; class_idx
 
-    vpbroadcastd     m10, [dw5]
+    VPBROADCASTD     m10, [dw5]
 
     ; if (hvd1 * 2 > 9 * hvd0)
     ;   *class_idx += ((dir1 << 1) + 2) * 5;
     ; else if (hvd1 > 2 * hvd0)
     ;   *class_idx += ((dir1 << 1) + 1) * 5;
-    paddd             m7,  m3, m3
-    pcmpgtd           m7,  m2, m7        ; hvd1 > 2 * hvd0
+    paddd            m11,  m3, m3
+    pcmpgtd           m7,  m2, m11       ; hvd1 > 2 * hvd0
     pand              m7, m10
     paddd             m6,  m7            ; class_idx
 
@@ -725,7 +815,9 @@ cglobal vvc_alf_classify_grad_%1bpc, 6, 14, 16, gradient_sum, src, src_stride, w
     pandn             m1, m7
     paddd             m1, m1             ; dir1 << 1
     paddd             m6, m1             ; class_idx
+%if mmsize == 32
     vpermq            m6, m6, 11011000b
+%endif
 
     SAVE_CLASSIFY_PARAM class_idx, 6
 %endmacro
@@ -773,12 +865,12 @@ cglobal vvc_alf_classify_%1bpc, 7, 15, 16, class_idx, transpose_idx, gradient_su
     .loop_sum_w16:
         lea           wd, [widthd]
         sub           wd, xd
-        cmp           wd, 16
+        cmp           wd, mmsize / 2
         jl .loop_sum_w16_end
 
         ALF_CLASSIFY_16x8
 
-        add           xd, 16
+        add           xd, mmsize / 2
         jmp .loop_sum_w16
     .loop_sum_w16_end:
 
@@ -799,12 +891,214 @@ cglobal vvc_alf_classify_%1bpc, 7, 15, 16, class_idx, transpose_idx, gradient_su
     RET
 %endmacro
 
+; CC_ALF_LOAD(register prefix, dst, hs, src, offset in samples)
+; load the luma samples used by 8 (ymm) or 4 (xmm) chroma samples as dwords, for hs the
+; high word of each dword holds the odd column, which pmaddwd ignores
+%macro CC_ALF_LOAD 5
+%if %3
+    %if ps == 2
+        movu            %{1}%2, [%4q + colq * 2 + %5 * ps]
+    %else
+        vpmovzxbw       %{1}%2, [%4q + colq * 2 + %5 * ps]
+    %endif
+%else
+    %if ps == 2
+        vpmovzxwd       %{1}%2, [%4q + colq + %5 * ps]
+    %else
+        vpmovzxbd       %{1}%2, [%4q + colq + %5 * ps]
+    %endif
+%endif
+%endmacro
+
+; CC_ALF_TAP(register prefix, src, filter) sum += filter * (src - curr)
+%macro CC_ALF_TAP 3
+    psubd               %{1}%2, %{1}0
+    pmaddwd             %{1}%2, %{1}%3
+    paddd               %{1}2, %{1}%2
+%endmacro
+
+; CC_ALF_FILTER(register prefix, hs)
+%macro CC_ALF_FILTER 2
+    CC_ALF_LOAD          %1, 0, %2, s1, 0
+%if %2
+    psrld               %{1}1, %{1}0, 16
+%else
+    CC_ALF_LOAD          %1, 1, %2, s1, 1
+%endif
+    psubd               %{1}1, %{1}0
+    pmaddwd             %{1}2, %{1}1, %{1}10
+    CC_ALF_LOAD          %1, 1, %2, s1, -1
+    CC_ALF_TAP           %1, 1, 9
+    CC_ALF_LOAD          %1, 1, %2, s0, 0
+    CC_ALF_TAP           %1, 1, 8
+    CC_ALF_LOAD          %1, 1, %2, s2, 0
+%if %2
+    psrld               %{1}3, %{1}1, 16
+%else
+    CC_ALF_LOAD          %1, 3, %2, s2, 1
+%endif
+    CC_ALF_TAP           %1, 1, 12
+    CC_ALF_TAP           %1, 3, 13
+    CC_ALF_LOAD          %1, 1, %2, s2, -1
+    CC_ALF_TAP           %1, 1, 11
+    CC_ALF_LOAD          %1, 1, %2, s3, 0
+    CC_ALF_TAP           %1, 1, 14
+
+    paddd               %{1}2, %{1}4
+    psrad               %{1}2, 7
+    pminsd              %{1}2, %{1}5
+    pmaxsd              %{1}2, %{1}6
+%if ps == 2
+    vpmovzxwd           %{1}1, [dstq + colq]
+%else
+    vpmovzxbd           %{1}1, [dstq + colq]
+%endif
+    paddd               %{1}2, %{1}1
+    packusdw            %{1}2, %{1}2
+%ifidn %1, m
+    vpermq               m2, m2, q2020
+%endif
+%if ps == 2
+    pminuw              xm2, xm7
+    %ifidn %1, xm
+        movq        [dstq + colq], xm2
+    %else
+        movu        [dstq + colq], xm2
+    %endif
+%else
+    packuswb            xm2, xm2
+    %ifidn %1, xm
+        movd        [dstq + colq], xm2
+    %else
+        movq        [dstq + colq], xm2
+    %endif
+%endif
+%endmacro
+
+; CC_ALF_ROWS(hs)
+%macro CC_ALF_ROWS 1
+.loop_y%1:
+    mov                 s0q, s1q
+    sub                 s0q, luma_strideq
+    lea                 s2q, [s1q + luma_strideq]
+    lea                 s3q, [s1q + luma_strideq * 2]
+
+    ; vb_pos holds vb_pos - (y << vs) here
+    lea                tmpd, [vb_posq + 1]
+    cmp                tmpd, 1
+    ja .vb_rows%1
+    cmp                 vsd, 1                      ; no vertical subsampling, rows vb_pos and vb_pos + 1 are not filtered
+    je .next_row%1
+.vb_rows%1:
+    cmp              vb_posd, 2
+    je .s3_s2%1
+    cmp              vb_posd, -1
+    je .s3_s2%1
+    cmp              vb_posd, 1
+    je .s0_s3_s1%1
+    test             vb_posd, vb_posd
+    jnz .filter%1
+.s0_s3_s1%1:
+    mov                 s0q, s1q
+    mov                 s2q, s1q
+.s3_s2%1:
+    mov                 s3q, s2q
+
+.filter%1:
+    xor                colq, colq
+.loop_x%1:
+    lea                tmpq, [colq + 8 * ps]
+    cmp                tmpq, widthq
+    jg .w4%1
+    CC_ALF_FILTER        m, %1
+    add                colq, 8 * ps
+    jmp .loop_x%1
+.w4%1:
+    cmp                colq, widthq
+    jge .next_row%1
+    CC_ALF_FILTER       xm, %1
+
+.next_row%1:
+    add                dstq, dst_strideq
+    add                 s1q, stepq
+    sub              vb_posd, vsd
+    dec             heightd
+    jg .loop_y%1
+    RET
+%endmacro
+
+; ******************************
+; void ff_vvc_alf_filter_cc_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride,
+;      const uint8_t *luma, ptrdiff_t luma_stride, intptr_t width, intptr_t height, intptr_t hs, intptr_t vs,
+;      const int16_t *filter, intptr_t vb_pos, ptrdiff_t pixel_max);
+; ******************************
+%macro ALF_FILTER_CC 1
+cglobal vvc_alf_filter_cc_%1bpc, 11, 15, 16, dst, dst_stride, s1, luma_stride, width, height, hs, vs, filter, vb_pos, pixel_max, \
+    s0, s2, s3, col
+%define ps (%1 / 8) ; pixel size
+    ; the taps as (filter, 0) word pairs, so pmaddwd only sees the low word of each difference
+    pcmpeqd             m15, m15
+    psrld               m15, 16
+    vpbroadcastw         m8, [filterq + 0 * 2]
+    vpbroadcastw         m9, [filterq + 1 * 2]
+    vpbroadcastw        m10, [filterq + 2 * 2]
+    vpbroadcastw        m11, [filterq + 3 * 2]
+    vpbroadcastw        m12, [filterq + 4 * 2]
+    vpbroadcastw        m13, [filterq + 5 * 2]
+    vpbroadcastw        m14, [filterq + 6 * 2]
+    pand                 m8, m15
+    pand                 m9, m15
+    pand                m10, m15
+    pand                m11, m15
+    pand                m12, m15
+    pand                m13, m15
+    pand                m14, m15
+
+    pcmpeqd              m4, m4
+    psrld                m4, 31
+    pslld                m4, 6                      ; 64
+    movd                xm7, pixel_maxd
+    vpbroadcastd         m5, xm7
+    psrld                m5, 1                      ; (1 << (bit_depth - 1)) - 1
+    pcmpeqd              m6, m6
+    pxor                 m6, m5                     ; -(1 << (bit_depth - 1))
+    vpbroadcastw         m7, xm7
+
+    DEFINE_ARGS dst, dst_stride, s1, luma_stride, width, height, hs, vs, step, vb_pos, tmp, s0, s2, s3, col
+    shlx              stepq, luma_strideq, vsq
+    mov                tmpd, 1
+    shlx                vsd, tmpd, vsd
+%if ps == 2
+    add              widthq, widthq
+%endif
+    test                hsd, hsd
+    jnz .loop_y1
+    CC_ALF_ROWS 0
+    CC_ALF_ROWS 1
+%endmacro
+
 %if ARCH_X86_64
+%if HAVE_SSE4_EXTERNAL
+INIT_XMM sse4
+ALF_FILTER   16
+ALF_FILTER   8
+ALF_CLASSIFY 16
+ALF_CLASSIFY 8
+%endif
+
 %if HAVE_AVX2_EXTERNAL
 INIT_YMM avx2
 ALF_FILTER   16
 ALF_FILTER   8
 ALF_CLASSIFY 16
 ALF_CLASSIFY 8
+ALF_FILTER_CC 16
+ALF_FILTER_CC 8
+%endif
+
+%if HAVE_AVX512ICL_EXTERNAL
+INIT_ZMM avx512icl
+ALF_FILTER   16
+ALF_FILTER   8
 %endif
 %endif
@@ -0,0 +1,951 @@
+;******************************************************************************
+;* VVC deblocking filter SIMD optimizations
+;*
+;* This file is part of FFmpeg.
+;*
+;* FFmpeg is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* FFmpeg is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with FFmpeg; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA 32
+
+; spreads words 0-3 of an xmm to 4 lanes each, over both halves of a ymm
+pd_seg_splat:    dd 0, 0, 1, 1, 2, 2, 3, 3
+; +1 for the p half, -1 for the q half
+pw_p1_qm1:       times 8 dw 1
+                 times 8 dw -1
+
+pw_1:            times 16 dw 1
+pw_2:            times 16 dw 2
+pw_3:            times 16 dw 3
+pw_4:            times 16 dw 4
+pw_5:            times 16 dw 5
+pw_6:            times 16 dw 6
+pw_7:            times 16 dw 7
+pw_8:            times 16 dw 8
+pw_10:           times 16 dw 10
+pw_12:           times 16 dw 12
+pw_14:           times 16 dw 14
+pw_pixel_max_8:  times 16 dw (1 << 8) - 1
+pw_pixel_max_10: times 16 dw (1 << 10) - 1
+pw_pixel_max_12: times 16 dw (1 << 12) - 1
+
+; long filter weight of the sample next to the edge and the decrement per sample,
+; for filter lengths 7, 5 and 3, << 9 for pmulhrsw
+pw_long_w7:      times 16 dw 59 << 9
+pw_long_w5:      times 16 dw 58 << 9
+pw_long_w3:      times 16 dw 53 << 9
+pw_long_s7:      times 16 dw  9 << 9
+pw_long_s5:      times 16 dw 13 << 9
+pw_long_s3:      times 16 dw 21 << 9
+
+pd_2:            times 4 dd 2
+pb_3:            times 16 db 3
+
+; chroma shuffles, 128 bytes for each value of shift
+chroma_shuf:
+    ; shift 0: segments of 4 lines
+    ; the words of segment 0-1 to its lines
+    times 2 db 0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3
+    ; the bytes of segment 0-1 to words of its lines
+    times 2 db 0, -1, 0, -1, 0, -1, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1
+    ; the first and the last line of each segment
+    times 2 db 0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9
+    times 2 db 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15
+    ; shift 1: segments of 2 lines
+    times 2 db 0, 1, 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7
+    times 2 db 0, -1, 0, -1, 1, -1, 1, -1, 2, -1, 2, -1, 3, -1, 3, -1
+    times 2 db 0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13
+    times 2 db 2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15
+
+SECTION .text
+
+%if ARCH_X86_64
+%if HAVE_AVX2_EXTERNAL
+
+; The luma filters keep sample p(i) of all 8 lines in the low half of m(i) and q(i) in the
+; high half, so both sides of the edge are filtered by the same instructions. Line 0-3 are
+; the first 4-sample segment of the edge and line 4-7 the second one.
+
+%define TC_S         [rsp +  0 * mmsize]
+%define BETA_S       [rsp +  1 * mmsize]
+%define LEN_S        [rsp +  2 * mmsize]
+%define AP_S         [rsp +  3 * mmsize]
+%define CN_S         [rsp +  4 * mmsize]
+%define STRONGC_S    [rsp +  5 * mmsize]
+%define TC25C_S      [rsp +  6 * mmsize]
+%define ND_S         [rsp +  7 * mmsize]
+%define ANYL_S       [rsp +  8 * mmsize]
+%define LENE_S       [rsp +  9 * mmsize]
+%define NDM_S        [rsp + 10 * mmsize]
+%define MLARGE_S     [rsp + 11 * mmsize]
+%define MSTRONG_S    [rsp + 12 * mmsize]
+%define MWEAK_S      [rsp + 13 * mmsize]
+%define C8_S         [rsp + 14 * mmsize]
+%define C55_S        [rsp + 15 * mmsize]
+%define C12_S        [rsp + 16 * mmsize]
+%define REF_S        [rsp + 17 * mmsize]
+%define WSTEP_S      [rsp + 18 * mmsize]
+%define KSTEP_S      [rsp + 19 * mmsize]
+%define OUT_S(i)     [rsp + (20 + i) * mmsize]
+%assign LUMA_STACK   27 * 32
+%assign CHROMA_STACK  4 * 32
+
+; exchange the p and q halves
+%macro SWAPH 2
+    vpermq                   %1, %2, q1032
+%endmacro
+
+; broadcast line 0 or 3 of each segment to the whole segment
+%macro LINE0 2
+    pshuflw                  %1, %2, q0000
+    pshufhw                  %1, %1, q0000
+%endmacro
+
+%macro LINE3 2
+    pshuflw                  %1, %2, q3333
+    pshufhw                  %1, %1, q3333
+%endmacro
+
+; words 0-3 of xm%1 to [w0 x4, w1 x4 | w2 x4, w3 x4], m15 holds pd_seg_splat
+%macro SEG_SPLAT 1
+    punpcklwd             xm%1, xm%1
+    vpermd                 m%1, m15, m%1
+%endmacro
+
+; %1 = clip(%1, %2 - %3, %2 + %3)
+%macro CLAMP_TC 4 ; dst, r, t, tmp
+    psubw                    %4, %2, %3
+    pmaxsw                   %1, %4
+    paddw                    %4, %2, %3
+    pminsw                   %1, %4
+%endmacro
+
+; OUT(%1) = %3 ? %2 : OUT(%1)
+%macro BLEND_OUT 4 ; i, src, mask, tmp
+    mova                     %4, OUT_S(%1)
+    pblendvb                 %4, %4, %2, %3
+    mova             OUT_S(%1), %4
+%endmacro
+
+; load the two per-segment bytes of %2 and %3 as words 0-1 and 2-3 of xm%1
+%macro LOAD_SEG_BYTES 3 ; dst, p array, q array
+    movzx                 tmpd, word [%2]
+    movd                  xm%1, tmpd
+    movzx                 tmpd, word [%3]
+    movd                    xm9, tmpd
+    punpcklwd             xm%1, xm9
+    pmovzxbw              xm%1, xm%1
+%endmacro
+
+; the per-segment parameters, spread over the lanes
+%macro LUMA_PARAMS 1 ; bitdepth
+    mova                    m15, [pd_seg_splat]
+
+    vpbroadcastq            xm8, [tcq]
+%if %1 < 10
+    paddd                   xm8, [pd_2]
+    psrad                   xm8, 10 - %1
+%elif %1 > 10
+    pslld                   xm8, %1 - 10
+%endif
+    packssdw                xm8, xm8
+    SEG_SPLAT                8
+    mova                  TC_S, m8
+
+    vpbroadcastq            xm8, [betaq]
+%if %1 > 8
+    pslld                   xm8, %1 - 8
+%endif
+    packssdw                xm8, xm8
+    SEG_SPLAT                8
+    mova                BETA_S, m8
+
+    ; the long filter is not used for p at a CTU edge, capping max_len_p at 3 has the same effect
+    movzx                 tmpd, word [max_len_pq]
+    movd                    xm8, tmpd
+    test        hor_ctu_edged, hor_ctu_edged
+    jz .no_ctu_edge
+    pminub                  xm8, [pb_3]
+.no_ctu_edge:
+    movzx                 tmpd, word [max_len_qq]
+    movd                    xm9, tmpd
+    punpcklwd               xm8, xm9
+    pmovzxbw                xm8, xm8
+    SEG_SPLAT                8
+    mova                 LEN_S, m8
+
+    LOAD_SEG_BYTES           8, no_pq, no_qq
+    pxor                    xm9, xm9
+    pcmpeqw                 xm8, xm9
+    SEG_SPLAT                8
+    mova                  AP_S, m8
+%endmacro
+
+; in: p(i)/q(i) in m0-m7, out: the filtered samples in m0-m6
+%macro LUMA_DEBLOCK_BODY 1 ; bitdepth
+%assign %%i 0
+%rep 7
+    mova          OUT_S(%%i), m %+ %%i
+%assign %%i %%i + 1
+%endrep
+
+    ; dp, dq of every line
+    paddw                    m8, m0, m2
+    psubw                    m8, m1
+    psubw                    m8, m1
+    pabsw                    m8, m8
+    SWAPH                    m9, m8
+    paddw                    m9, m8
+
+    ; d0 + d3 < beta
+    mova                    m12, BETA_S
+    LINE0                   m10, m9
+    LINE3                   m11, m9
+    paddw                   m13, m10, m11
+    pcmpgtw                 m13, m12, m13
+    mova                  CN_S, m13
+
+    ; strong filter decision
+    psraw                   m14, m12, 2
+    paddw                   m10, m10
+    paddw                   m11, m11
+    pcmpgtw                 m10, m14, m10
+    pcmpgtw                 m11, m14, m11
+    pand                    m10, m11
+    psubw                   m11, m3, m0
+    pabsw                   m11, m11
+    SWAPH                   m14, m11
+    paddw                   m11, m14
+    psraw                   m14, m12, 3
+    LINE0                   m13, m11
+    pcmpgtw                 m13, m14, m13
+    pand                    m10, m13
+    LINE3                   m13, m11
+    pcmpgtw                 m13, m14, m13
+    pand                    m10, m13
+
+    ; |p0 - q0| < tc25, shared with the long filter decision
+    mova                    m14, TC_S
+    pmullw                  m14, [pw_5]
+    paddw                   m14, [pw_1]
+    psraw                   m14, 1
+    SWAPH                   m11, m0
+    psubw                   m11, m0
+    pabsw                   m11, m11
+    LINE0                   m13, m11
+    pcmpgtw                 m13, m14, m13
+    LINE3                   m11, m11
+    pcmpgtw                 m11, m14, m11
+    pand                    m13, m11
+    mova               TC25C_S, m13
+    pand                    m10, m13
+    mova             STRONGC_S, m10
+
+    ; dp0 + dp3 < (beta + (beta >> 1)) >> 3 for the weak filter of p1/q1
+    psraw                   m14, m12, 1
+    paddw                   m14, m12
+    psraw                   m14, 3
+    LINE0                   m10, m8
+    LINE3                   m11, m8
+    paddw                   m10, m11
+    pcmpgtw                 m10, m14, m10
+    mova                  ND_S, m10
+
+    ; long filter decision
+    mova                    m12, LEN_S
+    pcmpgtw                 m13, m12, [pw_3]
+    SWAPH                   m14, m13
+    por                     m14, m13
+    mova                ANYL_S, m14
+    paddw                   m10, m3, m5
+    psubw                   m10, m4
+    psubw                   m10, m4
+    pabsw                   m10, m10
+    pavgw                   m10, m8
+    pblendvb                m10, m8, m10, m13
+    SWAPH                   m11, m10
+    paddw                   m10, m11
+    LINE0                   m11, m10
+    LINE3                   m10, m10
+    mova                    m15, BETA_S
+    paddw                    m9, m10, m11
+    pcmpgtw                  m9, m15, m9
+    psraw                    m8, m15, 4
+    paddw                   m11, m11
+    paddw                   m10, m10
+    pcmpgtw                 m11, m8, m11
+    pcmpgtw                 m10, m8, m10
+    pand                     m9, m11
+    pand                     m9, m10
+    pand                     m9, TC25C_S
+    pand                     m9, m14
+
+    pmaxsw                  m12, [pw_3]
+    mova                LENE_S, m12
+    pcmpeqw                 m14, m12, [pw_7]
+    psubw                   m10, m7, m6
+    psubw                   m10, m5
+    paddw                   m10, m4
+    pabsw                   m10, m10
+    pand                    m10, m14
+    psubw                   m11, m3, m0
+    pabsw                   m11, m11
+    paddw                   m10, m11
+    pblendvb                m11, m5, m7, m14
+    psubw                   m11, m3
+    pabsw                   m11, m11
+    pavgw                   m11, m10
+    pblendvb                m10, m10, m11, m13
+    SWAPH                   m11, m10
+    paddw                   m10, m11
+    pmullw                   m8, m15, [pw_3]
+    psraw                    m8, 5
+    LINE0                   m11, m10
+    pcmpgtw                 m11, m8, m11
+    pand                     m9, m11
+    LINE3                   m11, m10
+    pcmpgtw                 m11, m8, m11
+    pand                     m9, m11
+
+    ; filter selection
+    mova                    m15, TC_S
+    pxor                     m8, m8
+    pcmpgtw                 m15, m8
+    pand                     m9, m15
+    pandn                   m10, m9, CN_S
+    pand                    m10, m15
+    mova                    m12, LEN_S
+    mova                    m14, ANYL_S
+    pcmpgtw                 m11, m12, [pw_2]
+    por                     m11, m14
+    SWAPH                    m8, m11
+    pand                    m11, m8
+    pcmpgtw                 m12, [pw_1]
+    por                     m12, m14
+    SWAPH                    m8, m12
+    pand                    m12, m8
+    pand                    m11, STRONGC_S
+    pand                    m11, m10
+    pandn                   m10, m11, m10
+    pand                    m12, ND_S
+    mova                 NDM_S, m12
+    mova                    m13, AP_S
+    pand                     m9, m13
+    pand                    m11, m13
+    pand                    m10, m13
+    mova              MLARGE_S, m9
+    mova             MSTRONG_S, m11
+    mova               MWEAK_S, m10
+
+    ; weak filter
+    mova                    m15, TC_S
+    SWAPH                    m8, m0
+    psubw                    m8, m0
+    SWAPH                    m9, m1
+    psubw                    m9, m1
+    paddw                   m10, m8, m8
+    paddw                    m8, m10
+    psubw                    m8, m9
+    ; (3 * x + 8) >> 4 without overflowing 16 bits
+    paddw                    m9, m8, [pw_8]
+    psraw                    m9, 1
+    paddw                    m8, m9
+    psraw                    m8, 3
+    vpermq                   m8, m8, q1010
+    psignw                   m8, [pw_p1_qm1]
+    pmullw                   m9, m15, [pw_10]
+    pabsw                   m10, m8
+    pcmpgtw                  m9, m10
+    pand                     m9, MWEAK_S
+    pxor                    m10, m10
+    psubw                   m10, m15
+    pminsw                   m8, m15
+    pmaxsw                   m8, m10
+    pxor                    m13, m13
+    mova                    m14, [pw_pixel_max_%1]
+    paddw                   m11, m0, m8
+    CLIPW                   m11, m13, m14
+    BLEND_OUT                0, m11, m9, m12
+    pavgw                   m11, m2, m0
+    psubw                   m11, m1
+    paddw                   m11, m8
+    psraw                   m11, 1
+    psraw                   m12, m15, 1
+    psubw                   m10, m13, m12
+    pminsw                  m11, m12
+    pmaxsw                  m11, m10
+    paddw                   m11, m1
+    CLIPW                   m11, m13, m14
+    pand                     m9, NDM_S
+    BLEND_OUT                1, m11, m9, m12
+
+    ; strong filter
+    mova                    m14, MSTRONG_S
+    SWAPH                    m8, m0
+    SWAPH                    m9, m1
+    paddw                   m10, m1, m0
+    paddw                   m10, m8
+    paddw                   m10, m10
+    paddw                   m10, m2
+    paddw                   m10, m9
+    paddw                   m10, [pw_4]
+    psrlw                   m10, 3
+    pmullw                  m11, m15, [pw_3]
+    CLAMP_TC               m10, m0, m11, m12
+    BLEND_OUT                0, m10, m14, m12
+    paddw                   m10, m2, m1
+    paddw                   m10, m0
+    paddw                   m10, m8
+    paddw                   m10, [pw_2]
+    psrlw                   m10, 2
+    paddw                   m11, m15, m15
+    CLAMP_TC               m10, m1, m11, m12
+    BLEND_OUT                1, m10, m14, m12
+    paddw                   m10, m3, m2
+    paddw                   m10, m10
+    paddw                   m10, m2
+    paddw                   m10, m1
+    paddw                   m10, m0
+    paddw                   m10, m8
+    paddw                   m10, [pw_4]
+    psrlw                   m10, 3
+    CLAMP_TC               m10, m2, m15, m12
+    BLEND_OUT                2, m10, m14, m12
+
+    ; long filter, m is the sum of a p and a q window selected by max_len_p and max_len_q
+    SWAPH                    m8, m0
+    paddw                    m8, m0
+    SWAPH                    m9, m1
+    paddw                    m9, m1
+    SWAPH                   m10, m2
+    paddw                   m10, m2
+    SWAPH                   m11, m3
+    paddw                   m11, m3
+    paddw                   m12, m8, m9
+    paddw                   m13, m12, m10
+    paddw                   m14, m13, m11
+    paddw                   m14, m14
+    mova                  C8_S, m14
+    SWAPH                   m15, m4
+    paddw                   m15, m4
+    paddw                   m13, m13
+    paddw                   m13, m11
+    paddw                   m13, m15
+    mova                 C55_S, m13
+    SWAPH                   m13, m5
+    paddw                   m13, m5
+    paddw                   m12, m12
+    paddw                   m12, m10
+    paddw                   m12, m11
+    paddw                   m12, m15
+    paddw                   m12, m13
+    mova                 C12_S, m12
+    paddw                   m14, m8, m9
+    paddw                   m14, m10
+    paddw                   m14, m11
+    paddw                   m14, m8
+    paddw                   m14, m15
+    paddw                   m14, m13
+    SWAPH                   m12, m6
+    paddw                   m12, m6
+    paddw                   m14, m12
+    ; the 3/7 windows are the 7/7 one plus p2 + 2 * p1 + p0 - p3 - p4 - p5 - p6 of the short side
+    paddw                    m8, m1, m1
+    paddw                    m8, m2
+    paddw                    m8, m0
+    psubw                    m8, m6
+    psubw                    m8, m5
+    psubw                    m8, m4
+    psubw                    m8, m3
+    vpermq                   m9, m8, q1010
+    paddw                    m9, m14
+    vpermq                   m8, m8, q3232
+    paddw                    m8, m14
+    mova                    m10, LENE_S
+    vpermq                  m11, m10, q1010
+    vpermq                  m12, m10, q3232
+    pcmpeqw                 m13, m12, [pw_7]
+    pblendvb                 m8, m8, m9, m13
+    paddw                   m13, m11, m12
+    pcmpeqw                  m9, m13, [pw_8]
+    pblendvb                 m8, m8, C8_S, m9
+    pcmpeqw                  m9, m13, [pw_12]
+    pblendvb                 m8, m8, C12_S, m9
+    pcmpeqw                  m9, m13, [pw_14]
+    pblendvb                 m8, m8, m14, m9
+    pcmpeqw                  m9, m13, [pw_10]
+    pcmpeqw                 m15, m11, [pw_5]
+    pand                     m9, m15
+    pblendvb                 m8, m8, C55_S, m9
+    paddw                    m8, [pw_8]
+    psrlw                    m8, 4
+
+    ; ref = (p(max_len) + p(max_len - 1) + 1) >> 1
+    pavgw                    m9, m3, m2
+    pavgw                   m11, m5, m4
+    pavgw                   m12, m7, m6
+    pcmpeqw                 m13, m10, [pw_5]
+    pblendvb                m12, m12, m11, m13
+    pcmpeqw                 m14, m10, [pw_3]
+    pblendvb                m12, m12, m9, m14
+    mova                 REF_S, m12
+    psubw                    m8, m12
+
+    ; p(i) = ref + (((m - ref) * w(i) + 32) >> 6), clipped to p(i) +- (tc * k(i)) >> 1
+    mova                     m9, [pw_long_w7]
+    pblendvb                 m9, m9, [pw_long_w5], m13
+    pblendvb                 m9, m9, [pw_long_w3], m14
+    mova                    m11, [pw_long_s7]
+    pblendvb                m11, m11, [pw_long_s5], m13
+    pblendvb                m11, m11, [pw_long_s3], m14
+    mova               WSTEP_S, m11
+    mova                    m11, [pw_1]
+    pblendvb                m11, m11, [pw_2], m14
+    mova               KSTEP_S, m11
+    mova                    m14, [pw_6]
+    mova                    m15, MLARGE_S
+%assign %%i 0
+%rep 7
+    pmulhrsw                m11, m8, m9
+    paddw                   m11, REF_S
+    pmaxsw                  m12, m14, [pw_1]
+    pmullw                  m12, TC_S
+    psrlw                   m12, 1
+    pxor                    m13, m13
+    pcmpgtw                 m13, m10, m13
+    pand                    m12, m13
+    CLAMP_TC               m11, m %+ %%i, m12, m13
+    BLEND_OUT             %%i, m11, m15, m13
+%if %%i < 6
+    psubw                    m9, WSTEP_S
+    psubw                   m14, KSTEP_S
+    psubw                   m10, [pw_1]
+%endif
+%assign %%i %%i + 1
+%endrep
+
+%assign %%i 0
+%rep 7
+    mova             m %+ %%i, OUT_S(%%i)
+%assign %%i %%i + 1
+%endrep
+%endmacro
+
+; horizontal edges: p(i) is row -i - 1, q(i) row i
+%macro LOAD_PQ 4 ; bitdepth, i, p, q
+%if %1 == 8
+    pmovzxbw             xm%2, %3
+    pmovzxbw               xm8, %4
+    vinserti128           m%2, m%2, xm8, 1
+%else
+    movu                 xm%2, %3
+    vinserti128           m%2, m%2, %4, 1
+%endif
+%endmacro
+
+%macro STORE_PQ 4 ; bitdepth, i, p, q
+%if %1 == 8
+    packuswb              m%2, m%2
+    movq                    %3, xm%2
+    vextracti128           xm8, m%2, 1
+    movq                    %4, xm8
+%else
+    movu                    %3, xm%2
+    vextracti128            %4, m%2, 1
+%endif
+%endmacro
+
+; vertical edges: a row of 16 samples is p7..p0 | q0..q7, transposing 8 of them gives
+; p(7 - i) | q(i) in m(i), exchange the low halves of m(i) and m(7 - i) to get p(i) | q(i)
+%macro EXCHANGE_P 0
+%assign %%i 0
+%rep 4
+%assign %%j 7 - %%i
+    vpblendd                 m8, m %+ %%i, m %+ %%j, 0x0f
+    vpblendd         m %+ %%j, m %+ %%j, m %+ %%i, 0x0f
+    mova             m %+ %%i, m8
+%assign %%i %%i + 1
+%endrep
+%endmacro
+
+%macro LOOP_FILTER_LUMA 1 ; bitdepth
+
+; void ff_vvc_h_loop_filter_luma_%1_avx2(uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+;     const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q, int hor_ctu_edge)
+cglobal vvc_h_loop_filter_luma_%1, 9, 13, 16, LUMA_STACK, pix, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, \
+    hor_ctu_edge, pix0, pix1, stride3, tmp
+    LUMA_PARAMS              %1
+    lea               stride3q, [3 * strideq]
+    lea                  pix0q, [pixq + 4 * strideq]
+    lea                  pix1q, [8 * strideq]
+    neg                  pix1q
+    add                  pix1q, pixq
+    lea                   tmpq, [pix1q + 4 * strideq]
+    LOAD_PQ              %1, 0, [tmpq + stride3q],      [pixq]
+    LOAD_PQ              %1, 1, [tmpq + 2 * strideq],   [pixq + strideq]
+    LOAD_PQ              %1, 2, [tmpq + strideq],       [pixq + 2 * strideq]
+    LOAD_PQ              %1, 3, [tmpq],                 [pixq + stride3q]
+    LOAD_PQ              %1, 4, [pix1q + stride3q],     [pix0q]
+    LOAD_PQ              %1, 5, [pix1q + 2 * strideq],  [pix0q + strideq]
+    LOAD_PQ              %1, 6, [pix1q + strideq],      [pix0q + 2 * strideq]
+    LOAD_PQ              %1, 7, [pix1q],                [pix0q + stride3q]
+
+    LUMA_DEBLOCK_BODY        %1
+
+    STORE_PQ             %1, 0, [tmpq + stride3q],      [pixq]
+    STORE_PQ             %1, 1, [tmpq + 2 * strideq],   [pixq + strideq]
+    STORE_PQ             %1, 2, [tmpq + strideq],       [pixq + 2 * strideq]
+    STORE_PQ             %1, 3, [tmpq],                 [pixq + stride3q]
+    STORE_PQ             %1, 4, [pix1q + stride3q],     [pix0q]
+    STORE_PQ             %1, 5, [pix1q + 2 * strideq],  [pix0q + strideq]
+    STORE_PQ             %1, 6, [pix1q + strideq],      [pix0q + 2 * strideq]
+    RET
+
+; void ff_vvc_v_loop_filter_luma_%1_avx2(uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+;     const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q, int hor_ctu_edge)
+cglobal vvc_v_loop_filter_luma_%1, 9, 13, 16, LUMA_STACK, pix, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, \
+    hor_ctu_edge, pix0, pix1, stride3, tmp
+    LUMA_PARAMS              %1
+    lea               stride3q, [3 * strideq]
+    sub                   pixq, 8 * ((%1 + 7) / 8)
+    lea                  pix0q, [pixq + 4 * strideq]
+%if %1 == 8
+    pmovzxbw                 m0, [pixq]
+    pmovzxbw                 m1, [pixq + strideq]
+    pmovzxbw                 m2, [pixq + 2 * strideq]
+    pmovzxbw                 m3, [pixq + stride3q]
+    pmovzxbw                 m4, [pix0q]
+    pmovzxbw                 m5, [pix0q + strideq]
+    pmovzxbw                 m6, [pix0q + 2 * strideq]
+    pmovzxbw                 m7, [pix0q + stride3q]
+%else
+    movu                     m0, [pixq]
+    movu                     m1, [pixq + strideq]
+    movu                     m2, [pixq + 2 * strideq]
+    movu                     m3, [pixq + stride3q]
+    movu                     m4, [pix0q]
+    movu                     m5, [pix0q + strideq]
+    movu                     m6, [pix0q + 2 * strideq]
+    movu                     m7, [pix0q + stride3q]
+%endif
+    TRANSPOSE8x8W            0, 1, 2, 3, 4, 5, 6, 7, 8
+    EXCHANGE_P
+
+    LUMA_DEBLOCK_BODY        %1
+
+    EXCHANGE_P
+    TRANSPOSE8x8W            0, 1, 2, 3, 4, 5, 6, 7, 8
+%if %1 == 8
+%assign %%i 0
+%rep 8
+    packuswb         m %+ %%i, m %+ %%i
+    vpermq           m %+ %%i, m %+ %%i, q3120
+%assign %%i %%i + 1
+%endrep
+    movu                 [pixq], xm0
+    movu       [pixq + strideq], xm1
+    movu   [pixq + 2 * strideq], xm2
+    movu      [pixq + stride3q], xm3
+    movu                [pix0q], xm4
+    movu      [pix0q + strideq], xm5
+    movu  [pix0q + 2 * strideq], xm6
+    movu     [pix0q + stride3q], xm7
+%else
+    movu                 [pixq], m0
+    movu       [pixq + strideq], m1
+    movu   [pixq + 2 * strideq], m2
+    movu      [pixq + stride3q], m3
+    movu                [pix0q], m4
+    movu      [pix0q + strideq], m5
+    movu  [pix0q + 2 * strideq], m6
+    movu     [pix0q + stride3q], m7
+%endif
+    RET
+%endmacro
+
+; The chroma filters use the same layout for p3-q3 of 8 lines, split into 2 segments of 4
+; lines, or 4 segments of 2 lines when shift is set. Per-segment values are spread over
+; the lines with the shuffles in chroma_shuf, which tabq points to.
+
+%macro CHROMA_PARAMS 1 ; bitdepth
+    shl                 shiftd, 7
+    lea                   tabq, [chroma_shuf]
+    add                   tabq, shiftq
+
+    movu                    xm8, [tcq]
+%if %1 < 10
+    paddd                   xm8, [pd_2]
+    psrad                   xm8, 10 - %1
+%elif %1 > 10
+    pslld                   xm8, %1 - 10
+%endif
+    packssdw                xm8, xm8
+    vpbroadcastq             m8, xm8
+    pshufb                   m8, [tabq]
+    mova                  TC_S, m8
+
+    movu                    xm8, [betaq]
+%if %1 > 8
+    pslld                   xm8, %1 - 8
+%endif
+    packssdw                xm8, xm8
+    vpbroadcastq             m8, xm8
+    pshufb                   m8, [tabq]
+    mova                BETA_S, m8
+
+    vpbroadcastd             m8, [max_len_pq]
+    vpbroadcastd             m9, [max_len_qq]
+    vpblendd                 m8, m8, m9, 0xf0
+    pshufb                   m8, [tabq + 32]
+    mova                 LEN_S, m8
+
+    vpbroadcastd             m8, [no_pq]
+    vpbroadcastd             m9, [no_qq]
+    vpblendd                 m8, m8, m9, 0xf0
+    pshufb                   m8, [tabq + 32]
+    pxor                     m9, m9
+    pcmpeqw                  m8, m9
+    mova                  AP_S, m8
+%endmacro
+
+; in: p(i)/q(i) in m0-m3, out: the filtered samples in m0-m3
+%macro CHROMA_DEBLOCK_BODY 1 ; bitdepth
+    mova                     m4, m0
+    mova                     m5, m1
+    mova                     m6, m2
+    mova                     m7, m3
+
+    ; with max_len_p == 1, p1 stands in for p2 and p3 in the decisions and the filters
+    mova                    m12, LEN_S
+    pcmpeqw                 m13, m12, [pw_1]
+    pblendvb                 m2, m2, m1, m13
+    pblendvb                 m3, m3, m1, m13
+
+    ; d0 + d1 < beta
+    paddw                    m8, m2, m0
+    psubw                    m8, m1
+    psubw                    m8, m1
+    pabsw                    m8, m8
+    SWAPH                    m9, m8
+    paddw                    m8, m9
+    mova                    m12, BETA_S
+    pshufb                   m9, m8, [tabq + 64]
+    pshufb                  m10, m8, [tabq + 96]
+    paddw                    m9, m10
+    pcmpgtw                  m9, m12, m9
+
+    ; the strong filter decision of every line
+    paddw                    m8, m8
+    psraw                   m10, m12, 2
+    pcmpgtw                  m8, m10, m8
+    psubw                   m10, m3, m0
+    pabsw                   m10, m10
+    SWAPH                   m11, m10
+    paddw                   m10, m11
+    psraw                   m11, m12, 3
+    pcmpgtw                 m11, m10
+    pand                     m8, m11
+    mova                    m15, TC_S
+    pmullw                  m10, m15, [pw_5]
+    paddw                   m10, [pw_1]
+    psraw                   m10, 1
+    SWAPH                   m11, m0
+    psubw                   m11, m0
+    pabsw                   m11, m11
+    pcmpgtw                 m10, m11
+    pand                     m8, m10
+    pshufb                  m10, m8, [tabq + 64]
+    pand                     m9, m10
+    pshufb                  m10, m8, [tabq + 96]
+    pand                     m9, m10
+
+    ; filter selection
+    pxor                    m14, m14
+    pcmpgtw                 m13, m15, m14
+    mova                    m12, LEN_S
+    pcmpeqw                 m10, m12, m14
+    SWAPH                   m11, m10
+    por                     m10, m11
+    pandn                   m13, m10, m13
+    pcmpeqw                 m10, m12, [pw_3]
+    vpermq                  m11, m10, q3232
+    pand                     m9, m11
+    pand                     m9, m13
+    pandn                   m13, m9, m13
+    mova                    m11, AP_S
+    pand                     m9, m11
+    pand                    m13, m11
+    pand                    m10, m9
+
+    ; strong filter, one-sided when max_len_p == 1 as p2 and p3 are p1 then
+    SWAPH                    m8, m1
+    SWAPH                   m11, m0
+    paddw                   m11, m0
+    paddw                   m11, m8
+    paddw                   m11, m1
+    paddw                   m11, m2
+    paddw                   m11, m3
+    paddw                   m11, [pw_4]
+    SWAPH                   m12, m2
+    paddw                   m12, m0
+    paddw                   m12, m11
+    psrlw                   m12, 3
+    CLAMP_TC               m12, m0, m15, m14
+    pblendvb                 m4, m4, m12, m9
+    paddw                   m12, m3, m1
+    paddw                   m12, m11
+    psrlw                   m12, 3
+    CLAMP_TC               m12, m1, m15, m14
+    pblendvb                 m5, m5, m12, m10
+    psubw                   m12, m11, m8
+    paddw                   m12, m3
+    paddw                   m12, m3
+    paddw                   m12, m2
+    psrlw                   m12, 3
+    CLAMP_TC               m12, m6, m15, m14
+    pblendvb                 m6, m6, m12, m10
+
+    ; weak filter
+    SWAPH                    m8, m0
+    psubw                    m8, m0
+    psllw                    m8, 2
+    SWAPH                   m11, m1
+    psubw                   m11, m1, m11
+    paddw                    m8, m11
+    paddw                    m8, [pw_4]
+    psraw                    m8, 3
+    vpermq                   m8, m8, q1010
+    psignw                   m8, [pw_p1_qm1]
+    pxor                    m14, m14
+    psubw                   m12, m14, m15
+    pmaxsw                   m8, m12
+    pminsw                   m8, m15
+    paddw                    m8, m0
+    CLIPW                    m8, m14, [pw_pixel_max_%1]
+    pblendvb                 m4, m4, m8, m13
+
+    mova                     m0, m4
+    mova                     m1, m5
+    mova                     m2, m6
+    mova                     m3, m7
+%endmacro
+
+%macro LOOP_FILTER_CHROMA 1 ; bitdepth
+
+; void ff_vvc_h_loop_filter_chroma_%1_avx2(uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+;     const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q, int shift)
+cglobal vvc_h_loop_filter_chroma_%1, 9, 12, 16, CHROMA_STACK, pix, stride, beta, tc, no_p, no_q, max_len_p, \
+    max_len_q, shift, pix0, stride3, tab
+    CHROMA_PARAMS            %1
+    lea               stride3q, [3 * strideq]
+    mov                  pix0q, pixq
+    sub                  pix0q, stride3q
+    sub                  pix0q, strideq
+    LOAD_PQ              %1, 0, [pix0q + stride3q],     [pixq]
+    LOAD_PQ              %1, 1, [pix0q + 2 * strideq],  [pixq + strideq]
+    LOAD_PQ              %1, 2, [pix0q + strideq],      [pixq + 2 * strideq]
+    LOAD_PQ              %1, 3, [pix0q],                [pixq + stride3q]
+
+    CHROMA_DEBLOCK_BODY      %1
+
+    STORE_PQ             %1, 0, [pix0q + stride3q],     [pixq]
+    STORE_PQ             %1, 1, [pix0q + 2 * strideq],  [pixq + strideq]
+    STORE_PQ             %1, 2, [pix0q + strideq],      [pixq + 2 * strideq]
+    RET
+
+; void ff_vvc_v_loop_filter_chroma_%1_avx2(uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+;     const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q, int shift)
+cglobal vvc_v_loop_filter_chroma_%1, 9, 12, 16, CHROMA_STACK, pix, stride, beta, tc, no_p, no_q, max_len_p, \
+    max_len_q, shift, pix0, stride3, tab
+    CHROMA_PARAMS            %1
+    lea               stride3q, [3 * strideq]
+    sub                   pixq, 4 * ((%1 + 7) / 8)
+    lea                  pix0q, [pixq + 4 * strideq]
+%if %1 == 8
+    pmovzxbw                xm0, [pixq]
+    pmovzxbw                xm1, [pixq + strideq]
+    pmovzxbw                xm2, [pixq + 2 * strideq]
+    pmovzxbw                xm3, [pixq + stride3q]
+    pmovzxbw                xm4, [pix0q]
+    pmovzxbw                xm5, [pix0q + strideq]
+    pmovzxbw                xm6, [pix0q + 2 * strideq]
+    pmovzxbw                xm7, [pix0q + stride3q]
+%else
+    movu                    xm0, [pixq]
+    movu                    xm1, [pixq + strideq]
+    movu                    xm2, [pixq + 2 * strideq]
+    movu                    xm3, [pixq + stride3q]
+    movu                    xm4, [pix0q]
+    movu                    xm5, [pix0q + strideq]
+    movu                    xm6, [pix0q + 2 * strideq]
+    movu                    xm7, [pix0q + stride3q]
+%endif
+    ; a row of 8 samples is p3..p0 | q0..q3, after transposing m(i) is sample i of all lines
+    TRANSPOSE8x8W            0, 1, 2, 3, 4, 5, 6, 7, 8
+    vinserti128              m0, m0, xm7, 1
+    vinserti128              m1, m1, xm6, 1
+    vinserti128              m2, m2, xm5, 1
+    vinserti128              m3, m3, xm4, 1
+    SWAP                      0, 3
+    SWAP                      1, 2
+
+    CHROMA_DEBLOCK_BODY      %1
+
+    SWAP                      0, 3
+    SWAP                      1, 2
+    vextracti128            xm4, m3, 1
+    vextracti128            xm5, m2, 1
+    vextracti128            xm6, m1, 1
+    vextracti128            xm7, m0, 1
+    TRANSPOSE8x8W            0, 1, 2, 3, 4, 5, 6, 7, 8
+%if %1 == 8
+%assign %%i 0
+%rep 8
+    packuswb         m %+ %%i, m %+ %%i
+%assign %%i %%i + 1
+%endrep
+    movq                 [pixq], xm0
+    movq       [pixq + strideq], xm1
+    movq   [pixq + 2 * strideq], xm2
+    movq      [pixq + stride3q], xm3
+    movq                [pix0q], xm4
+    movq      [pix0q + strideq], xm5
+    movq  [pix0q + 2 * strideq], xm6
+    movq     [pix0q + stride3q], xm7
+%else
+    movu                 [pixq], xm0
+    movu       [pixq + strideq], xm1
+    movu   [pixq + 2 * strideq], xm2
+    movu      [pixq + stride3q], xm3
+    movu                [pix0q], xm4
+    movu      [pix0q + strideq], xm5
+    movu  [pix0q + 2 * strideq], xm6
+    movu     [pix0q + stride3q], xm7
+%endif
+    RET
+%endmacro
+
+INIT_YMM avx2
+LOOP_FILTER_LUMA 8
+LOOP_FILTER_LUMA 10
+LOOP_FILTER_LUMA 12
+LOOP_FILTER_CHROMA 8
+LOOP_FILTER_CHROMA 10
+LOOP_FILTER_CHROMA 12
+
+%endif
+%endif
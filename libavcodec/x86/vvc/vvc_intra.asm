@@ -0,0 +1,1270 @@
+;******************************************************************************
+;* VVC intra prediction SIMD optimizations
+;*
+;* This file is part of FFmpeg.
+;*
+;* FFmpeg is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* FFmpeg is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with FFmpeg; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA 32
+
+pd_0xff: times 8 dd 0xff
+pd_8:    times 8 dd 8
+pd_0to7: dd 0, 1, 2, 3, 4, 5, 6, 7
+
+; the two 7-sample rows of a 16-byte load as words, in the low and high lanes
+mip_shuf7:       db  0, -1,  1, -1,  2, -1,  3, -1,  4, -1,  5, -1,  6, -1, -1, -1
+                 db  7, -1,  8, -1,  9, -1, 10, -1, 11, -1, 12, -1, 13, -1, -1, -1
+mip_shuf7_end:   db  2, -1,  3, -1,  4, -1,  5, -1,  6, -1,  7, -1,  8, -1, -1, -1
+                 db  9, -1, 10, -1, 11, -1, 12, -1, 13, -1, 14, -1, 15, -1, -1, -1
+mip_perm:        dd 0, 4, 1, 5, 2, 6, 3, 7
+mip_perm_4:      dd 0, 1, 4, 5, 2, 3, 6, 7
+mip_perm_before: dd 0, 0, 1, 2, 3, 4, 5, 6
+
+cextern pw_1
+cextern pw_2
+cextern pw_4
+cextern pw_255
+cextern pw_512
+cextern pd_1
+cextern pd_32
+
+SECTION .text
+
+%if ARCH_X86_64
+%if HAVE_AVX2_EXTERNAL
+
+; m6, m7: taps (0, 1) and (2, 3) of the row's filter
+; m12: pw_512 for 8bpc, pd_32 for 16bpc
+; m13: pixel_max, m15: zero, 16bpc only
+; out: %2 %+ 0
+%macro ANGULAR_FILTER 3 ; bpc, m or xm, x offset in bytes
+%if %1 == 8
+    movu          %2 %+ 0, [srcq + %3]
+    movu          %2 %+ 1, [srcq + %3 + 1]
+    movu          %2 %+ 2, [srcq + %3 + 2]
+    movu          %2 %+ 3, [srcq + %3 + 3]
+    punpckhbw     %2 %+ 4, %2 %+ 0, %2 %+ 1
+    punpcklbw     %2 %+ 0, %2 %+ 1
+    punpckhbw     %2 %+ 5, %2 %+ 2, %2 %+ 3
+    punpcklbw     %2 %+ 2, %2 %+ 3
+    pmaddubsw     %2 %+ 0, %2 %+ 6
+    pmaddubsw     %2 %+ 4, %2 %+ 6
+    pmaddubsw     %2 %+ 2, %2 %+ 7
+    pmaddubsw     %2 %+ 5, %2 %+ 7
+    paddw         %2 %+ 0, %2 %+ 2
+    paddw         %2 %+ 4, %2 %+ 5
+    pmulhrsw      %2 %+ 0, %2 %+ 12
+    pmulhrsw      %2 %+ 4, %2 %+ 12
+    packuswb      %2 %+ 0, %2 %+ 4
+%else
+    movu          %2 %+ 0, [srcq + %3]
+    movu          %2 %+ 1, [srcq + %3 + 2]
+    movu          %2 %+ 2, [srcq + %3 + 4]
+    movu          %2 %+ 3, [srcq + %3 + 6]
+    punpckhwd     %2 %+ 4, %2 %+ 0, %2 %+ 1
+    punpcklwd     %2 %+ 0, %2 %+ 1
+    punpckhwd     %2 %+ 5, %2 %+ 2, %2 %+ 3
+    punpcklwd     %2 %+ 2, %2 %+ 3
+    pmaddwd       %2 %+ 0, %2 %+ 6
+    pmaddwd       %2 %+ 4, %2 %+ 6
+    pmaddwd       %2 %+ 2, %2 %+ 7
+    pmaddwd       %2 %+ 5, %2 %+ 7
+    paddd         %2 %+ 0, %2 %+ 2
+    paddd         %2 %+ 4, %2 %+ 5
+    paddd         %2 %+ 0, %2 %+ 12
+    paddd         %2 %+ 4, %2 %+ 12
+    psrad         %2 %+ 0, 6
+    psrad         %2 %+ 4, 6
+    packssdw      %2 %+ 0, %2 %+ 4
+    pmaxsw        %2 %+ 0, %2 %+ 15
+    pminsw        %2 %+ 0, %2 %+ 13
+%endif
+%endmacro
+
+; applies PDPC to the first 16 samples of the row in m0
+; m8, m9: offsets into side, m10: weights << 9, m14: pd_0xff for 8bpc
+%macro ANGULAR_PDPC 1 ; bpc
+    pcmpeqd       m11, m11
+%if %1 == 8
+    vpgatherdd    m1, [sideq + m8], m11
+    pcmpeqd       m11, m11
+    vpgatherdd    m2, [sideq + m9], m11
+    pand          m1, m14
+    pand          m2, m14
+%else
+    vpgatherdd    m1, [sideq + m8 * 2], m11
+    pcmpeqd       m11, m11
+    vpgatherdd    m2, [sideq + m9 * 2], m11
+    pblendw       m1, m15, 0xaa
+    pblendw       m2, m15, 0xaa
+%endif
+    packusdw      m1, m2
+    vpermq        m1, m1, q3120
+%if %1 == 8
+    pmovzxbw      m2, xm0
+    psubw         m1, m2
+    pmulhrsw      m1, m10
+    paddw         m1, m2
+    vextracti128  xm2, m1, 1
+    packuswb      xm1, xm2
+    vpblendd      m0, m1, 0x0f
+%else
+    psubw         m1, m0
+    pmulhrsw      m1, m10
+    paddw         m0, m1
+    pmaxsw        m0, m15
+    pminsw        m0, m13
+%endif
+    add        sideq, %1 / 8
+%endmacro
+
+%macro ANGULAR_ROW_INIT 1 ; bpc
+    mov        factd, posd
+    and        factd, 31
+    mov         srcq, posq
+    sar         srcq, 5
+%if %1 == 8
+    add         srcq, refq
+    vpbroadcastw  m6, [filterq + factq * 4]
+    vpbroadcastw  m7, [filterq + factq * 4 + 2]
+%else
+    lea         srcq, [refq + srcq * 2]
+    vpbroadcastd xm6, [filterq + factq * 4]
+    pmovsxbw      m6, xm6
+    pshufd        m7, m6, q1111
+    pshufd        m6, m6, q0000
+%endif
+%endmacro
+
+%macro ANGULAR_ROWS_NARROW 2 ; bpc, pdpc
+%%loop:
+    ANGULAR_ROW_INIT %1
+    ANGULAR_FILTER %1, xm, 0
+%if %2
+    ANGULAR_PDPC   %1
+%endif
+    cmp           wd, 8
+    jl %%w4
+    je %%w8
+    movu      [dstq], xm0
+    jmp %%next
+%%w8:
+    movq      [dstq], xm0
+    jmp %%next
+%%w4:
+    movd      [dstq], xm0
+%%next:
+    add         dstq, strideq
+    add         posq, angleq
+    dec           hd
+    jg %%loop
+    RET
+%endmacro
+
+%macro ANGULAR_ROWS_WIDE 2 ; bpc, pdpc
+%%loop:
+    ANGULAR_ROW_INIT %1
+    ANGULAR_FILTER %1, m, 0
+%if %2
+    ANGULAR_PDPC   %1
+%endif
+    movu      [dstq], m0
+    mov         cold, mmsize
+    cmp         cold, wd
+    jge %%next
+%%loop_x:
+    ANGULAR_FILTER %1, m, colq
+    movu [dstq + colq], m0
+    add         cold, mmsize
+    cmp         cold, wd
+    jl %%loop_x
+%%next:
+    add         dstq, strideq
+    add         posq, angleq
+    dec           hd
+    jg %%loop
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_pred_angular_%1bpc_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *ref, intptr_t w,
+;     intptr_t h, intptr_t pos, intptr_t angle, const int8_t *filter, const uint8_t *side,
+;     const int32_t *pdpc, intptr_t pixel_max);
+; Row y of the block is the 4-tap filter filter[pos & 31] over ref[x + (pos >> 5) + 0..3], pos advances
+; by angle every row. If side is set, PDPC mixes side[y + pdpc[x]] into sample x of the row with weight
+; ((int16_t *)(pdpc + 16))[x] >> 9, for x < 16.
+;-------------------------------------------------------------------------------------------------------------
+%macro PRED_ANGULAR 1 ; bpc
+cglobal vvc_pred_angular_%1bpc, 11, 14, 16, dst, stride, ref, w, h, pos, angle, filter, side, pdpc, \
+    pixel_max, src, col, fact
+%if %1 == 8
+    mova         m12, [pw_512]
+    mova         m14, [pd_0xff]
+%else
+    mova         m12, [pd_32]
+    movd        xm13, pixel_maxd
+    vpbroadcastw m13, xm13
+    pxor         m15, m15
+    shl           wd, 1
+%endif
+    test       sideq, sideq
+    jz .no_pdpc
+    mova          m8, [pdpcq]
+    mova          m9, [pdpcq + 32]
+    mova         m10, [pdpcq + 64]
+    cmp           wd, mmsize
+    jge .wide_pdpc
+    ANGULAR_ROWS_NARROW %1, 1
+.wide_pdpc:
+    ANGULAR_ROWS_WIDE   %1, 1
+.no_pdpc:
+    cmp           wd, mmsize
+    jge .wide
+    ANGULAR_ROWS_NARROW %1, 0
+.wide:
+    ANGULAR_ROWS_WIDE   %1, 0
+%endmacro
+
+INIT_YMM avx2
+PRED_ANGULAR 8
+PRED_ANGULAR 16
+
+; stores the rows of a transposed tile, %2 is the width in samples
+%macro TRANSPOSE_STORE_ROW 3 ; bpc, width, row
+%if %1 == 8
+    packuswb     m%3, m%3
+%if %2 == 8
+    movq         [rowq], m%3
+%else
+    movd         [rowq], m%3
+%endif
+%else
+%if %2 == 8
+    movu         [rowq], m%3
+%else
+    movq         [rowq], m%3
+%endif
+%endif
+    add          rowq, strideq
+%endmacro
+
+%macro TRANSPOSE_TILES 2 ; bpc, width of the stored tiles
+%%loop_y:
+    mov          srcpq, srcq
+    mov          dstpq, dstq
+    mov          cold, widthd
+%%loop_x:
+%assign i 0
+%rep 8
+%if %1 == 8
+    pmovzxbw     m %+ i, [srcpq]
+%else
+    movu         m %+ i, [srcpq]
+%endif
+    add          srcpq, src_strideq
+%assign i i + 1
+%endrep
+    TRANSPOSE8x8W 0, 1, 2, 3, 4, 5, 6, 7, 8
+    mov          rowq, dstpq
+    TRANSPOSE_STORE_ROW %1, %2, 0
+    cmp          heightd, 1
+    je %%next_x
+    TRANSPOSE_STORE_ROW %1, %2, 1
+    cmp          heightd, 2
+    je %%next_x
+    TRANSPOSE_STORE_ROW %1, %2, 2
+    TRANSPOSE_STORE_ROW %1, %2, 3
+    cmp          heightd, 4
+    je %%next_x
+    TRANSPOSE_STORE_ROW %1, %2, 4
+    TRANSPOSE_STORE_ROW %1, %2, 5
+    TRANSPOSE_STORE_ROW %1, %2, 6
+    TRANSPOSE_STORE_ROW %1, %2, 7
+%%next_x:
+    add          dstpq, 8 * %1 / 8
+    sub          cold, 8
+    jg %%loop_x
+    add          srcq, 8 * %1 / 8
+    lea          dstq, [dstq + strideq * 8]
+    sub          heightd, 8
+    jg %%loop_y
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_transpose_%1bpc_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *src, ptrdiff_t src_stride,
+;     intptr_t w, intptr_t h);
+; Writes the w x h block at dst from src, which holds its columns as rows. w and h are powers of two, w >= 4,
+; src is read in tiles of 8 x 8 samples.
+;-------------------------------------------------------------------------------------------------------------
+%macro TRANSPOSE 1 ; bpc
+cglobal vvc_transpose_%1bpc, 6, 10, 9, dst, stride, src, src_stride, width, height, col, srcp, dstp, row
+    cmp          widthd, 4
+    je .w4
+    TRANSPOSE_TILES %1, 8
+.w4:
+    TRANSPOSE_TILES %1, 4
+%endmacro
+
+INIT_XMM avx2
+TRANSPOSE 8
+TRANSPOSE 16
+
+; m0-m3: two matrix rows of 8 words each, one per lane, m4: the reduced boundary in both lanes
+; out: m0, the 8 dot products in order
+%macro MIP_DOT8 0
+    pmaddwd       m0, m4
+    pmaddwd       m1, m4
+    pmaddwd       m2, m4
+    pmaddwd       m3, m4
+    phaddd        m0, m1
+    phaddd        m2, m3
+    phaddd        m0, m2
+    vpermd        m0, m9, m0
+%endmacro
+
+; m5: ow, m6: temp0, m7: pixel_max, m8: zero
+%macro MIP_STORE 2 ; reg, offset
+    paddd        m%1, m5
+    psrad        m%1, 6
+    paddd        m%1, m6
+    pmaxsd       m%1, m8
+    pminsd       m%1, m7
+    mova [predq + %2], m%1
+%endmacro
+
+; the rows of size id 2 are 7 bytes, the load of the last pair is moved back to stay in the matrix
+%macro MIP_LOAD7 3 ; reg, pair, last
+%if %3 && %2 == 3
+    vbroadcasti128 m%1, [matrixq + 14 * %2 - 2]
+    pshufb         m%1, [mip_shuf7_end]
+%else
+    vbroadcasti128 m%1, [matrixq + 14 * %2]
+    pshufb         m%1, m10
+%endif
+%endmacro
+
+%macro MIP_DOT7 1 ; last
+    MIP_LOAD7      0, 0, %1
+    MIP_LOAD7      1, 1, %1
+    MIP_LOAD7      2, 2, %1
+    MIP_LOAD7      3, 3, %1
+    MIP_DOT8
+    MIP_STORE      0, 0
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_mip_matmul_avx2(int32_t *pred, const int16_t *reduced, const uint8_t *matrix, intptr_t size_id,
+;     intptr_t ow, intptr_t temp0, intptr_t pixel_max);
+; The reduced prediction of MIP, clip(((matrix * reduced + ow) >> 6) + temp0), in raster order. reduced
+; holds 8 samples, zero past the input size.
+;-------------------------------------------------------------------------------------------------------------
+INIT_YMM avx2
+cglobal vvc_mip_matmul, 7, 8, 11, pred, reduced, matrix, size_id, ow, temp0, pixel_max, cnt
+    movd         xm5, owd
+    vpbroadcastd  m5, xm5
+    movd         xm6, temp0d
+    vpbroadcastd  m6, xm6
+    movd         xm7, pixel_maxd
+    vpbroadcastd  m7, xm7
+    pxor          m8, m8
+    cmp     size_idd, 1
+    je .size1
+    jg .size2
+
+    ; 16 rows of 4
+    vpbroadcastq  m4, [reducedq]
+    mova          m9, [mip_perm_4]
+    pmovzxbw      m0, [matrixq]
+    pmovzxbw      m1, [matrixq + 16]
+    pmovzxbw      m2, [matrixq + 32]
+    pmovzxbw      m3, [matrixq + 48]
+    pmaddwd       m0, m4
+    pmaddwd       m1, m4
+    pmaddwd       m2, m4
+    pmaddwd       m3, m4
+    phaddd        m0, m1
+    phaddd        m2, m3
+    vpermd        m0, m9, m0
+    vpermd        m2, m9, m2
+    MIP_STORE      0, 0
+    MIP_STORE      2, 32
+    RET
+
+.size1:
+    ; 16 rows of 8
+    vbroadcasti128 m4, [reducedq]
+    mova          m9, [mip_perm]
+    mov         cntd, 2
+.loop1:
+    pmovzxbw      m0, [matrixq]
+    pmovzxbw      m1, [matrixq + 16]
+    pmovzxbw      m2, [matrixq + 32]
+    pmovzxbw      m3, [matrixq + 48]
+    MIP_DOT8
+    MIP_STORE      0, 0
+    add      matrixq, 64
+    add        predq, 32
+    dec         cntd
+    jg .loop1
+    RET
+
+.size2:
+    ; 64 rows of 7
+    vbroadcasti128 m4, [reducedq]
+    mova          m9, [mip_perm]
+    mova         m10, [mip_shuf7]
+    mov         cntd, 7
+.loop2:
+    MIP_DOT7       0
+    add      matrixq, 56
+    add        predq, 32
+    dec         cntd
+    jg .loop2
+    MIP_DOT7       1
+    RET
+
+%macro MIP_LOAD 4 ; bpc, width, dst, src
+%if %1 == 8
+%if %2 == 4
+    movd          %3, %4
+    pmovzxbw      %3, %3
+%else
+    pmovzxbw      %3, %4
+%endif
+%elif %2 == 4
+    movq          %3, %4
+%else
+    movu          %3, %4
+%endif
+%endmacro
+
+; clobbers m5 for 8bpc
+%macro MIP_STORE_ROW 4 ; bpc, width, m or xm, src
+%if %1 == 8
+%if %2 == 16
+    vextracti128    xm5, m%4, 1
+    packuswb     xm%4, xm5
+    movu       [colq], xm%4
+%else
+    packuswb     xm%4, xm%4
+%if %2 == 8
+    movq       [colq], xm%4
+%else
+    movd       [colq], xm%4
+%endif
+%endif
+%elif %2 == 4
+    movq       [colq], xm%4
+%else
+    movu       [colq], %3%4
+%endif
+%endmacro
+
+; vertical upsampling between the rows written by the horizontal pass, %2 samples at a time
+; m12: 1 << (15 - log2(up_ver)), upd: up_ver - 1, rowsq: (up_ver - 1) * stride
+%macro MIP_UPSAMPLE_VER 3 ; bpc, width, m or xm
+    xor           offd, offd
+%%loop_x:
+    MIP_LOAD      %1, %2, %3 %+ 0, [topq + offq]
+    lea         colq, [dstq + offq]
+    mov           cntd, psd
+%%loop_blk:
+    MIP_LOAD      %1, %2, %3 %+ 1, [colq + rowsq]
+    psubw     %3 %+ 2, %3 %+ 1, %3 %+ 0
+    mova      %3 %+ 3, %3 %+ 12
+    mov           td, upd
+%%loop_y:
+    pmulhrsw  %3 %+ 4, %3 %+ 2, %3 %+ 3
+    paddw     %3 %+ 4, %3 %+ 0
+    MIP_STORE_ROW %1, %2, %3, 4
+    add         colq, strideq
+    paddw     %3 %+ 3, %3 %+ 12
+    dec           td
+    jg %%loop_y
+    add         colq, strideq
+    mova      %3 %+ 0, %3 %+ 1
+    dec           cntd
+    jg %%loop_blk
+%if %2 == 16
+    add           offd, 16 * %1 / 8
+    cmp           offd, wd
+    jl %%loop_x
+%endif
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_mip_upsample_%1bpc_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *top, const uint8_t *left,
+;     intptr_t w, intptr_t up_hor, intptr_t up_ver, const int32_t *pred, intptr_t pred_size,
+;     intptr_t transposed);
+; Places the pred_size x pred_size reduced prediction, transposed if requested, in the w x h block and
+; interpolates the rest of it: the rows holding reduced samples from left first, then every column from top.
+;-------------------------------------------------------------------------------------------------------------
+%macro MIP_UPSAMPLE 1 ; bpc
+cglobal vvc_mip_upsample_%1bpc, 10, 15, 16, dst, stride, top, left, w, hor, up, pred, ps, tr, \
+    rows, off, cnt, t, col
+%if %1 == 16
+    shl           wd, 1
+%endif
+    ; gather offsets of a row of the reduced prediction and the step between rows
+    mov           td, psd
+    mov           offd, 1
+    test         trd, trd
+    jz .steps
+    xchg          td, offd
+.steps:
+    lea          trq, [tq * 4]
+    movd         xm0, offd
+    vpbroadcastd  m0, xm0
+    pmulld       m15, m0, [pd_0to7]
+
+    mova         m14, [pd_1]
+    bsf         hord, hord
+    movd        xm13, hord
+    pslld        m12, m14, xm13
+    psrld        m11, m12, 1
+    psubd        m12, m14
+    mova         m10, [mip_perm_before]
+
+    ; horizontal upsampling of every up-th row, starting at up - 1
+    mov         rowsq, upq
+    imul        rowsq, strideq
+    mov          colq, rowsq
+    sub          colq, strideq
+    add          colq, dstq
+    lea         leftq, [leftq + upq * (%1 / 8) - (%1 / 8)]
+    mov            cntd, psd
+.loop_hor:
+    pcmpeqd        m0, m0
+    vpgatherdd     m1, [predq + m15 * 4], m0
+    add         predq, trq
+%if %1 == 8
+    movzx          td, byte [leftq]
+%else
+    movzx          td, word [leftq]
+%endif
+    movd          xm0, td
+    vpermd         m2, m10, m1
+    vpblendd       m2, m0, 0x01
+    mova           m3, [pd_0to7]
+    xor            offd, offd
+.loop_hor_x:
+    ; before + ((k * (after - before) + up_hor / 2) >> log2(up_hor)), k = (x & (up_hor - 1)) + 1
+    psrld          m4, m3, xm13
+    pand           m5, m3, m12
+    paddd          m5, m14
+    vpermd         m6, m4, m1
+    vpermd         m4, m4, m2
+    psubd          m6, m4
+    pmulld         m6, m5
+    paddd          m6, m11
+    psrad          m6, xm13
+    paddd          m6, m4
+    packusdw       m6, m6
+    vpermq         m6, m6, q2020
+%if %1 == 8
+    packuswb      xm6, xm6
+%endif
+    cmp            wd, 4 * %1 / 8
+    je .hor_w4
+%if %1 == 8
+    movq  [colq + offq], xm6
+%else
+    movu  [colq + offq], xm6
+%endif
+    paddd          m3, [pd_8]
+    add            offd, 8 * %1 / 8
+    cmp            offd, wd
+    jl .loop_hor_x
+    jmp .next_hor
+.hor_w4:
+%if %1 == 8
+    movd       [colq], xm6
+%else
+    movq       [colq], xm6
+%endif
+.next_hor:
+    add          colq, rowsq
+    lea         leftq, [leftq + upq * (%1 / 8)]
+    dec            cntd
+    jg .loop_hor
+
+    cmp           upd, 1
+    je .end
+    bsf            td, upd
+    movd         xm13, td
+    pcmpeqw       m12, m12
+    psllw         m12, 15
+    psrlw         m12, xm13
+    dec           upd
+    sub         rowsq, strideq
+    cmp            wd, 8 * %1 / 8
+    jg .ver_w16
+    je .ver_w8
+    MIP_UPSAMPLE_VER %1, 4, xm
+.ver_w8:
+    MIP_UPSAMPLE_VER %1, 8, xm
+.ver_w16:
+    MIP_UPSAMPLE_VER %1, 16, m
+.end:
+    RET
+%endmacro
+
+INIT_YMM avx2
+MIP_UPSAMPLE 8
+MIP_UPSAMPLE 16
+
+; %4, %5: the even and odd samples of the 2 * %2 samples at [%3] as words, clobbers m8 for 16bpc
+; m6: pw_255 for 8bpc, zero for 16bpc
+%macro CCLM_LOAD_EO 5 ; bpc, outputs, src, even, odd
+%if %1 == 8
+%if %2 == 8
+    movu          %4, [%3]
+%else
+    movq          %4, [%3]
+%endif
+    psrlw         %5, %4, 8
+    pand          %4, m6
+%else
+    movu          %4, [%3]
+    psrld         %5, %4, 16
+    pblendw       %4, m6, 0xaa
+%if %2 == 8
+    movu          m8, [%3 + 16]
+    pblendw       m7, m8, m6, 0xaa
+    psrld         m8, 16
+    packusdw      %4, m7
+    packusdw      %5, m8
+%else
+    packusdw      %4, %4
+    packusdw      %5, %5
+%endif
+%endif
+%endmacro
+
+; %2: the odd samples shifted up by one, with the sample at [%4] first
+%macro CCLM_LEFT 4 ; bpc, dst, odd, left
+%if %1 == 8
+    movzx         td, byte [%4]
+%else
+    movzx         td, word [%4]
+%endif
+    pslldq        %2, %3, 2
+    pinsrw        %2, td, 0
+%endmacro
+
+%macro CCLM_DOWNSAMPLE_ROWS 3 ; bpc, variant, outputs
+.loop_y_%3:
+    mov        srcpq, srcq
+%ifidn %2, 420c
+    mov        toppq, topq
+%endif
+    mov          loq, avail_lq
+    mov         cntd, wd
+.loop_x_%3:
+    CCLM_LOAD_EO  %1, %3, srcpq, m0, m1
+    CCLM_LEFT     %1, m2, m1, srcpq + loq
+%ifidn %2, 422
+    ; (left + 2 * even + odd + 2) >> 2
+    paddw         m0, m0
+    paddw         m0, m1
+    paddw         m0, m2
+    paddw         m0, m5
+    psrlw         m0, 2
+%elifidn %2, 420c
+    ; (left + top + 4 * even + odd + below + 4) >> 3, the odd samples of both rows are unused
+    CCLM_LOAD_EO  %1, %3, toppq, m3, m4
+    CCLM_LOAD_EO  %1, %3, srcpq + strideq, m4, m7
+    psllw         m0, 2
+    paddw         m0, m1
+    paddw         m0, m2
+    paddw         m0, m3
+    paddw         m0, m4
+    paddw         m0, m5
+    psrlw         m0, 3
+%else
+    ; (left + left below + 2 * (even + even below) + odd + odd below + 4) >> 3
+    lea        toppq, [srcpq + strideq]
+    CCLM_LOAD_EO  %1, %3, toppq, m3, m4
+    CCLM_LEFT     %1, m7, m4, toppq + loq
+    paddw         m0, m3
+    paddw         m0, m0
+    paddw         m0, m1
+    paddw         m0, m2
+    paddw         m0, m4
+    paddw         m0, m7
+    paddw         m0, m5
+    psrlw         m0, 3
+%endif
+%if %1 == 8
+    packuswb      m0, m0
+%if %3 == 8
+    movq      [dstq], m0
+%else
+    movd      [dstq], m0
+%endif
+%elif %3 == 8
+    movu      [dstq], m0
+%else
+    movq      [dstq], m0
+%endif
+    add         dstq, %3 * %1 / 8
+    add        srcpq, 2 * %3 * %1 / 8
+%ifidn %2, 420c
+    add        toppq, 2 * %3 * %1 / 8
+%endif
+    mov          loq, -(%1 / 8)
+    sub         cntd, %3
+    jg .loop_x_%3
+%ifidn %2, 422
+    add         srcq, strideq
+%else
+    lea         srcq, [srcq + strideq * 2]
+%endif
+%ifidn %2, 420c
+    mov         topq, srcq
+    sub         topq, strideq
+%endif
+    dec           hd
+    jg .loop_y_%3
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_cclm_downsample_%2_%1bpc_avx2(uint8_t *pdsy, const uint8_t *src, ptrdiff_t stride, int w, int h,
+;     int avail_t, int avail_l);
+; cclm_downsample_luma[] of VVCIntraDSPContext, stride is in samples. w is 4 or a multiple of 8.
+;-------------------------------------------------------------------------------------------------------------
+%macro CCLM_DOWNSAMPLE 2 ; bpc, variant
+cglobal vvc_cclm_downsample_%2_%1bpc, 7, 13, 9, dst, src, stride, w, h, avail_t, avail_l, top, srcp, \
+    topp, lo, cnt, t
+%if %1 == 16
+    add       strideq, strideq
+%endif
+    neg     avail_ld
+    movsxd  avail_lq, avail_ld
+%if %1 == 16
+    add     avail_lq, avail_lq
+%endif
+%ifidn %2, 420c
+    mov          topq, srcq
+    test     avail_td, avail_td
+    jz .top
+    sub          topq, strideq
+.top:
+%endif
+%if %1 == 8
+    mova           m6, [pw_255]
+%else
+    pxor           m6, m6
+%endif
+%ifidn %2, 422
+    mova           m5, [pw_2]
+%else
+    mova           m5, [pw_4]
+%endif
+    cmp            wd, 4
+    je .w4
+    CCLM_DOWNSAMPLE_ROWS %1, %2, 8
+.w4:
+    CCLM_DOWNSAMPLE_ROWS %1, %2, 4
+%endmacro
+
+INIT_XMM avx2
+CCLM_DOWNSAMPLE  8, 422
+CCLM_DOWNSAMPLE  8, 420c
+CCLM_DOWNSAMPLE  8, 420
+CCLM_DOWNSAMPLE 16, 422
+CCLM_DOWNSAMPLE 16, 420c
+CCLM_DOWNSAMPLE 16, 420
+
+%macro CCLM_LINEAR_ROWS 3 ; bpc, m or xm, outputs
+.loop_y_%3:
+    xor          colq, colq
+.loop_x_%3:
+%if %1 == 8
+    pmovzxbd   %2 %+ 0, [pdsyq + colq]
+%else
+    pmovzxwd   %2 %+ 0, [pdsyq + colq * 2]
+%endif
+    pmaddwd    %2 %+ 0, %2 %+ 4
+    psrad      %2 %+ 0, xm6
+    paddd      %2 %+ 0, %2 %+ 5
+%if %1 == 8
+%if %3 == 8
+    vextracti128   xm1, m0, 1
+    packssdw       xm0, xm1
+%else
+    packssdw       xm0, xm0
+%endif
+    packuswb       xm0, xm0
+%if %3 == 8
+    movq [dstq + colq], xm0
+%else
+    movd [dstq + colq], xm0
+%endif
+%else
+%if %3 == 8
+    vextracti128   xm1, m0, 1
+    packusdw       xm0, xm1
+%else
+    packusdw       xm0, xm0
+%endif
+    pminuw         xm0, xm7
+%if %3 == 8
+    movu [dstq + colq * 2], xm0
+%else
+    movq [dstq + colq * 2], xm0
+%endif
+%endif
+    add          colq, %3
+    cmp          cold, wd
+    jl .loop_x_%3
+%if %1 == 8
+    add         pdsyq, wq
+%else
+    lea         pdsyq, [pdsyq + wq * 2]
+%endif
+    add          dstq, strideq
+    dec            hd
+    jg .loop_y_%3
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_cclm_linear_pred_%1bpc_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *pdsy, intptr_t w,
+;     intptr_t h, intptr_t a, intptr_t b, intptr_t k, intptr_t pixel_max);
+; clip(((pdsy * a) >> k) + b), stride is in samples and the w x h samples of pdsy are contiguous.
+;-------------------------------------------------------------------------------------------------------------
+%macro CCLM_LINEAR_PRED 1 ; bpc
+cglobal vvc_cclm_linear_pred_%1bpc, 9, 10, 8, dst, stride, pdsy, w, h, a, b, k, pixel_max, col
+%if %1 == 16
+    add       strideq, strideq
+    movd          xm7, pixel_maxd
+    vpbroadcastw  xm7, xm7
+%endif
+    ; the high word of a is multiplied by the zero high word of each sample
+    movd          xm4, ad
+    vpbroadcastd   m4, xm4
+    movd          xm5, bd
+    vpbroadcastd   m5, xm5
+    movd          xm6, kd
+    cmp            wd, 4
+    je .w4
+    CCLM_LINEAR_ROWS %1, m, 8
+.w4:
+    CCLM_LINEAR_ROWS %1, xm, 4
+%endmacro
+
+INIT_YMM avx2
+CCLM_LINEAR_PRED 8
+CCLM_LINEAR_PRED 16
+
+; stores the first %1 bytes of m0-m3 at dstq, or of m0 repeated if %2 is set
+%macro INTRA_STORE_ROW 2 ; bytes, repeat m0
+%if %1 == 4
+    movd      [dstq], xm0
+%elif %1 == 8
+    movq      [dstq], xm0
+%elif %1 == 16
+    movu      [dstq], xm0
+%else
+%assign j 0
+%rep %1 / 32
+%if %2
+    movu [dstq + j * 32], m0
+%else
+    movu [dstq + j * 32], m %+ j
+%endif
+%assign j j + 1
+%endrep
+%endif
+%endmacro
+
+%macro INTRA_LOAD_ROW 2 ; bytes, src
+%if %1 == 4
+    movd          xm0, [%2]
+%elif %1 == 8
+    movq          xm0, [%2]
+%elif %1 == 16
+    movu          xm0, [%2]
+%else
+%assign j 0
+%rep %1 / 32
+    movu       m %+ j, [%2 + j * 32]
+%assign j j + 1
+%endrep
+%endif
+%endmacro
+
+%macro INTRA_W_DISPATCH 0
+    cmp            wd, 8
+    jl .w4
+    je .w8
+    cmp            wd, 32
+    jl .w16
+    je .w32
+    jmp .w64
+%endmacro
+
+; fills h rows of w samples with m0-m3, or with the top row if %3 is set
+%macro INTRA_FILL_ROWS 3 ; bpc, w, load top
+.w%2:
+%if %3
+    INTRA_LOAD_ROW %2 * %1 / 8, topq
+%endif
+.loop_w%2:
+    INTRA_STORE_ROW %2 * %1 / 8, 0
+    add          dstq, strideq
+    dec            hd
+    jg .loop_w%2
+    RET
+%endmacro
+
+%macro INTRA_FILL 2 ; bpc, load top
+    INTRA_W_DISPATCH
+    INTRA_FILL_ROWS %1,  4, %2
+    INTRA_FILL_ROWS %1,  8, %2
+    INTRA_FILL_ROWS %1, 16, %2
+    INTRA_FILL_ROWS %1, 32, %2
+    INTRA_FILL_ROWS %1, 64, %2
+%endmacro
+
+%macro PRED_H_ROWS 2 ; bpc, w
+.w%2:
+%if %1 == 8
+    vpbroadcastb   m0, [leftq]
+%else
+    vpbroadcastw   m0, [leftq]
+%endif
+    add         leftq, %1 / 8
+    INTRA_STORE_ROW %2 * %1 / 8, 1
+    add          dstq, strideq
+    dec            hd
+    jg .w%2
+    RET
+%endmacro
+
+; adds the %3 samples at %2 to the dword sums in xm0
+%macro DC_SUM 3 ; bpc, src, n
+    cmp           %3d, 4
+    jne %%loop
+%if %1 == 8
+    movd          xm1, [%2]
+    psadbw        xm1, xm2
+%else
+    movq          xm1, [%2]
+    pmaddwd       xm1, xm2
+%endif
+    paddd         xm0, xm1
+    jmp %%end
+%%loop:
+%if %1 == 8
+    movq          xm1, [%2]
+    psadbw        xm1, xm2
+%else
+    movu          xm1, [%2]
+    pmaddwd       xm1, xm2
+%endif
+    paddd         xm0, xm1
+    add            %2, 8 * %1 / 8
+    sub           %3d, 8
+    jg %%loop
+%%end:
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_pred_v_%1bpc_avx2(uint8_t *dst, const uint8_t *top, int w, int h, ptrdiff_t stride);
+; void ff_vvc_pred_h_%1bpc_avx2(uint8_t *dst, const uint8_t *left, int w, int h, ptrdiff_t stride);
+; void ff_vvc_pred_dc_%1bpc_avx2(uint8_t *dst, const uint8_t *top, const uint8_t *left, int w, int h,
+;     ptrdiff_t stride);
+; The functions of VVCIntraDSPContext, stride is in samples. w is 4 to 64, h is 1 to 64.
+;-------------------------------------------------------------------------------------------------------------
+%macro PRED_V_H_DC 1 ; bpc
+cglobal vvc_pred_v_%1bpc, 5, 5, 4, dst, top, w, h, stride
+%if %1 == 16
+    add       strideq, strideq
+%endif
+    INTRA_FILL     %1, 1
+
+cglobal vvc_pred_h_%1bpc, 5, 5, 1, dst, left, w, h, stride
+%if %1 == 16
+    add       strideq, strideq
+%endif
+    INTRA_W_DISPATCH
+    PRED_H_ROWS    %1, 4
+    PRED_H_ROWS    %1, 8
+    PRED_H_ROWS    %1, 16
+    PRED_H_ROWS    %1, 32
+    PRED_H_ROWS    %1, 64
+
+cglobal vvc_pred_dc_%1bpc, 6, 8, 4, dst, top, left, w, h, stride, n, shift
+%if %1 == 16
+    add       strideq, strideq
+    mova          xm2, [pw_1]
+%else
+    pxor          xm2, xm2
+%endif
+    pxor          xm0, xm0
+    ; the longer side, or both if square
+    cmp            wd, hd
+    jl .left
+    mov            nd, wd
+    DC_SUM         %1, topq, n
+    cmp            wd, hd
+    jg .sum_done
+.left:
+    mov            nd, hd
+    DC_SUM         %1, leftq, n
+.sum_done:
+    pshufd        xm1, xm0, q1032
+    paddd         xm0, xm1
+    pshufd        xm1, xm0, q0001
+    paddd         xm0, xm1
+    ; (sum + offset / 2) >> log2(offset), offset is 2 * w if square, else the longer side
+    mov            nd, wd
+    cmp            wd, hd
+    cmovl          nd, hd
+    jne .offset
+    add            nd, nd
+.offset:
+    bsf        shiftd, nd
+    shr            nd, 1
+    movd          xm1, nd
+    paddd         xm0, xm1
+    movd          xm1, shiftd
+    psrld         xm0, xm1
+%if %1 == 8
+    vpbroadcastb   m0, xm0
+%else
+    vpbroadcastw   m0, xm0
+%endif
+    mova           m1, m0
+    mova           m2, m0
+    mova           m3, m0
+    INTRA_FILL     %1, 0
+%endmacro
+
+INIT_YMM avx2
+PRED_V_H_DC 8
+PRED_V_H_DC 16
+
+%macro PLANAR_ROWS 3 ; bpc, m or xm, samples per column
+.loop_x_%3:
+    ; top[x] and the vertical part of row 0, stepped by (left[h] - top[x]) << log2(w) each row
+%if %1 == 8
+    pmovzxbd   %2 %+ 0, [topq + colq]
+%else
+    pmovzxwd   %2 %+ 0, [topq + colq * 2]
+%endif
+    psubd      %2 %+ 1, %2 %+ 15, %2 %+ 0
+    pslld      %2 %+ 1, xm13
+    pmulld     %2 %+ 0, %2 %+ 9
+    paddd      %2 %+ 0, %2 %+ 15
+    pslld      %2 %+ 0, xm13
+    ; the horizontal part is left[y] * ((w - 1 - x) << log2(h)) + (((x + 1) * top[w]) << log2(h))
+    pmulld     %2 %+ 2, %2 %+ 8, %2 %+ 14
+    pslld      %2 %+ 2, xm12
+    paddd      %2 %+ 2, %2 %+ 10
+    paddd      %2 %+ 0, %2 %+ 2
+    psubd      %2 %+ 2, %2 %+ 7, %2 %+ 8
+    pslld      %2 %+ 2, xm12
+    lea         dstpq, [dstq + colq * (%1 / 8)]
+    mov         leftpq, leftq
+    mov          rowd, hd
+.loop_y_%3:
+%if %1 == 8
+    movzx          td, byte [leftpq]
+    movd          xm3, td
+    vpbroadcastw  %2 %+ 3, xm3
+%else
+    vpbroadcastw  %2 %+ 3, [leftpq]
+%endif
+    pmaddwd    %2 %+ 3, %2 %+ 2
+    paddd      %2 %+ 3, %2 %+ 0
+    psrld      %2 %+ 3, xm11
+%if %3 == 8
+    vextracti128   xm4, m3, 1
+    packusdw       xm3, xm4
+%else
+    packusdw       xm3, xm3
+%endif
+%if %1 == 8
+    packuswb       xm3, xm3
+%if %3 == 8
+    movq      [dstpq], xm3
+%else
+    movd      [dstpq], xm3
+%endif
+%elif %3 == 8
+    movu      [dstpq], xm3
+%else
+    movq      [dstpq], xm3
+%endif
+    paddd      %2 %+ 0, %2 %+ 1
+    add         dstpq, strideq
+    add        leftpq, %1 / 8
+    dec          rowd
+    jg .loop_y_%3
+    paddd      %2 %+ 8, %2 %+ 6
+    add          colq, %3
+    cmp          cold, wd
+    jl .loop_x_%3
+    RET
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_pred_planar_%1bpc_avx2(uint8_t *dst, const uint8_t *top, const uint8_t *left, int w, int h,
+;     ptrdiff_t stride);
+; pred_planar of VVCIntraDSPContext, stride is in samples. The block is predicted in columns of 8 samples.
+;-------------------------------------------------------------------------------------------------------------
+%macro PRED_PLANAR 1 ; bpc
+cglobal vvc_pred_planar_%1bpc, 6, 12, 16, dst, top, left, w, h, stride, col, dstp, leftp, row, t, logw
+%if %1 == 16
+    add       strideq, strideq
+%endif
+    mov            wd, wd
+    mov            hd, hd
+    bsf         logwd, wd
+    movd         xm13, logwd
+    bsf            td, hd
+    movd         xm12, td
+    lea            td, [logwq + tq + 1]
+    movd         xm11, td
+%if %1 == 8
+    movzx          td, byte [leftq + hq]
+    movd         xm15, td
+    movzx          td, byte [topq + wq]
+%else
+    movzx          td, word [leftq + hq * 2]
+    movd         xm15, td
+    movzx          td, word [topq + wq * 2]
+%endif
+    vpbroadcastd  m15, xm15
+    movd         xm14, td
+    vpbroadcastd  m14, xm14
+    mov            td, wd
+    imul           td, hd
+    movd         xm10, td
+    vpbroadcastd  m10, xm10
+    lea            td, [hq - 1]
+    movd          xm9, td
+    vpbroadcastd   m9, xm9
+    movd          xm7, wd
+    vpbroadcastd   m7, xm7
+    ; x + 1 and its step between columns
+    mova           m8, [pd_0to7]
+    paddd          m8, [pd_1]
+    mova           m6, [pd_8]
+    xor          cold, cold
+    cmp            wd, 4
+    je .w4
+    PLANAR_ROWS    %1, m, 8
+.w4:
+    PLANAR_ROWS    %1, xm, 4
+%endmacro
+
+;-------------------------------------------------------------------------------------------------------------
+; void ff_vvc_ibc_copy_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,
+;     int w, int h);
+; ibc_copy of VVCIntraDSPContext. w is any width, as the block is split where it wraps around the IBC buffer.
+; Each row is copied with the widest loads and stores that fit, the last one overlapping the previous.
+;-------------------------------------------------------------------------------------------------------------
+%macro IBC_COPY_ROWS 2 ; mov, bytes
+.w%2:
+    %1            xm0, [srcq]
+    %1            xm1, [srcq + wq - %2]
+    %1         [dstq], xm0
+    %1 [dstq + wq - %2], xm1
+    add          dstq, dst_strideq
+    add          srcq, src_strideq
+    dec            hd
+    jg .w%2
+    RET
+%endmacro
+
+%macro IBC_COPY 1 ; bpc
+cglobal vvc_ibc_copy_%1bpc, 6, 8, 2, dst, dst_stride, src, src_stride, w, h, col, tail
+%if %1 == 16
+    add            wd, wd
+%else
+    mov            wd, wd
+%endif
+    cmp            wd, 32
+    jge .w32
+    cmp            wd, 16
+    jge .w16
+    cmp            wd, 8
+    jge .w8
+    cmp            wd, 4
+    jge .w4
+%if %1 == 8
+    cmp            wd, 2
+    jl .w1
+%endif
+.w2:
+    movzx        cold, word [srcq]
+    movzx       taild, word [srcq + wq - 2]
+    mov        [dstq], colw
+    mov [dstq + wq - 2], tailw
+    add          dstq, dst_strideq
+    add          srcq, src_strideq
+    dec            hd
+    jg .w2
+    RET
+%if %1 == 8
+.w1:
+    movzx        cold, byte [srcq]
+    mov        [dstq], colb
+    add          dstq, dst_strideq
+    add          srcq, src_strideq
+    dec            hd
+    jg .w1
+    RET
+%endif
+.w32:
+    lea         tailq, [wq - 32]
+.w32_loop_y:
+    xor          cold, cold
+.w32_loop_x:
+    movu           m0, [srcq + colq]
+    movu [dstq + colq], m0
+    add          colq, 32
+    cmp          colq, tailq
+    jl .w32_loop_x
+    movu           m0, [srcq + tailq]
+    movu [dstq + tailq], m0
+    add          dstq, dst_strideq
+    add          srcq, src_strideq
+    dec            hd
+    jg .w32_loop_y
+    RET
+IBC_COPY_ROWS movu, 16
+IBC_COPY_ROWS movq, 8
+IBC_COPY_ROWS movd, 4
+%endmacro
+
+INIT_YMM avx2
+PRED_PLANAR 8
+PRED_PLANAR 16
+IBC_COPY 8
+IBC_COPY 16
+
+%endif ; HAVE_AVX2_EXTERNAL
+%endif ; ARCH_X86_64
@@ -0,0 +1,750 @@
+;******************************************************************************
+;* VVC inverse transform SIMD optimizations
+;*
+;* This file is part of FFmpeg.
+;*
+;* FFmpeg is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* FFmpeg is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with FFmpeg; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA 32
+
+; the first 32 columns of the 64-point DCT-II matrix, one row per 32 bytes.
+; row k of the N-point matrix is row k * 64 / N of this one.
+dct2_64x32: db  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64
+            db  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64
+            db  91,  90,  90,  90,  88,  87,  86,  84,  83,  81,  79,  77,  73,  71,  69,  65
+            db  62,  59,  56,  52,  48,  44,  41,  37,  33,  28,  24,  20,  15,  11,   7,   2
+            db  90,  90,  88,  85,  82,  78,  73,  67,  61,  54,  46,  38,  31,  22,  13,   4
+            db  -4, -13, -22, -31, -38, -46, -54, -61, -67, -73, -78, -82, -85, -88, -90, -90
+            db  90,  88,  84,  79,  71,  62,  52,  41,  28,  15,   2, -11, -24, -37, -48, -59
+            db -69, -77, -83, -87, -90, -91, -90, -86, -81, -73, -65, -56, -44, -33, -20,  -7
+            db  90,  87,  80,  70,  57,  43,  25,   9,  -9, -25, -43, -57, -70, -80, -87, -90
+            db -90, -87, -80, -70, -57, -43, -25,  -9,   9,  25,  43,  57,  70,  80,  87,  90
+            db  90,  84,  73,  59,  41,  20,  -2, -24, -44, -62, -77, -86, -90, -90, -83, -71
+            db -56, -37, -15,   7,  28,  48,  65,  79,  87,  91,  88,  81,  69,  52,  33,  11
+            db  90,  82,  67,  46,  22,  -4, -31, -54, -73, -85, -90, -88, -78, -61, -38, -13
+            db  13,  38,  61,  78,  88,  90,  85,  73,  54,  31,   4, -22, -46, -67, -82, -90
+            db  90,  79,  59,  33,   2, -28, -56, -77, -88, -90, -81, -62, -37,  -7,  24,  52
+            db  73,  87,  90,  83,  65,  41,  11, -20, -48, -71, -86, -91, -84, -69, -44, -15
+            db  89,  75,  50,  18, -18, -50, -75, -89, -89, -75, -50, -18,  18,  50,  75,  89
+            db  89,  75,  50,  18, -18, -50, -75, -89, -89, -75, -50, -18,  18,  50,  75,  89
+            db  88,  71,  41,   2, -37, -69, -87, -90, -73, -44,  -7,  33,  65,  86,  90,  77
+            db  48,  11, -28, -62, -84, -90, -79, -52, -15,  24,  59,  83,  91,  81,  56,  20
+            db  88,  67,  31, -13, -54, -82, -90, -78, -46,  -4,  38,  73,  90,  85,  61,  22
+            db -22, -61, -85, -90, -73, -38,   4,  46,  78,  90,  82,  54,  13, -31, -67, -88
+            db  87,  62,  20, -28, -69, -90, -84, -56, -11,  37,  73,  90,  81,  48,   2, -44
+            db -79, -91, -77, -41,   7,  52,  83,  90,  71,  33, -15, -59, -86, -88, -65, -24
+            db  87,  57,   9, -43, -80, -90, -70, -25,  25,  70,  90,  80,  43,  -9, -57, -87
+            db -87, -57,  -9,  43,  80,  90,  70,  25, -25, -70, -90, -80, -43,   9,  57,  87
+            db  86,  52,  -2, -56, -87, -84, -48,   7,  59,  88,  83,  44, -11, -62, -90, -81
+            db -41,  15,  65,  90,  79,  37, -20, -69, -90, -77, -33,  24,  71,  91,  73,  28
+            db  85,  46, -13, -67, -90, -73, -22,  38,  82,  88,  54,  -4, -61, -90, -78, -31
+            db  31,  78,  90,  61,   4, -54, -88, -82, -38,  22,  73,  90,  67,  13, -46, -85
+            db  84,  41, -24, -77, -90, -56,   7,  65,  91,  69,  11, -52, -88, -79, -28,  37
+            db  83,  86,  44, -20, -73, -90, -59,   2,  62,  90,  71,  15, -48, -87, -81, -33
+            db  83,  36, -36, -83, -83, -36,  36,  83,  83,  36, -36, -83, -83, -36,  36,  83
+            db  83,  36, -36, -83, -83, -36,  36,  83,  83,  36, -36, -83, -83, -36,  36,  83
+            db  83,  28, -44, -88, -73, -11,  59,  91,  62,  -7, -71, -90, -48,  24,  81,  84
+            db  33, -41, -87, -77, -15,  56,  90,  65,  -2, -69, -90, -52,  20,  79,  86,  37
+            db  82,  22, -54, -90, -61,  13,  78,  85,  31, -46, -90, -67,   4,  73,  88,  38
+            db -38, -88, -73,  -4,  67,  90,  46, -31, -85, -78, -13,  61,  90,  54, -22, -82
+            db  81,  15, -62, -90, -44,  37,  88,  69,  -7, -77, -84, -24,  56,  91,  52, -28
+            db -86, -73,  -2,  71,  87,  33, -48, -90, -59,  20,  83,  79,  11, -65, -90, -41
+            db  80,   9, -70, -87, -25,  57,  90,  43, -43, -90, -57,  25,  87,  70,  -9, -80
+            db -80,  -9,  70,  87,  25, -57, -90, -43,  43,  90,  57, -25, -87, -70,   9,  80
+            db  79,   2, -77, -81,  -7,  73,  83,  11, -71, -84, -15,  69,  86,  20, -65, -87
+            db -24,  62,  88,  28, -59, -90, -33,  56,  90,  37, -52, -90, -41,  48,  91,  44
+            db  78,  -4, -82, -73,  13,  85,  67, -22, -88, -61,  31,  90,  54, -38, -90, -46
+            db  46,  90,  38, -54, -90, -31,  61,  88,  22, -67, -85, -13,  73,  82,   4, -78
+            db  77, -11, -86, -62,  33,  90,  44, -52, -90, -24,  69,  83,   2, -81, -71,  20
+            db  88,  56, -41, -91, -37,  59,  87,  15, -73, -79,   7,  84,  65, -28, -90, -48
+            db  75, -18, -89, -50,  50,  89,  18, -75, -75,  18,  89,  50, -50, -89, -18,  75
+            db  75, -18, -89, -50,  50,  89,  18, -75, -75,  18,  89,  50, -50, -89, -18,  75
+            db  73, -24, -90, -37,  65,  81, -11, -88, -48,  56,  86,   2, -84, -59,  44,  90
+            db  15, -79, -69,  33,  91,  28, -71, -77,  20,  90,  41, -62, -83,   7,  87,  52
+            db  73, -31, -90, -22,  78,  67, -38, -90, -13,  82,  61, -46, -88,  -4,  85,  54
+            db -54, -85,   4,  88,  46, -61, -82,  13,  90,  38, -67, -78,  22,  90,  31, -73
+            db  71, -37, -90,  -7,  86,  48, -62, -79,  24,  91,  20, -81, -59,  52,  84, -11
+            db -90, -33,  73,  69, -41, -88,  -2,  87,  44, -65, -77,  28,  90,  15, -83, -56
+            db  70, -43, -87,   9,  90,  25, -80, -57,  57,  80, -25, -90,  -9,  87,  43, -70
+            db -70,  43,  87,  -9, -90, -25,  80,  57, -57, -80,  25,  90,   9, -87, -43,  70
+            db  69, -48, -83,  24,  90,   2, -90, -28,  81,  52, -65, -71,  44,  84, -20, -90
+            db  -7,  88,  33, -79, -56,  62,  73, -41, -86,  15,  91,  11, -87, -37,  77,  59
+            db  67, -54, -78,  38,  85, -22, -90,   4,  90,  13, -88, -31,  82,  46, -73, -61
+            db  61,  73, -46, -82,  31,  88, -13, -90,  -4,  90,  22, -85, -38,  78,  54, -67
+            db  65, -59, -71,  52,  77, -44, -81,  37,  84, -28, -87,  20,  90, -11, -90,   2
+            db  91,   7, -90, -15,  88,  24, -86, -33,  83,  41, -79, -48,  73,  56, -69, -62
+            db  64, -64, -64,  64,  64, -64, -64,  64,  64, -64, -64,  64,  64, -64, -64,  64
+            db  64, -64, -64,  64,  64, -64, -64,  64,  64, -64, -64,  64,  64, -64, -64,  64
+            db  62, -69, -56,  73,  48, -79, -41,  83,  33, -86, -24,  88,  15, -90,  -7,  91
+            db  -2, -90,  11,  90, -20, -87,  28,  84, -37, -81,  44,  77, -52, -71,  59,  65
+            db  61, -73, -46,  82,  31, -88, -13,  90,  -4, -90,  22,  85, -38, -78,  54,  67
+            db -67, -54,  78,  38, -85, -22,  90,   4, -90,  13,  88, -31, -82,  46,  73, -61
+            db  59, -77, -37,  87,  11, -91,  15,  86, -41, -73,  62,  56, -79, -33,  88,   7
+            db -90,  20,  84, -44, -71,  65,  52, -81, -28,  90,   2, -90,  24,  83, -48, -69
+            db  57, -80, -25,  90,  -9, -87,  43,  70, -70, -43,  87,   9, -90,  25,  80, -57
+            db -57,  80,  25, -90,   9,  87, -43, -70,  70,  43, -87,  -9,  90, -25, -80,  57
+            db  56, -83, -15,  90, -28, -77,  65,  44, -87,  -2,  88, -41, -69,  73,  33, -90
+            db  11,  84, -52, -59,  81,  20, -91,  24,  79, -62, -48,  86,   7, -90,  37,  71
+            db  54, -85,  -4,  88, -46, -61,  82,  13, -90,  38,  67, -78, -22,  90, -31, -73
+            db  73,  31, -90,  22,  78, -67, -38,  90, -13, -82,  61,  46, -88,   4,  85, -54
+            db  52, -87,   7,  83, -62, -41,  90, -20, -77,  71,  28, -91,  33,  69, -79, -15
+            db  90, -44, -59,  84,   2, -86,  56,  48, -88,  11,  81, -65, -37,  90, -24, -73
+            db  50, -89,  18,  75, -75, -18,  89, -50, -50,  89, -18, -75,  75,  18, -89,  50
+            db  50, -89,  18,  75, -75, -18,  89, -50, -50,  89, -18, -75,  75,  18, -89,  50
+            db  48, -90,  28,  65, -84,   7,  79, -73, -15,  87, -59, -37,  91, -41, -56,  88
+            db -20, -71,  81,   2, -83,  69,  24, -90,  52,  44, -90,  33,  62, -86,  11,  77
+            db  46, -90,  38,  54, -90,  31,  61, -88,  22,  67, -85,  13,  73, -82,   4,  78
+            db -78,  -4,  82, -73, -13,  85, -67, -22,  88, -61, -31,  90, -54, -38,  90, -46
+            db  44, -91,  48,  41, -90,  52,  37, -90,  56,  33, -90,  59,  28, -88,  62,  24
+            db -87,  65,  20, -86,  69,  15, -84,  71,  11, -83,  73,   7, -81,  77,   2, -79
+            db  43, -90,  57,  25, -87,  70,   9, -80,  80,  -9, -70,  87, -25, -57,  90, -43
+            db -43,  90, -57, -25,  87, -70,  -9,  80, -80,   9,  70, -87,  25,  57, -90,  43
+            db  41, -90,  65,  11, -79,  83, -20, -59,  90, -48, -33,  87, -71,  -2,  73, -86
+            db  28,  52, -91,  56,  24, -84,  77,  -7, -69,  88, -37, -44,  90, -62, -15,  81
+            db  38, -88,  73,  -4, -67,  90, -46, -31,  85, -78,  13,  61, -90,  54,  22, -82
+            db  82, -22, -54,  90, -61, -13,  78, -85,  31,  46, -90,  67,   4, -73,  88, -38
+            db  37, -86,  79, -20, -52,  90, -69,   2,  65, -90,  56,  15, -77,  87, -41, -33
+            db  84, -81,  24,  48, -90,  71,  -7, -62,  91, -59, -11,  73, -88,  44,  28, -83
+            db  36, -83,  83, -36, -36,  83, -83,  36,  36, -83,  83, -36, -36,  83, -83,  36
+            db  36, -83,  83, -36, -36,  83, -83,  36,  36, -83,  83, -36, -36,  83, -83,  36
+            db  33, -81,  87, -48, -15,  71, -90,  62,  -2, -59,  90, -73,  20,  44, -86,  83
+            db -37, -28,  79, -88,  52,  11, -69,  91, -65,   7,  56, -90,  77, -24, -41,  84
+            db  31, -78,  90, -61,   4,  54, -88,  82, -38, -22,  73, -90,  67, -13, -46,  85
+            db -85,  46,  13, -67,  90, -73,  22,  38, -82,  88, -54,  -4,  61, -90,  78, -31
+            db  28, -73,  91, -71,  24,  33, -77,  90, -69,  20,  37, -79,  90, -65,  15,  41
+            db -81,  90, -62,  11,  44, -83,  88, -59,   7,  48, -84,  87, -56,   2,  52, -86
+            db  25, -70,  90, -80,  43,   9, -57,  87, -87,  57,  -9, -43,  80, -90,  70, -25
+            db -25,  70, -90,  80, -43,  -9,  57, -87,  87, -57,   9,  43, -80,  90, -70,  25
+            db  24, -65,  88, -86,  59, -15, -33,  71, -90,  83, -52,   7,  41, -77,  91, -79
+            db  44,   2, -48,  81, -90,  73, -37, -11,  56, -84,  90, -69,  28,  20, -62,  87
+            db  22, -61,  85, -90,  73, -38,  -4,  46, -78,  90, -82,  54, -13, -31,  67, -88
+            db  88, -67,  31,  13, -54,  82, -90,  78, -46,   4,  38, -73,  90, -85,  61, -22
+            db  20, -56,  81, -91,  83, -59,  24,  15, -52,  79, -90,  84, -62,  28,  11, -48
+            db  77, -90,  86, -65,  33,   7, -44,  73, -90,  87, -69,  37,   2, -41,  71, -88
+            db  18, -50,  75, -89,  89, -75,  50, -18, -18,  50, -75,  89, -89,  75, -50,  18
+            db  18, -50,  75, -89,  89, -75,  50, -18, -18,  50, -75,  89, -89,  75, -50,  18
+            db  15, -44,  69, -84,  91, -86,  71, -48,  20,  11, -41,  65, -83,  90, -87,  73
+            db -52,  24,   7, -37,  62, -81,  90, -88,  77, -56,  28,   2, -33,  59, -79,  90
+            db  13, -38,  61, -78,  88, -90,  85, -73,  54, -31,   4,  22, -46,  67, -82,  90
+            db -90,  82, -67,  46, -22,  -4,  31, -54,  73, -85,  90, -88,  78, -61,  38, -13
+            db  11, -33,  52, -69,  81, -88,  91, -87,  79, -65,  48, -28,   7,  15, -37,  56
+            db -71,  83, -90,  90, -86,  77, -62,  44, -24,   2,  20, -41,  59, -73,  84, -90
+            db   9, -25,  43, -57,  70, -80,  87, -90,  90, -87,  80, -70,  57, -43,  25,  -9
+            db  -9,  25, -43,  57, -70,  80, -87,  90, -90,  87, -80,  70, -57,  43, -25,   9
+            db   7, -20,  33, -44,  56, -65,  73, -81,  86, -90,  91, -90,  87, -83,  77, -69
+            db  59, -48,  37, -24,  11,   2, -15,  28, -41,  52, -62,  71, -79,  84, -88,  90
+            db   4, -13,  22, -31,  38, -46,  54, -61,  67, -73,  78, -82,  85, -88,  90, -90
+            db  90, -90,  88, -85,  82, -78,  73, -67,  61, -54,  46, -38,  31, -22,  13,  -4
+            db   2,  -7,  11, -15,  20, -24,  28, -33,  37, -41,  44, -48,  52, -56,  59, -62
+            db  65, -69,  71, -73,  77, -79,  81, -83,  84, -86,  87, -88,  90, -90,  90, -91
+
+REVERSE_PERM: dd 7, 6, 5, 4, 3, 2, 1, 0
+
+pd_64: times 8 dd 64
+pd_8:  times 8 dd 8
+pd_0to7: dd 0, 1, 2, 3, 4, 5, 6, 7
+
+cextern vvc_dst7_4x4
+cextern vvc_dst7_8x8
+cextern vvc_dst7_16x16
+cextern vvc_dst7_32x32
+cextern vvc_dct8_4x4
+cextern vvc_dct8_8x8
+cextern vvc_dct8_16x16
+cextern vvc_dct8_32x32
+
+SECTION .text
+
+%define DCT2_ROW_SIZE 32
+
+; store m%1 to four (xmm) or eight (ymm) rows of coeffs
+; uses dstq, strideq, stride3q
+%macro STORE_STRIDED 1
+%if mmsize == 32
+    vextracti128           xm15, m%1, 1
+%endif
+    movd                  [dstq], xm%1
+    pextrd      [dstq + strideq], xm%1, 1
+    pextrd  [dstq + 2 * strideq], xm%1, 2
+    pextrd     [dstq + stride3q], xm%1, 3
+    lea                     dstq, [dstq + 4 * strideq]
+%if mmsize == 32
+    movd                  [dstq], xm15
+    pextrd      [dstq + strideq], xm15, 1
+    pextrd  [dstq + 2 * strideq], xm15, 2
+    pextrd     [dstq + stride3q], xm15, 3
+    lea                     dstq, [dstq + 4 * strideq]
+%endif
+%endmacro
+
+%if ARCH_X86_64
+%if HAVE_AVX2_EXTERNAL
+
+; The even rows of the N-point DCT-II matrix are symmetric and the odd rows are
+; antisymmetric, so only the first N/2 outputs are accumulated for each half:
+; out[i] = E[i] + O[i], out[N - 1 - i] = E[i] - O[i].
+; Only the first nz inputs are non-zero, so the loop stops there.
+;
+; E in m0-m3, O in m4-m7
+%macro INV_DCT2 1 ; size
+%assign %%regs (%1 * 2) / mmsize
+%assign %%step 2 * (64 / %1) * DCT2_ROW_SIZE
+%assign %%odd (64 / %1) * DCT2_ROW_SIZE
+
+; void ff_vvc_inv_dct2_%1(int *coeffs, ptrdiff_t stride, size_t nz)
+cglobal vvc_inv_dct2_%1, 3, 5, 16, coeffs, stride, nz, tab, src
+    lea                     tabq, [dct2_64x32]
+    shl                  strideq, 2
+    mov                     srcq, coeffsq
+%if %1 == 64
+    ; the 32 last inputs of the 64-point transform are always zero
+    mov                     tabd, 32
+    cmp                      nzq, tabq
+    cmova                    nzq, tabq
+    lea                     tabq, [dct2_64x32]
+%endif
+    inc                      nzq
+    shr                      nzq, 1
+%assign %%i 0
+%rep %%regs
+%assign %%j %%i + 4
+    pxor             m %+ %%i, m %+ %%i
+    pxor             m %+ %%j, m %+ %%j
+%assign %%i %%i + 1
+%endrep
+
+.loop:
+    vpbroadcastd              m8, [srcq]
+    vpbroadcastd              m9, [srcq + strideq]
+%assign %%i 0
+%rep %%regs
+%assign %%j %%i + 4
+    pmovsxbd                 m10, [tabq + %%i * mmsize / 4]
+    pmovsxbd                 m11, [tabq + %%odd + %%i * mmsize / 4]
+    pmulld                   m10, m8
+    pmulld                   m11, m9
+    paddd             m %+ %%i, m10
+    paddd             m %+ %%j, m11
+%assign %%i %%i + 1
+%endrep
+    lea                     srcq, [srcq + 2 * strideq]
+    add                     tabq, %%step
+    dec                      nzq
+    jg .loop
+
+%if mmsize == 32
+    movu                     m12, [REVERSE_PERM]
+%endif
+%assign %%i 0
+%rep %%regs
+%assign %%j %%i + 4
+    psubd                    m10, m %+ %%i, m %+ %%j
+    paddd             m %+ %%i, m %+ %%j
+%if mmsize == 32
+    vpermd            m %+ %%j, m12, m10
+%else
+    pshufd            m %+ %%j, m10, q0123
+%endif
+%assign %%i %%i + 1
+%endrep
+
+    cmp                  strideq, 4
+    jne .strided
+%assign %%i 0
+%rep %%regs
+%assign %%j %%i + 4
+    movu    [coeffsq + %%i * mmsize], m %+ %%i
+    movu    [coeffsq + (2 * %%regs - 1 - %%i) * mmsize], m %+ %%j
+%assign %%i %%i + 1
+%endrep
+    RET
+
+.strided:
+    DEFINE_ARGS dst, stride, nz, tab, stride3
+    lea                 stride3q, [3 * strideq]
+%assign %%i 0
+%rep %%regs
+    STORE_STRIDED           %%i
+%assign %%i %%i + 1
+%endrep
+%assign %%i %%regs - 1
+%rep %%regs
+%assign %%j %%i + 4
+    STORE_STRIDED           %%j
+%assign %%i %%i - 1
+%endrep
+    RET
+%endmacro
+
+INIT_XMM avx2
+INV_DCT2  8
+INIT_YMM avx2
+INV_DCT2 16
+INV_DCT2 32
+INV_DCT2 64
+%endif
+
+; DST-VII and DCT-VIII have no usable symmetry, so every output is accumulated:
+; out[i] = sum(coeffs[j * stride] * matrix[j][i]), j < nz.
+;
+; out in m0-m7
+%macro INV_MATRIX 2 ; type, size
+%assign %%regs (%2 * 4) / mmsize
+
+; void ff_vvc_inv_%1_%2(int *coeffs, ptrdiff_t stride, size_t nz)
+cglobal vvc_inv_%1_%2, 3, 5, 16, coeffs, stride, nz, tab, src
+    lea                     tabq, [vvc_%1_%2x%2]
+    shl                  strideq, 2
+    mov                     srcq, coeffsq
+%assign %%i 0
+%rep %%regs
+    pxor             m %+ %%i, m %+ %%i
+%assign %%i %%i + 1
+%endrep
+
+.loop:
+%if cpuflag(avx2)
+    vpbroadcastd              m8, [srcq]
+%else
+    movd                      m8, [srcq]
+    pshufd                    m8, m8, 0
+%endif
+%assign %%i 0
+%rep %%regs
+    pmovsxbd                  m9, [tabq + %%i * mmsize / 4]
+    pmulld                    m9, m8
+    paddd             m %+ %%i, m9
+%assign %%i %%i + 1
+%endrep
+    add                     srcq, strideq
+    add                     tabq, %2
+    dec                      nzq
+    jg .loop
+
+    cmp                  strideq, 4
+    jne .strided
+%assign %%i 0
+%rep %%regs
+    movu    [coeffsq + %%i * mmsize], m %+ %%i
+%assign %%i %%i + 1
+%endrep
+    RET
+
+.strided:
+    DEFINE_ARGS dst, stride, nz, tab, stride3
+    lea                 stride3q, [3 * strideq]
+%assign %%i 0
+%rep %%regs
+    STORE_STRIDED           %%i
+%assign %%i %%i + 1
+%endrep
+    RET
+%endmacro
+
+%macro INV_MATRIX_FUNCS 1 ; type
+%if mmsize == 16
+INV_MATRIX %1,  4
+%endif
+INV_MATRIX %1,  8
+INV_MATRIX %1, 16
+INV_MATRIX %1, 32
+%endmacro
+
+INIT_XMM sse4
+INV_MATRIX_FUNCS dst7
+INV_MATRIX_FUNCS dct8
+
+%if HAVE_AVX2_EXTERNAL
+INIT_XMM avx2
+INV_MATRIX dst7, 4
+INV_MATRIX dct8, 4
+INIT_YMM avx2
+INV_MATRIX_FUNCS dst7
+INV_MATRIX_FUNCS dct8
+%endif
+
+; v[j] = clip((sum(u[i] * tr_mat[i][j]) + 64) >> 7), i < no_zero_size
+;
+; v in m0-m5
+%macro INV_LFNST 1 ; n_tr_s
+%assign %%regs (%1 * 4) / mmsize
+
+; void ff_vvc_inv_lfnst_%1(int *v, const int *u, intptr_t no_zero_size,
+;     const int8_t *tr_mat, intptr_t max)
+cglobal vvc_inv_lfnst_%1, 5, 5, 12, v, u, nz, tr_mat, max
+%assign %%i 0
+%rep %%regs
+    pxor             m %+ %%i, m %+ %%i
+%assign %%i %%i + 1
+%endrep
+
+.loop:
+    vpbroadcastd              m8, [uq]
+%assign %%i 0
+%rep %%regs
+    pmovsxbd                  m9, [tr_matq + %%i * mmsize / 4]
+    pmulld                    m9, m8
+    paddd             m %+ %%i, m9
+%assign %%i %%i + 1
+%endrep
+    add                       uq, 4
+    add                  tr_matq, %1
+    dec                      nzq
+    jg .loop
+
+    movd                    xm10, maxd
+    vpbroadcastd             m10, xm10
+    pcmpeqd                  m11, m11
+    pxor                     m11, m10                  ; -max - 1
+    mova                      m9, [pd_64]
+%assign %%i 0
+%rep %%regs
+    paddd             m %+ %%i, m9
+    psrad             m %+ %%i, 7
+    pminsd            m %+ %%i, m10
+    pmaxsd            m %+ %%i, m11
+    movu        [vq + %%i * mmsize], m %+ %%i
+%assign %%i %%i + 1
+%endrep
+    RET
+%endmacro
+
+%if HAVE_AVX2_EXTERNAL
+INIT_YMM avx2
+INV_LFNST 16
+INV_LFNST 48
+%endif
+
+; r = (res * c_sign) >> shift, c_sign is -1 or 1
+; %1: residual register, %2: c_sign register, %3: shift register
+%macro JOINT_RES 3
+    psignd                   %1, %2
+    psrad                    %1, %3
+%endmacro
+
+; widths below 8 are done one row at a time in xmm registers
+; %1: bpc, %2: joint, %3: width
+%macro ADD_RES_SMALL 3
+.w%3:
+%if %3 == 4
+    pmovzx%{1}bpc_d          xm0, [dstq]
+    movu                     xm1, [resq]
+%elif %3 == 2
+%if %1 == 8
+    movzx                     xd, word [dstq]
+    movd                     xm0, xd
+    pmovzxbd                 xm0, xm0
+%else
+    movd                     xm0, [dstq]
+    pmovzxwd                 xm0, xm0
+%endif
+    movq                     xm1, [resq]
+%else
+%if %1 == 8
+    movzx                     xd, byte [dstq]
+%else
+    movzx                     xd, word [dstq]
+%endif
+    movd                     xm0, xd
+    movd                     xm1, [resq]
+%endif
+%if %2
+    JOINT_RES                xm1, xm6, xm7
+%endif
+    paddd                    xm0, xm1
+%if %1 == 8
+    packssdw                 xm0, xm0
+    packuswb                 xm0, xm0
+%if %3 == 4
+    movd                  [dstq], xm0
+%elif %3 == 2
+    pextrw                [dstq], xm0, 0
+%else
+    pextrb                [dstq], xm0, 0
+%endif
+%else
+    packusdw                 xm0, xm0
+    pminuw                   xm0, xm5
+%if %3 == 4
+    movq                  [dstq], xm0
+%elif %3 == 2
+    movd                  [dstq], xm0
+%else
+    pextrw                [dstq], xm0, 0
+%endif
+%endif
+    add                     resq, 4 * %3
+    add                     dstq, strideq
+    dec                       hd
+    jg .w%3
+    RET
+%endmacro
+
+%define pmovzx8bpc_d  pmovzxbd
+%define pmovzx16bpc_d pmovzxwd
+; the 8-bit path must keep negative sums negative for packuswb
+%define pack8bpc_dw   packssdw
+%define pack16bpc_dw  packusdw
+
+; %1: bpc, %2: joint
+%macro ADD_RESIDUAL 2
+%if %2
+; void ff_vvc_add_residual_joint_%1bpc(uint8_t *dst, const int *res, intptr_t width, intptr_t height,
+;     ptrdiff_t stride, intptr_t c_sign, intptr_t shift, intptr_t pixel_max)
+cglobal vvc_add_residual_joint_%1bpc, 8, 9, 8, dst, res, w, h, stride, c_sign, shift, pixel_max, x
+    movd                     xm6, c_signd
+    vpbroadcastd              m6, xm6
+    movd                     xm7, shiftd
+%else
+; void ff_vvc_add_residual_%1bpc(uint8_t *dst, const int *res, intptr_t width, intptr_t height,
+;     ptrdiff_t stride, intptr_t pixel_max)
+cglobal vvc_add_residual_%1bpc, 6, 7, 6, dst, res, w, h, stride, pixel_max, x
+%endif
+%if %1 == 16
+    movd                     xm5, pixel_maxd
+    vpbroadcastw              m5, xm5
+%endif
+    cmp                       wd, 4
+    jg .w8
+    je .w4
+    cmp                       wd, 2
+    je .w2
+    ADD_RES_SMALL        %1, %2, 1
+    ADD_RES_SMALL        %1, %2, 2
+    ADD_RES_SMALL        %1, %2, 4
+
+.w8:
+    xor                       xq, xq
+.w8_loop:
+    pmovzx%{1}bpc_d           m0, [dstq + xq * (%1 / 8)]
+    movu                      m1, [resq + 4 * xq]
+%if %2
+    JOINT_RES                 m1, m6, xm7
+%endif
+    paddd                     m0, m1
+    pack%{1}bpc_dw            m0, m0
+    vpermq                    m0, m0, q3120
+%if %1 == 8
+    packuswb                 xm0, xm0
+    movq       [dstq + xq], xm0
+%else
+    pminuw                   xm0, xm5
+    movu   [dstq + 2 * xq], xm0
+%endif
+    add                       xq, 8
+    cmp                       xq, wq
+    jl .w8_loop
+    lea                     resq, [resq + 4 * wq]
+    add                     dstq, strideq
+    dec                       hd
+    jg .w8
+    RET
+%endmacro
+
+%if HAVE_AVX2_EXTERNAL
+INIT_YMM avx2
+; void ff_vvc_pred_residual_joint(int *buf, intptr_t width, intptr_t height, intptr_t c_sign, intptr_t shift)
+; width * height is a multiple of 4
+cglobal vvc_pred_residual_joint, 5, 5, 8, buf, w, h, c_sign, shift
+    imul                      wd, hd
+    movd                     xm6, c_signd
+    vpbroadcastd              m6, xm6
+    movd                     xm7, shiftd
+    sub                       wd, 8
+    jl .w4
+.loop:
+    movu                      m0, [bufq]
+    JOINT_RES                 m0, m6, xm7
+    movu                  [bufq], m0
+    add                     bufq, 32
+    sub                       wd, 8
+    jge .loop
+.w4:
+    add                       wd, 8
+    jz .end
+    movu                     xm0, [bufq]
+    JOINT_RES                xm0, xm6, xm7
+    movu                  [bufq], xm0
+.end:
+    RET
+
+ADD_RESIDUAL  8, 0
+ADD_RESIDUAL  8, 1
+ADD_RESIDUAL 16, 0
+ADD_RESIDUAL 16, 1
+
+; void ff_vvc_dequant(int *coeffs, ptrdiff_t stride, intptr_t width, intptr_t height,
+;     const uint8_t *scale_m, intptr_t scale, intptr_t bd_shift, intptr_t bd_offset, intptr_t max)
+; coeffs * scale_m is done in 32 bits, which holds for any coefficient the residual coding can produce,
+; the product with scale and the rounding shift are done in 64 bits
+cglobal vvc_dequant, 9, 10, 16, coeffs, stride, w, h, scale_m, scale, shift, offset, max, x
+    shl                  strideq, 2
+    movd                     xm8, scaled
+    vpbroadcastd              m8, xm8
+    movq                     xm9, offsetq
+    vpbroadcastq              m9, xm9
+    movd                    xm10, shiftd
+    movd                    xm11, maxd
+    vpbroadcastd             m11, xm11
+    pcmpeqd                  m12, m12
+    pxor                     m12, m11                  ; -max - 1
+    movd                    xm14, wd
+    vpbroadcastd             m14, xm14
+    mova                     m13, [pd_0to7]
+    mova                     m15, [pd_8]
+.loop_y:
+    xor                       xq, xq
+    mova                      m7, m13
+.loop_x:
+    pcmpgtd                   m6, m14, m7              ; lanes left of width
+    vpmaskmovd                m0, m6, [coeffsq + 4 * xq]
+    pmovzxbd                  m1, [scale_mq + xq]
+    pmulld                    m0, m1
+    psrlq                     m1, m0, 32
+    pmuldq                    m0, m8
+    pmuldq                    m1, m8
+    paddq                     m0, m9
+    paddq                     m1, m9
+    psrlq                     m0, xm10
+    psrlq                     m1, xm10
+    psllq                     m1, 32
+    vpblendd                  m0, m0, m1, 0xaa
+    pminsd                    m0, m11
+    pmaxsd                    m0, m12
+    vpmaskmovd [coeffsq + 4 * xq], m6, m0
+    paddd                     m7, m15
+    add                       xq, 8
+    cmp                       xq, wq
+    jl .loop_x
+    add                  coeffsq, strideq
+    add                 scale_mq, wq
+    dec                       hd
+    jg .loop_y
+    RET
+
+; BDPCM_H_LOAD(register prefix), load 4 columns of 4 (xmm) or 8 (ymm) rows
+%macro BDPCM_H_LOAD 1
+    movu                   xm0, [srcq]
+    movu                   xm1, [srcq + wq]
+    movu                   xm2, [srcq + 2 * wq]
+    movu                   xm3, [srcq + stride3q]
+%ifidn %1, m
+    lea                      yq, [srcq + 4 * wq]
+    vinserti128              m0, m0, [yq], 1
+    vinserti128              m1, m1, [yq + wq], 1
+    vinserti128              m2, m2, [yq + 2 * wq], 1
+    vinserti128              m3, m3, [yq + stride3q], 1
+%endif
+%endmacro
+
+%macro BDPCM_H_STORE 1
+    movu                 [srcq], xm0
+    movu            [srcq + wq], xm1
+    movu        [srcq + 2 * wq], xm2
+    movu       [srcq + stride3q], xm3
+%ifidn %1, m
+    vextracti128           [yq], m0, 1
+    vextracti128      [yq + wq], m1, 1
+    vextracti128  [yq + 2 * wq], m2, 1
+    vextracti128 [yq + stride3q], m3, 1
+%endif
+%endmacro
+
+; BDPCM_H(register prefix, rows), the clipping at each step keeps it from being a prefix sum,
+; so the rows go to the lanes and the columns are added one after the other
+%macro BDPCM_H 2
+.h%2:
+    pxor                   %{1}4, %{1}4                ; left column
+    xor                    colq, colq
+.h%2_x:
+    lea                    srcq, [coeffsq + colq]
+    BDPCM_H_LOAD             %1
+    TRANSPOSE4x4D             0, 1, 2, 3, 5
+    paddd                  %{1}0, %{1}4
+    CLIPD                  %{1}0, %{1}7, %{1}6
+    paddd                  %{1}1, %{1}0
+    CLIPD                  %{1}1, %{1}7, %{1}6
+    paddd                  %{1}2, %{1}1
+    CLIPD                  %{1}2, %{1}7, %{1}6
+    paddd                  %{1}3, %{1}2
+    CLIPD                  %{1}3, %{1}7, %{1}6
+    mova                   %{1}4, %{1}3
+    TRANSPOSE4x4D             0, 1, 2, 3, 5
+    BDPCM_H_STORE            %1
+    add                    colq, 16
+    cmp                    colq, wq
+    jl .h%2_x
+    lea                 coeffsq, [coeffsq + %2 * wq]
+    sub                      hd, %2
+    jg .h%2
+    RET
+%endmacro
+
+; void ff_vvc_transform_bdpcm(int *coeffs, intptr_t width, intptr_t height, intptr_t vertical, intptr_t max)
+; width and height are at least 4, the first column is clipped as well,
+; which leaves any coefficient the residual coding can produce unchanged
+cglobal vvc_transform_bdpcm, 5, 8, 8, coeffs, w, h, vertical, max, col, y, src
+    movd                    xm6, maxd
+    vpbroadcastd             m6, xm6
+    pcmpeqd                  m7, m7
+    pxor                     m7, m6                    ; -max - 1
+    shl                      wq, 2
+    test              verticald, verticald
+    jz .horizontal
+
+    dec                      hd
+    cmp                      wd, 16
+    je .v4
+    xor                    colq, colq
+.v8:
+    lea                    srcq, [coeffsq + colq]
+    movu                     m0, [srcq]
+    mov                      yd, hd
+.v8_y:
+    add                    srcq, wq
+    paddd                    m0, [srcq]
+    CLIPD                    m0, m7, m6
+    movu                 [srcq], m0
+    dec                      yd
+    jg .v8_y
+    add                    colq, 32
+    cmp                    colq, wq
+    jl .v8
+    RET
+
+.v4:
+    movu                    xm0, [coeffsq]
+.v4_y:
+    add                 coeffsq, 16
+    paddd                   xm0, [coeffsq]
+    CLIPD                   xm0, xm7, xm6
+    movu              [coeffsq], xm0
+    dec                      hd
+    jg .v4_y
+    RET
+
+.horizontal:
+    DEFINE_ARGS coeffs, w, h, stride3, max, col, y, src
+    lea                stride3q, [3 * wq]
+    cmp                      hd, 4
+    je .h4
+    BDPCM_H                  m, 8
+    BDPCM_H                 xm, 4
+%endif
+
+%endif
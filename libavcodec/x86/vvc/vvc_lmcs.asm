@@ -0,0 +1,145 @@
+; /*
+; * Provide SIMD LMCS functions for VVC decoding
+; *
+; * This file is part of FFmpeg.
+; *
+; * FFmpeg is free software; you can redistribute it and/or
+; * modify it under the terms of the GNU Lesser General Public
+; * License as published by the Free Software Foundation; either
+; * version 2.1 of the License, or (at your option) any later version.
+; *
+; * FFmpeg is distributed in the hope that it will be useful,
+; * but WITHOUT ANY WARRANTY; without even the implied warranty of
+; * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+; * Lesser General Public License for more details.
+; *
+; * You should have received a copy of the GNU Lesser General Public
+; * License along with FFmpeg; if not, write to the Free Software
+; * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+; */
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION .text
+
+%if ARCH_X86_64
+%if HAVE_AVX2_EXTERNAL
+
+;%1: bpc, %2: register prefix, %3: index, %4: mask, %5: dst, %6: offset in samples
+; map the samples at col through the lut, a dword is gathered per sample and masked to the sample size,
+; so up to 2 bytes past the entry are read, which stays inside VVCLMCS for both luts
+%macro LMCS_LUT 6
+%if %1 == 8
+    vpmovzxbd     %{2}%3, [dstq + colq + %6]
+%else
+    vpmovzxwd     %{2}%3, [dstq + colq * 2 + %6 * 2]
+%endif
+    pcmpeqd       %{2}%4, %{2}%4
+    vpgatherdd    %{2}%5, [lutq + %{2}%3 * BYTES], %{2}%4
+    pand          %{2}%5, %{2}6
+%endmacro
+
+;void ff_vvc_lmcs_filter_luma_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride,
+;    int width, int height, const void *lut);
+%macro VVC_LMCS_FILTER_LUMA_AVX2 1 ; bpc
+cglobal vvc_lmcs_filter_luma_%1bpc, 5, 7, 7, dst, dst_stride, w, h, lut, col, left
+%assign BYTES %1 / 8
+    pcmpeqd              m6, m6
+    psrld                m6, 32 - %1                ; sample mask
+.loop_y:
+    xor                cold, cold
+    mov               leftd, wd
+    cmp               leftd, 16
+    jl .w8
+.loop_x:
+    ; two independent gathers to hide their latency
+    LMCS_LUT            %1, m, 0, 1, 2, 0
+    LMCS_LUT            %1, m, 3, 4, 5, 8
+    packusdw             m2, m5
+    vpermq               m2, m2, q3120
+%if %1 == 8
+    vextracti128        xm5, m2, 1
+    packuswb            xm2, xm5
+    movu        [dstq + colq], xm2
+%else
+    movu    [dstq + colq * 2], m2
+%endif
+    add                cold, 16
+    sub               leftd, 16
+    cmp               leftd, 16
+    jge .loop_x
+.w8:
+    cmp               leftd, 8
+    jl .w4
+    LMCS_LUT            %1, m, 0, 1, 2, 0
+    packusdw             m2, m2
+    vpermq               m2, m2, q2020
+%if %1 == 8
+    packuswb            xm2, xm2
+    movq        [dstq + colq], xm2
+%else
+    movu    [dstq + colq * 2], xm2
+%endif
+    add                cold, 8
+    sub               leftd, 8
+.w4:
+    test              leftd, leftd
+    jz .next_row
+    LMCS_LUT            %1, xm, 0, 1, 2, 0
+    packusdw            xm2, xm2
+%if %1 == 8
+    packuswb            xm2, xm2
+    movd        [dstq + colq], xm2
+%else
+    movq    [dstq + colq * 2], xm2
+%endif
+.next_row:
+    add                dstq, dst_strideq
+    dec                  hd
+    jg .loop_y
+    RET
+%endmacro
+
+%macro LMCS_SCALE_CHROMA 1 ; register prefix
+    movu              %{1}0, [coeffq]
+    pminsd            %{1}0, %{1}2
+    pmaxsd            %{1}0, %{1}3
+    pabsd             %{1}1, %{1}0
+    pmulld            %{1}1, %{1}4
+    paddd             %{1}1, %{1}5
+    psrad             %{1}1, 11
+    psignd            %{1}1, %{1}0
+    movu           [dstq], %{1}1
+%endmacro
+
+;void ff_vvc_lmcs_scale_chroma_avx2(int *dst, const int *coeff, intptr_t size,
+;    intptr_t chroma_scale, intptr_t pixel_max);
+INIT_YMM avx2
+cglobal vvc_lmcs_scale_chroma, 5, 5, 6, dst, coeff, size, scale, pixel_max
+    movd                xm4, scaled
+    vpbroadcastd         m4, xm4
+    movd                xm2, pixel_maxd
+    vpbroadcastd         m2, xm2                    ; (1 << bit_depth) - 1
+    pcmpeqd              m3, m3
+    pxor                 m3, m2                     ; -(1 << bit_depth)
+    pcmpeqd              m5, m5
+    psrld                m5, 31
+    pslld                m5, 10                     ; 1 << 10
+    cmp               sized, 8
+    jl .size4
+.loop:
+    LMCS_SCALE_CHROMA    m
+    add              coeffq, 32
+    add                dstq, 32
+    sub               sized, 8
+    jg .loop
+    RET
+.size4:
+    LMCS_SCALE_CHROMA    xm
+    RET
+
+VVC_LMCS_FILTER_LUMA_AVX2 8
+VVC_LMCS_FILTER_LUMA_AVX2 16
+
+%endif
+%endif
@@ -33,13 +33,19 @@ SECTION_RODATA 32
 
 %if ARCH_X86_64
 
-%if HAVE_AVX2_EXTERNAL
+pw_0     times 2 dw     0
+pw_1     times 2 dw     1
+pw_4     times 2 dw     4
+pw_8     times 2 dw     8
+pw_12    times 2 dw    12
+pw_16    times 2 dw    16
+pw_255   times 2 dw   255
+pw_256   times 2 dw   256
+pw_2048  times 2 dw  2048
+pw_8192  times 2 dw  8192
+pw_16384 times 2 dw 16384
 
-pw_0    times 2 dw   0
-pw_1    times 2 dw   1
-pw_4    times 2 dw   4
-pw_12   times 2 dw  12
-pw_256  times 2 dw 256
+gpm_reverse_shuf db 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
 
 %macro AVG_JMP_TABLE 3-*
     %xdefine %1_%2_%3_table (%%table - 2*%4)
@@ -52,6 +58,10 @@ pw_256  times 2 dw 256
     %endrep
 %endmacro
 
+AVG_JMP_TABLE    avg,  8, sse4,                2, 4, 8, 16, 32, 64, 128
+AVG_JMP_TABLE    avg, 16, sse4,                2, 4, 8, 16, 32, 64, 128
+AVG_JMP_TABLE  w_avg,  8, sse4,                2, 4, 8, 16, 32, 64, 128
+AVG_JMP_TABLE  w_avg, 16, sse4,                2, 4, 8, 16, 32, 64, 128
 AVG_JMP_TABLE    avg,  8, avx2,                2, 4, 8, 16, 32, 64, 128
 AVG_JMP_TABLE    avg, 16, avx2,                2, 4, 8, 16, 32, 64, 128
 AVG_JMP_TABLE  w_avg,  8, avx2,                2, 4, 8, 16, 32, 64, 128
@@ -59,7 +69,7 @@ AVG_JMP_TABLE  w_avg, 16, avx2,                2, 4, 8, 16, 32, 64, 128
 
 SECTION .text
 
-%macro AVG_W16_FN 3 ; bpc, op, count
+%macro AVG_W16_FN 3 ; bpc, op, count of registers per line
     %assign %%i 0
     %rep %3
         %define off %%i
@@ -99,32 +109,36 @@ SECTION .text
     AVG_LOOP_END        .w4
 
 .w8:
+%if mmsize == 32
     vinserti128         m0, m0, [src0q], 0
     vinserti128         m0, m0, [src0q + AVG_SRC_STRIDE], 1
     vinserti128         m1, m1, [src1q], 0
     vinserti128         m1, m1, [src1q + AVG_SRC_STRIDE], 1
     %2
     AVG_SAVE_W8         %1
+%else
+    AVG_W16_FN          %1, %2, 1
+%endif
 
     AVG_LOOP_END       .w8
 
 .w16:
-    AVG_W16_FN          %1, %2, 1
+    AVG_W16_FN          %1, %2, 32 / mmsize
 
     AVG_LOOP_END       .w16
 
 .w32:
-    AVG_W16_FN          %1, %2, 2
+    AVG_W16_FN          %1, %2, 64 / mmsize
 
     AVG_LOOP_END       .w32
 
 .w64:
-    AVG_W16_FN          %1, %2, 4
+    AVG_W16_FN          %1, %2, 128 / mmsize
 
     AVG_LOOP_END       .w64
 
 .w128:
-    AVG_W16_FN          %1, %2, 8
+    AVG_W16_FN          %1, %2, 256 / mmsize
 
     AVG_LOOP_END       .w128
 
@@ -154,8 +168,8 @@ SECTION .text
 %endmacro
 
 %macro AVG_LOAD_W16 2  ; line, offset
-    movu               m0, [src0q + %1 * AVG_SRC_STRIDE + %2 * 32]
-    movu               m1, [src1q + %1 * AVG_SRC_STRIDE + %2 * 32]
+    movu               m0, [src0q + %1 * AVG_SRC_STRIDE + %2 * mmsize]
+    movu               m1, [src1q + %1 * AVG_SRC_STRIDE + %2 * mmsize]
 %endmacro
 
 %macro AVG_SAVE_W2 1 ;bpc
@@ -194,7 +208,10 @@ SECTION .text
 
 %macro AVG_SAVE_W16 3 ; bpc, line, offset
     %if %1 == 16
-        movu               [dstq + %2 * strideq + %3 * 32], m0
+        movu               [dstq + %2 * strideq + %3 * mmsize], m0
+    %elif mmsize == 16
+        packuswb                                        m0, m0
+        movq                [dstq + %2 * strideq + %3 * 8], m0
     %else
         packuswb                                        m0, m0
         vpermq                                          m0, m0, 1000b
@@ -214,24 +231,25 @@ SECTION .text
 
 %define AVG_SRC_STRIDE MAX_PB_SIZE*2
 
-;void ff_vvc_avg_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride,
+;void ff_vvc_avg_%1bpc_{sse4,avx2}(uint8_t *dst, ptrdiff_t dst_stride,
 ;   const int16_t *src0, const int16_t *src1, intptr_t width, intptr_t height, intptr_t pixel_max);
-%macro VVC_AVG_AVX2 1
+%macro VVC_AVG 1
 cglobal vvc_avg_%1bpc, 4, 7, 5, dst, stride, src0, src1, w, h, bd
     movifnidn            hd, hm
 
     pxor                 m3, m3             ; pixel min
-    vpbroadcastw         m4, bdm            ; pixel max
-
     movifnidn           bdd, bdm
+    movd                xm4, bdd
+    SPLATW               m4, xm4            ; pixel max
+
     inc                 bdd
     tzcnt               bdd, bdd            ; bit depth
 
     sub                 bdd, 8
     movd                xm0, bdd
-    vpbroadcastd         m1, [pw_4]
+    VPBROADCASTD         m1, [pw_4]
     pminuw               m0, m1
-    vpbroadcastd         m2, [pw_256]
+    VPBROADCASTD         m2, [pw_256]
     psllw                m2, xm0                ; shift
 
     lea                  r6, [avg_%1 %+ SUFFIX %+ _table]
@@ -241,10 +259,10 @@ cglobal vvc_avg_%1bpc, 4, 7, 5, dst, stride, src0, src1, w, h, bd
     AVG_FN               %1, AVG
 %endmacro
 
-;void ff_vvc_w_avg_%1bpc_avx(uint8_t *dst, ptrdiff_t dst_stride,
+;void ff_vvc_w_avg_%1bpc_{sse4,avx2}(uint8_t *dst, ptrdiff_t dst_stride,
 ;    const int16_t *src0, const int16_t *src1, intptr_t width, intptr_t height,
 ;    intptr_t denom, intptr_t w0, intptr_t w1,  intptr_t o0, intptr_t o1, intptr_t pixel_max);
-%macro VVC_W_AVG_AVX2 1
+%macro VVC_W_AVG 1
 cglobal vvc_w_avg_%1bpc, 4, 8, 8, dst, stride, src0, src1, w, h, t0, t1
 
     movifnidn            hd, hm
@@ -253,10 +271,11 @@ cglobal vvc_w_avg_%1bpc, 4, 8, 8, dst, stride, src0, src1, w, h, t0, t1
     shl                 t0d, 16
     mov                 t0w, r7m                ; w0
     movd                xm3, t0d
-    vpbroadcastd         m3, xm3                ; w0, w1
+    VPBROADCASTD         m3, xm3                ; w0, w1
 
     pxor                m6, m6                  ;pixel min
-    vpbroadcastw        m7, r11m                ;pixel max
+    movd               xm7, r11m
+    SPLATW              m7, xm7                 ;pixel max
 
     mov                 t1q, rcx                ; save ecx
     mov                 ecx, r11m
@@ -278,7 +297,7 @@ cglobal vvc_w_avg_%1bpc, 4, 8, 8, dst, stride, src0, src1, w, h, t0, t1
     dec                ecx
     shl                t0d, cl
     movd               xm4, t0d
-    vpbroadcastd        m4, xm4                 ; offset
+    VPBROADCASTD        m4, xm4                 ; offset
     mov                rcx, t1q                 ; restore ecx
 
     lea                 r6, [w_avg_%1 %+ SUFFIX %+ _table]
@@ -288,15 +307,904 @@ cglobal vvc_w_avg_%1bpc, 4, 8, 8, dst, stride, src0, src1, w, h, t0, t1
     AVG_FN              %1, W_AVG
 %endmacro
 
+%define DMVR_DST_STRIDE (MAX_PB_SIZE * 2)
+
+; only the loads and stores depend on the width, the rest works on full registers
+%macro DMVR_LOAD 4 ; bpc, dst, src, width
+%if %4 == 16
+  %if %1 == 8
+    pmovzxbw            m%2, %3
+  %else
+    movu                m%2, %3
+  %endif
+%elif %4 == 8
+  %if %1 == 8
+    pmovzxbw           xm%2, %3
+  %else
+    movu               xm%2, %3
+  %endif
+%else
+  %if %1 == 8
+    movd               xm%2, %3
+    pmovzxbw           xm%2, xm%2
+  %else
+    movq               xm%2, %3
+  %endif
+%endif
+%endmacro
+
+%macro DMVR_STORE 3 ; dst, src, width
+%if %3 == 16
+    movu                 %1, m%2
+%elif %3 == 8
+    movu                 %1, xm%2
+%else
+    movq                 %1, xm%2
+%endif
+%endmacro
+
+; m8, m9: filter, m10: rounding multiplier, the sum is at most 16 * 4095 so
+; it is halved before rounding to stay in pmulhrsw range
+%macro DMVR_FILTER 6 ; bpc, dst, tmp, src, src + offset, width
+    DMVR_LOAD           %1, %2, [%4], %6
+    DMVR_LOAD           %1, %3, [%5], %6
+    pmullw             m%2, m8
+    pmullw             m%3, m9
+    paddw              m%2, m%3
+    psrlw              m%2, 1
+    pmulhrsw           m%2, m10
+%endmacro
+
+%macro DMVR_PIXELS_ROW 2 ; bpc, width
+    DMVR_LOAD           %1, 0, [srcq], %2
+    DMVR_LOAD           %1, 1, [srcq + %2 * %1 / 8], 4
+%if %1 == 8
+    psllw               m0, 2
+    psllw               m1, 2
+%else
+    paddw               m0, m2
+    paddw               m1, m2
+    psrlw               m0, xm3
+    psrlw               m1, xm3
+%endif
+    DMVR_STORE      [dstq], 0, %2
+    DMVR_STORE      [dstq + %2 * 2], 1, 4
+%endmacro
+
+%macro DMVR_H_ROW 2 ; bpc, width
+    DMVR_FILTER         %1, 0, 6, srcq, srcq + %1 / 8, %2
+    DMVR_FILTER         %1, 1, 7, srcq + %2 * %1 / 8, srcq + %2 * %1 / 8 + %1 / 8, 4
+    DMVR_STORE      [dstq], 0, %2
+    DMVR_STORE      [dstq + %2 * 2], 1, 4
+%endmacro
+
+%macro DMVR_V_ROW 2 ; bpc, width
+    DMVR_FILTER         %1, 0, 6, srcq, srcq + src_strideq, %2
+    DMVR_FILTER         %1, 1, 7, srcq + %2 * %1 / 8, srcq + src_strideq + %2 * %1 / 8, 4
+    DMVR_STORE      [dstq], 0, %2
+    DMVR_STORE      [dstq + %2 * 2], 1, 4
+%endmacro
+
+; m4, m5: horizontal filtered previous row, m11, m12: vertical filter
+%macro DMVR_HV_FIRST_ROW 2 ; bpc, width
+    DMVR_FILTER         %1, 4, 6, srcq, srcq + %1 / 8, %2
+    DMVR_FILTER         %1, 5, 7, srcq + %2 * %1 / 8, srcq + %2 * %1 / 8 + %1 / 8, 4
+    add                srcq, src_strideq
+%endmacro
+
+%macro DMVR_HV_ROW 2 ; bpc, width
+    DMVR_FILTER         %1, 0, 6, srcq, srcq + %1 / 8, %2
+    DMVR_FILTER         %1, 1, 7, srcq + %2 * %1 / 8, srcq + %2 * %1 / 8 + %1 / 8, 4
+    pmullw              m4, m11
+    pmullw              m5, m11
+    pmullw              m6, m0, m12
+    pmullw              m7, m1, m12
+    paddw               m4, m6
+    paddw               m5, m7
+    pmulhrsw            m4, m13
+    pmulhrsw            m5, m13
+    DMVR_STORE      [dstq], 4, %2
+    DMVR_STORE      [dstq + %2 * 2], 5, 4
+    mova                m4, m0
+    mova                m5, m1
+%endmacro
+
+; the DMVR block is 4 samples wider than the 8 or 16 wide sub-block
+%macro DMVR_LOOP 2-3 ; bpc, row macro, first row macro
+    cmp                  wd, 12
+    je .w12
+%if %0 > 2
+    %3                  %1, 16
+%endif
+.w20_loop:
+    %2                  %1, 16
+    add                srcq, src_strideq
+    add                dstq, DMVR_DST_STRIDE
+    dec                  hd
+    jg .w20_loop
+    RET
+.w12:
+%if %0 > 2
+    %3                  %1, 8
+%endif
+.w12_loop:
+    %2                  %1, 8
+    add                srcq, src_strideq
+    add                dstq, DMVR_DST_STRIDE
+    dec                  hd
+    jg .w12_loop
+    RET
+%endmacro
+
+%macro DMVR_LOAD_FILTER 3 ; f0, f1, frac
+    movd               xm%2, %3d
+    vpbroadcastw        m%2, xm%2
+    vpbroadcastd        m%1, [pw_16]
+    psubw               m%1, m%2
+%endmacro
+
+; rounding multiplier of the first pass, 1 << (16 - shift1) with shift1 = bit_depth - 6
+%macro DMVR_LOAD_ROUND 1 ; bpc
+%if %1 == 8
+    vpbroadcastd        m10, [pw_16384]
+%else
+    mov                 mxd, r7m
+    inc                 mxd
+    tzcnt               mxd, mxd
+    neg                 mxd
+    add                 mxd, 22
+    mov                 myd, 1
+    shlx                myd, myd, mxd
+    movd               xm10, myd
+    vpbroadcastw        m10, xm10
+%endif
+%endmacro
+
+;void ff_vvc_dmvr_%1bpc_avx2(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride,
+;    int height, intptr_t mx, intptr_t my, int width, intptr_t pixel_max);
+%macro VVC_DMVR_AVX2 1
+cglobal vvc_dmvr_%1bpc, 7, 7, 4, dst, src, src_stride, h, mx, my, w
+%if %1 > 8
+    mov                 mxd, r7m
+    inc                 mxd
+    tzcnt               mxd, mxd
+    sub                 mxd, 10                     ; 0 or 2
+    movd                xm3, mxd
+    mov                 myd, 1
+    shlx                myd, myd, mxd
+    shr                 myd, 1
+    movd                xm2, myd
+    vpbroadcastw         m2, xm2
+%endif
+    DMVR_LOOP           %1, DMVR_PIXELS_ROW
+
+cglobal vvc_dmvr_h_%1bpc, 7, 7, 11, dst, src, src_stride, h, mx, my, w
+    DMVR_LOAD_FILTER     8, 9, mx
+    DMVR_LOAD_ROUND     %1
+    DMVR_LOOP           %1, DMVR_H_ROW
+
+cglobal vvc_dmvr_v_%1bpc, 7, 7, 11, dst, src, src_stride, h, mx, my, w
+    DMVR_LOAD_FILTER     8, 9, my
+    DMVR_LOAD_ROUND     %1
+    DMVR_LOOP           %1, DMVR_V_ROW
+
+cglobal vvc_dmvr_hv_%1bpc, 7, 7, 14, dst, src, src_stride, h, mx, my, w
+    DMVR_LOAD_FILTER    11, 12, my
+    DMVR_LOAD_FILTER     8, 9, mx
+    DMVR_LOAD_ROUND     %1
+    vpbroadcastd        m13, [pw_2048]
+    DMVR_LOOP           %1, DMVR_HV_ROW, DMVR_HV_FIRST_ROW
+%endmacro
+
+; load chunk weights[x * step] as words into m0
+%macro GPM_WEIGHTS 3 ; register prefix, chunk, step
+%if %3 == 1
+    pmovzxbw          %{1}0, [wpq]
+%elif %3 == -1
+    pmovzxbw          %{1}0, [wpq - (%2 - 1)]
+%elif %2 == 4
+    movq                xm0, [wpq - (%3 < 0) * 7]
+%else
+    movu              %{1}0, [wpq - (%3 < 0) * (2 * %2 - 1)]
+%endif
+%if %3 == 2
+    pand              %{1}0, %{1}11
+%elif %3 == -2
+    psrlw             %{1}0, 8
+%endif
+%if %3 < 0
+%if %2 == 16
+    vpermq               m0, m0, q1032
+    pshufb               m0, m11
+%elif %2 == 8
+    pshufb              xm0, xm11
+%else
+    pshuflw             xm0, xm0, q0123
+%endif
+%endif
+%endmacro
+
+%macro GPM_BLEND 3 ; bpc, register prefix, chunk
+%if %3 == 4
+    movq                xm1, [src0q + colq * 2]
+    movq                xm2, [src1q + colq * 2]
+%else
+    movu              %{2}1, [src0q + colq * 2]
+    movu              %{2}2, [src1q + colq * 2]
+%endif
+    psubw             %{2}3, %{2}7, %{2}0
+    punpcklwd         %{2}4, %{2}0, %{2}3
+    punpckhwd         %{2}0, %{2}3
+    punpcklwd         %{2}5, %{2}1, %{2}2
+    punpckhwd         %{2}1, %{2}2
+    pmaddwd           %{2}5, %{2}4
+    pmaddwd           %{2}1, %{2}0
+    paddd             %{2}5, %{2}8
+    paddd             %{2}1, %{2}8
+    psrad             %{2}5, xm9
+    psrad             %{2}1, xm9
+    packssdw          %{2}5, %{2}1
+%if %1 == 8
+    packuswb          %{2}5, %{2}5
+%if %3 == 16
+    vpermq               m5, m5, q3120
+    movu    [dstq + colq], xm5
+%elif %3 == 8
+    movq    [dstq + colq], xm5
+%else
+    movd    [dstq + colq], xm5
+%endif
+%else
+    pmaxsw            %{2}5, %{2}6
+    pminsw            %{2}5, %{2}10
+%if %3 == 4
+    movq  [dstq + colq * 2], xm5
+%else
+    movu  [dstq + colq * 2], %{2}5
+%endif
+%endif
+%endmacro
+
+%macro GPM_ROWS 5 ; bpc, register prefix, chunk, step, label
+.%5:
+%if %4 == 2
+    vpbroadcastd        m11, [pw_255]
+%elif %4 < 0
+    vbroadcasti128      m11, [gpm_reverse_shuf]
+%endif
+.%5_loop_y:
+    xor                cold, cold
+    mov                 wpq, wtq
+.%5_loop_x:
+    GPM_WEIGHTS         %2, %3, %4
+    GPM_BLEND           %1, %2, %3
+    add                 wpq, %3 * %4
+    add                cold, %3
+    cmp                cold, wd
+    jl .%5_loop_x
+    add                dstq, dsq
+    add               src0q, 2 * MAX_PB_SIZE
+    add               src1q, 2 * MAX_PB_SIZE
+    add                 wtq, step_yq
+    dec                  hd
+    jg .%5_loop_y
+    RET
+%endmacro
+
+%macro GPM_STEP_JMP 1 ; width label
+    cmp             step_xd, 1
+    je .%1_p1
+    cmp             step_xd, -1
+    je .%1_m1
+    cmp             step_xd, 2
+    je .%1_p2
+    jmp .%1_m2
+%endmacro
+
+; step_x is +-1 for luma and 4:4:4 chroma, +-2 for subsampled chroma, so a width of 4 is always +-2
+;void ff_vvc_put_gpm_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, int width, int height,
+;    const int16_t *src0, const int16_t *src1, const uint8_t *weights, int step_x, int step_y,
+;    intptr_t pixel_max);
+%macro VVC_PUT_GPM_AVX2 1
+cglobal vvc_put_gpm_%1bpc, 10, 12, 12, dst, ds, w, h, src0, src1, wt, step_x, step_y, pixel_max, col, wp
+    movsxd          step_yq, step_yd
+    lea                cold, [pixel_maxq + 1]
+    tzcnt              cold, cold
+    neg                cold
+    add                cold, 17                   ; shift
+    movd                xm9, cold
+    dec                cold
+    mov                 wpd, 1
+    shlx                wpd, wpd, cold
+    movd                xm8, wpd
+    vpbroadcastd         m8, xm8                    ; offset
+    vpbroadcastd         m7, [pw_8]
+%if %1 > 8
+    movd               xm10, pixel_maxd
+    vpbroadcastw        m10, xm10
+    pxor                 m6, m6
+%endif
+    cmp                  wd, 8
+    je .w8
+    jg .w16
+    test            step_xd, step_xd
+    js .w4_m2
+    jmp .w4_p2
+.w8:
+    GPM_STEP_JMP        w8
+.w16:
+    GPM_STEP_JMP       w16
+
+    GPM_ROWS            %1, xm,  4,  2, w4_p2
+    GPM_ROWS            %1, xm,  4, -2, w4_m2
+    GPM_ROWS            %1, xm,  8,  1, w8_p1
+    GPM_ROWS            %1, xm,  8, -1, w8_m1
+    GPM_ROWS            %1, xm,  8,  2, w8_p2
+    GPM_ROWS            %1, xm,  8, -2, w8_m2
+    GPM_ROWS            %1,  m, 16,  1, w16_p1
+    GPM_ROWS            %1,  m, 16, -1, w16_m1
+    GPM_ROWS            %1,  m, 16,  2, w16_p2
+    GPM_ROWS            %1,  m, 16, -2, w16_m2
+%endmacro
+
+%macro CIIP_BLEND 3 ; bpc, register prefix, chunk in bytes
+%if %3 == 4
+    movd                xm0, [dstq + colq]
+    movd                xm1, [interq + colq]
+%elif %3 == 8
+    movq                xm0, [dstq + colq]
+    movq                xm1, [interq + colq]
+%else
+    movu              %{2}0, [dstq + colq]
+    movu              %{2}1, [interq + colq]
+%endif
+%if %1 == 8
+    punpcklbw         %{2}2, %{2}0, %{2}1
+    punpckhbw         %{2}0, %{2}1
+    pmaddubsw         %{2}2, %{2}4
+    pmaddubsw         %{2}0, %{2}4
+    pmulhrsw          %{2}2, %{2}3
+    pmulhrsw          %{2}0, %{2}3
+    packuswb          %{2}0, %{2}2, %{2}0
+%else
+    pmullw            %{2}0, %{2}4
+    pmullw            %{2}1, %{2}5
+    paddw             %{2}0, %{2}1
+    pmulhrsw          %{2}0, %{2}3
+%endif
+%if %3 == 4
+    movd    [dstq + colq], xm0
+%elif %3 == 8
+    movq    [dstq + colq], xm0
+%else
+    movu    [dstq + colq], %{2}0
+%endif
+%endmacro
+
+%macro CIIP_ROWS 3 ; bpc, register prefix, chunk in bytes
+.w%3:
+    xor                cold, cold
+.w%3_loop_x:
+    CIIP_BLEND          %1, %2, %3
+    add                cold, %3
+    cmp                cold, wd
+    jl .w%3_loop_x
+    add                dstq, dsq
+    add              interq, isq
+    dec                  hd
+    jg .w%3
+    RET
+%endmacro
+
+;void ff_vvc_put_ciip_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, int width, int height,
+;    const uint8_t *inter, ptrdiff_t inter_stride, int intra_weight);
+%macro VVC_PUT_CIIP_AVX2 1
+cglobal vvc_put_ciip_%1bpc, 7, 8, 6, dst, ds, w, h, inter, is, iw, col
+    mov                cold, 4
+    sub                cold, iwd                  ; inter weight
+%if %1 == 8
+    shl                cold, 8
+    or                 cold, iwd
+    movd                xm4, cold
+    vpbroadcastw         m4, xm4
+%else
+    movd                xm4, iwd
+    vpbroadcastw         m4, xm4
+    movd                xm5, cold
+    vpbroadcastw         m5, xm5
+    add                  wd, wd
+%endif
+    vpbroadcastd         m3, [pw_8192]
+    cmp                  wd, 8
+    jl .w4
+    je .w8
+    cmp                  wd, 16
+    je .w16
+    CIIP_ROWS           %1,  m, 32
+    CIIP_ROWS           %1, xm, 16
+    CIIP_ROWS           %1, xm,  8
+    CIIP_ROWS           %1, xm,  4
+%endmacro
+
+; Scaled (RPR) MC runs in two passes over a row-major int16 buffer with a stride of MAX_PB_SIZE.
+; The caller resolves the integer position and the filter phase of every column and row beforehand,
+; pos holds the offsets in samples and filters the taps, one entry per column or row.
+
+%define SCALED_TMP_STRIDE (MAX_PB_SIZE * 2)
+
+; 8 columns from one source row, out: xm0
+%macro SCALED_H_8BPC 1 ; taps
+%if %1 == 8
+    mov                 p0d, [posq + colq * 4]
+    mov                 p1d, [posq + colq * 4 + 4]
+    movq                xm0, [srcq + p0q]
+    movhps              xm0, [srcq + p1q]
+    mov                 p0d, [posq + colq * 4 + 8]
+    mov                 p1d, [posq + colq * 4 + 12]
+    movq                xm2, [srcq + p0q]
+    movhps              xm2, [srcq + p1q]
+    vinserti128          m0, m0, xm2, 1
+    mov                 p0d, [posq + colq * 4 + 16]
+    mov                 p1d, [posq + colq * 4 + 20]
+    movq                xm1, [srcq + p0q]
+    movhps              xm1, [srcq + p1q]
+    mov                 p0d, [posq + colq * 4 + 24]
+    mov                 p1d, [posq + colq * 4 + 28]
+    movq                xm2, [srcq + p0q]
+    movhps              xm2, [srcq + p1q]
+    vinserti128          m1, m1, xm2, 1
+    pmaddubsw            m0, [filtersq + colq * 8]
+    pmaddubsw            m1, [filtersq + colq * 8 + 32]
+    phaddw               m0, m1
+    phaddw               m0, m0
+    vextracti128        xm1, m0, 1
+    punpckldq           xm0, xm1
+%else
+    mov                 p0d, [posq + colq * 4]
+    mov                 p1d, [posq + colq * 4 + 4]
+    movd                xm0, [srcq + p0q]
+    pinsrd              xm0, [srcq + p1q], 1
+    mov                 p0d, [posq + colq * 4 + 8]
+    mov                 p1d, [posq + colq * 4 + 12]
+    pinsrd              xm0, [srcq + p0q], 2
+    pinsrd              xm0, [srcq + p1q], 3
+    mov                 p0d, [posq + colq * 4 + 16]
+    mov                 p1d, [posq + colq * 4 + 20]
+    movd                xm1, [srcq + p0q]
+    pinsrd              xm1, [srcq + p1q], 1
+    mov                 p0d, [posq + colq * 4 + 24]
+    mov                 p1d, [posq + colq * 4 + 28]
+    pinsrd              xm1, [srcq + p0q], 2
+    pinsrd              xm1, [srcq + p1q], 3
+    vinserti128          m0, m0, xm1, 1
+    pmaddubsw            m0, [filtersq + colq * 4]
+    phaddw               m0, m0
+    vpermq               m0, m0, q3120
+%endif
+%endmacro
+
+%macro SCALED_H_16BPC 1 ; taps
+%if %1 == 8
+%assign %%i 0
+%rep 4
+    mov                 p0d, [posq + colq * 4 + %%i * 8]
+    mov                 p1d, [posq + colq * 4 + %%i * 8 + 4]
+    movu           xm %+ %%i, [srcq + p0q * 2]
+    vinserti128     m %+ %%i, m %+ %%i, [srcq + p1q * 2], 1
+    pmovsxbw             m4, [filtersq + colq * 8 + %%i * 16]
+    pmaddwd         m %+ %%i, m4
+%assign %%i %%i + 1
+%endrep
+    phaddd               m0, m1
+    phaddd               m2, m3
+    phaddd               m0, m2                     ; c0 c2 c4 c6 | c1 c3 c5 c7
+    psrad                m0, xm5
+    vextracti128        xm1, m0, 1
+    punpckldq           xm2, xm0, xm1
+    punpckhdq           xm0, xm1
+    packssdw            xm0, xm2, xm0
+%else
+%assign %%i 0
+%rep 2
+    mov                 p0d, [posq + colq * 4 + %%i * 16]
+    mov                 p1d, [posq + colq * 4 + %%i * 16 + 4]
+    movq           xm %+ %%i, [srcq + p0q * 2]
+    movhps         xm %+ %%i, [srcq + p1q * 2]
+    mov                 p0d, [posq + colq * 4 + %%i * 16 + 8]
+    mov                 p1d, [posq + colq * 4 + %%i * 16 + 12]
+    movq                xm2, [srcq + p0q * 2]
+    movhps              xm2, [srcq + p1q * 2]
+    vinserti128     m %+ %%i, m %+ %%i, xm2, 1
+    pmovsxbw             m4, [filtersq + colq * 4 + %%i * 16]
+    pmaddwd         m %+ %%i, m4
+%assign %%i %%i + 1
+%endrep
+    phaddd               m0, m1                     ; c0 c1 c4 c5 | c2 c3 c6 c7
+    psrad                m0, xm5
+    vextracti128        xm1, m0, 1
+    punpcklqdq          xm2, xm0, xm1
+    punpckhqdq          xm0, xm1
+    packssdw            xm0, xm2, xm0
+%endif
+%endmacro
+
+;void ff_vvc_put_scaled_h_%2_%1bpc_avx2(int16_t *tmp, const uint8_t *src, ptrdiff_t src_stride,
+;    int height, const int *pos, const int8_t *filters, int width, intptr_t pixel_max);
+%macro VVC_PUT_SCALED_H_AVX2 3 ; bpc, name, taps
+cglobal vvc_put_scaled_h_%2_%1bpc, 7, 10, 6, tmp, src, src_stride, h, pos, filters, w, col, p0, p1
+%if %1 > 8
+    mov                 p0d, r7m
+    inc                 p0d
+    tzcnt               p0d, p0d
+    sub                 p0d, 8
+    movd                xm5, p0d
+%endif
+.loop_y:
+    xor                colq, colq
+.loop_x:
+    SCALED_H_%1BPC      %3
+    movu  [tmpq + colq * 2], xm0
+    add                colq, 8
+    cmp                cold, wd
+    jl .loop_x
+    add                srcq, src_strideq
+    add                tmpq, SCALED_TMP_STRIDE
+    dec                  hd
+    jg .loop_y
+    RET
+%endmacro
+
+; 16 columns, out: m9, m10 as dwords
+%macro SCALED_V 1 ; taps
+%assign %%i 0
+%rep %1 / 2
+    movu                 m0, [rowq + colq * 2 + (2 * %%i) * SCALED_TMP_STRIDE]
+    movu                 m1, [rowq + colq * 2 + (2 * %%i + 1) * SCALED_TMP_STRIDE]
+    punpcklwd            m2, m0, m1
+    punpckhwd            m0, m1
+%assign %%f %%i + 5
+%if %%i
+    pmaddwd              m2, m %+ %%f
+    pmaddwd              m0, m %+ %%f
+    paddd                m9, m2
+    paddd               m10, m0
+%else
+    pmaddwd              m9, m2, m %+ %%f
+    pmaddwd             m10, m0, m %+ %%f
+%endif
+%assign %%i %%i + 1
+%endrep
+    psrad                m9, 6
+    psrad               m10, 6
+%endmacro
+
+%macro SCALED_V_LOAD_FILTERS 1 ; taps
+    pmovsxbw            xm4, [filtersq]
+    vpbroadcastd         m5, xm4
+    pshufd              xm6, xm4, q1111
+    vpbroadcastd         m6, xm6
+%if %1 == 8
+    pshufd              xm7, xm4, q2222
+    vpbroadcastd         m7, xm7
+    pshufd              xm8, xm4, q3333
+    vpbroadcastd         m8, xm8
+%endif
+%endmacro
+
+; store m0 holding 16 output samples of the given size, widths below 16 only have one chunk per row
+%macro SCALED_V_STORE 1 ; bytes per sample
+%if %1 == 1
+    packuswb             m0, m0
+    vpermq               m0, m0, q3120
+%endif
+    cmp                  wd, 8
+    jg .store_w16
+    je .store_w8
+    cmp                  wd, 4
+    je .store_w4
+%if %1 == 1
+    pextrw           [dstq], xm0, 0
+%else
+    movd             [dstq], xm0
+%endif
+    jmp .next_row
+.store_w4:
+%if %1 == 1
+    movd             [dstq], xm0
+%else
+    movq             [dstq], xm0
+%endif
+    jmp .next_row
+.store_w8:
+%if %1 == 1
+    movq             [dstq], xm0
+%else
+    movu             [dstq], xm0
+%endif
+    jmp .next_row
+.store_w16:
+%if %1 == 1
+    movu     [dstq + colq], xm0
+%else
+    movu [dstq + colq * 2], m0
+%endif
+%endmacro
+
+%macro SCALED_V_LOOP 3 ; taps, bytes per sample, output macro
+.loop_y:
+    mov                rowd, [posq]
+    shl                rowq, 8                      ; * SCALED_TMP_STRIDE
+    add                rowq, tmpq
+    SCALED_V_LOAD_FILTERS %1
+    xor                colq, colq
+.loop_x:
+    SCALED_V            %1
+    %3
+    SCALED_V_STORE      %2
+    add                colq, 16
+    cmp                cold, wd
+    jl .loop_x
+.next_row:
+    add                dstq, dst_strideq
+    add                posq, 4
+    add            filtersq, %1
+    dec                  hd
+    jg .loop_y
+    RET
+%endmacro
+
+%macro SCALED_V_PUT 0
+    packssdw             m0, m9, m10
+%endmacro
+
+%macro SCALED_V_UNI 0
+    packssdw             m0, m9, m10
+    pmulhrsw             m0, m11
+%if BPC > 8
+    pmaxsw               m0, m15
+    pminsw               m0, m14
+%endif
+%endmacro
+
+%macro SCALED_V_UNI_W 0
+    packssdw             m0, m9, m10
+    vpbroadcastd         m3, [pw_1]
+    punpcklwd            m1, m0, m3
+    punpckhwd            m0, m3
+    pmaddwd              m1, m11
+    pmaddwd              m0, m11                    ; val * wx + offset
+    psrad                m1, xm12
+    psrad                m0, xm12
+    paddd                m1, m13
+    paddd                m0, m13
+    packssdw             m0, m1, m0
+%if BPC > 8
+    pmaxsw               m0, m15
+    pminsw               m0, m14
+%endif
+%endmacro
+
+;void ff_vvc_put_scaled_v_%1_avx2(int16_t *dst, ptrdiff_t dst_stride, const int16_t *tmp,
+;    const int *pos, const int8_t *filters, int width, int height);
+%macro VVC_PUT_SCALED_V_AVX2 2 ; name, taps
+cglobal vvc_put_scaled_v_%1, 7, 9, 11, dst, dst_stride, tmp, pos, filters, w, h, col, row
+    SCALED_V_LOOP       %2, 2, SCALED_V_PUT
+%endmacro
+
+;void ff_vvc_put_uni_scaled_v_%2_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *tmp,
+;    const int *pos, const int8_t *filters, int width, int height, intptr_t pixel_max);
+%macro VVC_PUT_UNI_SCALED_V_AVX2 3 ; bpc, name, taps
+cglobal vvc_put_uni_scaled_v_%2_%1bpc, 8, 10, 16, dst, dst_stride, tmp, pos, filters, w, h, pixel_max, col, row
+    %define BPC %1
+    lea                colq, [pixel_maxq * 2 + 2]   ; 1 << (15 - shift)
+    movd               xm11, cold
+    vpbroadcastw        m11, xm11
+%if %1 > 8
+    movd               xm14, pixel_maxd
+    vpbroadcastw        m14, xm14
+    pxor                m15, m15
+%endif
+    SCALED_V_LOOP       %3, %1 / 8, SCALED_V_UNI
+    %undef BPC
+%endmacro
+
+;void ff_vvc_put_uni_w_scaled_v_%2_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *tmp,
+;    const int *pos, const int8_t *filters, int width, int height, int denom, int wx, int ox,
+;    intptr_t pixel_max);
+%macro VVC_PUT_UNI_W_SCALED_V_AVX2 3 ; bpc, name, taps
+cglobal vvc_put_uni_w_scaled_v_%2_%1bpc, 11, 13, 16, dst, dst_stride, tmp, pos, filters, w, h, denom, wx, ox, pixel_max, col, row
+    %define BPC %1
+    lea                colq, [pixel_maxq + 1]
+    tzcnt              cold, cold
+    sub                cold, 8
+    shlx                oxd, oxd, cold              ; ox << (bit_depth - 8)
+    movd               xm13, oxd
+    vpbroadcastd        m13, xm13
+    neg                cold
+    lea              denomd, [denomq + colq + 6]    ; shift
+    movd               xm12, denomd
+    dec              denomd
+    mov                rowd, 1
+    shlx               rowd, rowd, denomd
+    shl                rowd, 16
+    movzx               wxd, wxw
+    or                  wxd, rowd
+    movd               xm11, wxd
+    vpbroadcastd        m11, xm11                   ; wx, offset
+%if %1 > 8
+    movd               xm14, pixel_maxd
+    vpbroadcastw        m14, xm14
+    pxor                m15, m15
+%endif
+    SCALED_V_LOOP       %3, %1 / 8, SCALED_V_UNI_W
+    %undef BPC
+%endmacro
+
+%define UNI_W_SRC_STRIDE (MAX_PB_SIZE * 2)
+
+;void ff_vvc_put_uni_w_%1bpc_%2(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,
+;    intptr_t width, intptr_t height, intptr_t denom, intptr_t wx, intptr_t ox, intptr_t pixel_max);
+%macro VVC_PUT_UNI_W 1 ; bpc
+cglobal vvc_put_uni_w_%1bpc, 9, 10, 8, dst, dst_stride, src, w, h, denom, wx, ox, pixel_max, col
+%if %1 > 8
+    movd                xm7, pixel_maxd
+    SPLATW               m7, xm7
+    pxor                 m2, m2
+%endif
+    inc          pixel_maxd
+    bsr          pixel_maxd, pixel_maxd
+    sub          pixel_maxd, 8                      ; bit_depth - 8
+    movd                xm0, pixel_maxd
+    movd                xm6, oxd
+    pslld               xm6, xm0
+    VPBROADCASTD         m6, xm6                    ; ox << (bit_depth - 8)
+
+    add              denomd, 6
+    sub              denomd, pixel_maxd
+    movd                xm5, denomd                 ; shift
+    add              denomd, 15
+    movd                xm0, denomd
+    pcmpeqw              m3, m3
+    psrld                m4, m3, 31
+    psrlw                m3, 15                     ; pw_1
+    pslld                m4, xm0                    ; offset << 16
+    movzx               wxd, wxw
+    movd                xm1, wxd
+    VPBROADCASTD         m1, xm1
+    por                  m4, m1                     ; wx, offset
+
+.loop_y:
+    xor                colq, colq
+.loop_x:
+    movu                 m0, [srcq + colq * 2]
+    punpcklwd            m1, m0, m3
+    punpckhwd            m0, m3
+    pmaddwd              m1, m4
+    pmaddwd              m0, m4                     ; src * wx + offset
+    psrad                m1, xm5
+    psrad                m0, xm5
+    paddd                m1, m6
+    paddd                m0, m6
+    packssdw             m1, m0
+%if %1 == 8
+    packuswb             m1, m1
+%if mmsize > 16
+    vpermq               m1, m1, q3120
+%endif
+%else
+    pmaxsw               m1, m2
+    pminsw               m1, m7
+%endif
+    cmp                  wd, mmsize / 2
+    jl .store_part
+%if %1 == 8 && mmsize > 16
+    movu    [dstq + colq], xm1
+%elif %1 == 8
+    movq    [dstq + colq], xm1
+%else
+    movu [dstq + colq * 2], m1
+%endif
+    add                colq, mmsize / 2
+    cmp                cold, wd
+    jl .loop_x
+.next_row:
+    add                dstq, dst_strideq
+    add                srcq, UNI_W_SRC_STRIDE
+    dec                  hd
+    jg .loop_y
+    RET
+
+.store_part:
+%if mmsize > 16
+    cmp                  wd, 8
+    je .store_w8
+%endif
+    cmp                  wd, 4
+    je .store_w4
+%if %1 == 8
+    pextrw           [dstq], xm1, 0
+%else
+    movd             [dstq], xm1
+%endif
+    jmp .next_row
+.store_w4:
+%if %1 == 8
+    movd             [dstq], xm1
+%else
+    movq             [dstq], xm1
+%endif
+%if mmsize > 16
+    jmp .next_row
+.store_w8:
+%if %1 == 8
+    movq             [dstq], xm1
+%else
+    movu             [dstq], xm1
+%endif
+%endif
+    jmp .next_row
+%endmacro
+
+%if HAVE_SSE4_EXTERNAL
+INIT_XMM sse4
+
+VVC_AVG 16
+
+VVC_AVG 8
+
+VVC_W_AVG 16
+
+VVC_W_AVG 8
+
+VVC_PUT_UNI_W 16
+
+VVC_PUT_UNI_W 8
+%endif
+
+%if HAVE_AVX2_EXTERNAL
 INIT_YMM avx2
 
-VVC_AVG_AVX2 16
+VVC_AVG 16
+
+VVC_AVG 8
+
+VVC_W_AVG 16
+
+VVC_W_AVG 8
+
+VVC_DMVR_AVX2 16
+
+VVC_DMVR_AVX2 8
+
+VVC_PUT_GPM_AVX2 16
+
+VVC_PUT_GPM_AVX2 8
+
+VVC_PUT_CIIP_AVX2 16
+
+VVC_PUT_CIIP_AVX2 8
+
+VVC_PUT_SCALED_H_AVX2 8,  luma,   8
+VVC_PUT_SCALED_H_AVX2 8,  chroma, 4
+VVC_PUT_SCALED_H_AVX2 16, luma,   8
+VVC_PUT_SCALED_H_AVX2 16, chroma, 4
+
+VVC_PUT_SCALED_V_AVX2 luma,   8
+VVC_PUT_SCALED_V_AVX2 chroma, 4
+
+VVC_PUT_UNI_SCALED_V_AVX2 8,  luma,   8
+VVC_PUT_UNI_SCALED_V_AVX2 8,  chroma, 4
+VVC_PUT_UNI_SCALED_V_AVX2 16, luma,   8
+VVC_PUT_UNI_SCALED_V_AVX2 16, chroma, 4
 
-VVC_AVG_AVX2 8
+VVC_PUT_UNI_W_SCALED_V_AVX2 8,  luma,   8
+VVC_PUT_UNI_W_SCALED_V_AVX2 8,  chroma, 4
+VVC_PUT_UNI_W_SCALED_V_AVX2 16, luma,   8
+VVC_PUT_UNI_W_SCALED_V_AVX2 16, chroma, 4
 
-VVC_W_AVG_AVX2 16
+VVC_PUT_UNI_W 16
 
-VVC_W_AVG_AVX2 8
+VVC_PUT_UNI_W 8
 %endif
 
 %endif
@@ -0,0 +1,506 @@
+; /*
+; * Provide SIMD optical flow functions for VVC decoding
+; *
+; * This file is part of FFmpeg.
+; *
+; * FFmpeg is free software; you can redistribute it and/or
+; * modify it under the terms of the GNU Lesser General Public
+; * License as published by the Free Software Foundation; either
+; * version 2.1 of the License, or (at your option) any later version.
+; *
+; * FFmpeg is distributed in the hope that it will be useful,
+; * but WITHOUT ANY WARRANTY; without even the implied warranty of
+; * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+; * Lesser General Public License for more details.
+; *
+; * You should have received a copy of the GNU Lesser General Public
+; * License along with FFmpeg; if not, write to the Free Software
+; * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+; */
+
+%include "libavutil/x86/x86util.asm"
+
+%define MAX_PB_SIZE     128
+%define SRC_STRIDE      (MAX_PB_SIZE * 2)
+
+SECTION_RODATA 32
+
+%if ARCH_X86_64
+
+%if HAVE_AVX2_EXTERNAL
+
+; per-width horizontal weights and right neighbour masks, the first and the
+; last column of the block count twice since the window is edge padded
+bdof_w8_weights:    dw 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1
+bdof_w8_rmask:      dw 0, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+bdof_w16_weights:   dw 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2
+bdof_w16_rmask:     dw 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, 0
+bdof_lmask:         dw 0, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0
+
+pw_8191             dw 8191, 8191
+pw_m8192            dw -8192, -8192
+pd_15               dd 15
+pd_m15              dd -15
+pd_127              dd 127
+
+cextern pw_1
+cextern pd_1
+
+SECTION .text
+
+; accumulate the 6x6 window sums of one row into m0 - m4, 16 columns at a time
+; m0: sgx2, m1: sgy2, m2: sgxgy, m3: sgxdi, m4: sgydi
+%macro BDOF_ROW 2 ; src offset, gradient row to save (-1 for none)
+    movu                 m5, [src0q + %1 + 2]
+    movu                 m6, [src0q + %1 - 2]
+    movu                 m7, [src1q + %1 + 2]
+    movu                 m8, [src1q + %1 - 2]
+    psraw                m5, 6
+    psraw                m6, 6
+    psraw                m7, 6
+    psraw                m8, 6
+    psubw                m5, m6                     ; gradient_h[0]
+    psubw                m7, m8                     ; gradient_h[1]
+%if %2 >= 0
+    psubw                m6, m5, m7
+    mova     [rsp + %2 * 64], m6
+%endif
+    paddw                m5, m7
+    psraw                m5, 1                      ; temph
+
+    movu                 m6, [src0q + %1 + SRC_STRIDE]
+    movu                 m7, [src0q + %1 - SRC_STRIDE]
+    movu                 m8, [src1q + %1 + SRC_STRIDE]
+    movu                 m9, [src1q + %1 - SRC_STRIDE]
+    psraw                m6, 6
+    psraw                m7, 6
+    psraw                m8, 6
+    psraw                m9, 6
+    psubw                m6, m7                     ; gradient_v[0]
+    psubw                m8, m9                     ; gradient_v[1]
+%if %2 >= 0
+    psubw                m7, m6, m8
+    mova     [rsp + %2 * 64 + 32], m7
+%endif
+    paddw                m6, m8
+    psraw                m6, 1                      ; tempv
+
+    movu                 m7, [src0q + %1]
+    movu                 m8, [src1q + %1]
+    psraw                m7, 4
+    psraw                m8, 4
+    psubw                m7, m8                     ; diff
+
+    pabsw                m8, m5
+    paddw                m0, m8
+    pabsw                m8, m6
+    paddw                m1, m8
+    psignw               m8, m5, m6
+    paddw                m2, m8
+    psignw               m8, m7, m5
+    psubw                m3, m8
+    psignw               m7, m6
+    psubw                m4, m7
+%endmacro
+
+; sum the columns of m%1 over the (edge padded) 6-wide window of each 4x4 block,
+; leaving two dword partial sums per block
+%macro BDOF_HSUM 1
+    vperm2i128           m5, m%1, m%1, 0x08
+    palignr              m5, m%1, m5, 14            ; left neighbour
+    vperm2i128           m6, m%1, m%1, 0x81
+    palignr              m6, m6, m%1, 2             ; right neighbour
+    pand                 m5, [bdof_lmask]
+    pand                 m6, m15
+    por                  m5, m6
+    pmaddwd             m%1, m14
+    pmaddwd              m5, m10
+    paddd               m%1, m5
+%endmacro
+
+; derive vx, vy of 4 blocks, output m0: vx/vy words of blocks 0 and 2, m1: blocks 1 and 3
+%macro BDOF_VX_VY 0
+    phaddd               m0, m1                     ; sgx2, sgy2
+    phaddd               m3, m4                     ; sgxdi, sgydi
+    pxor                 m1, m1
+    phaddd               m1, m2                     ; 0, sgxgy
+
+    cvtdq2ps             m0, m0
+    psrld                m0, 23
+    vpbroadcastd         m2, [pd_127]
+    psubd                m0, m2                     ; av_log2(sgx2), av_log2(sgy2)
+    vpbroadcastd         m4, [pd_15]
+    vpbroadcastd         m5, [pd_m15]
+
+    pslld                m3, 2
+    vpsravd              m2, m3, m0
+    pminsd               m2, m4
+    pmaxsd               m2, m5
+    pshufd               m2, m2, q1010              ; vx
+    pmulld               m2, m1
+    psrad                m2, 1
+    psubd                m3, m2
+    vpsravd              m3, m3, m0
+    pminsd               m3, m4
+    pmaxsd               m3, m5                     ; vx, vy
+
+    packssdw             m3, m3
+    pshuflw              m3, m3, q3120
+    pshufd               m0, m3, q0000
+    pshufd               m1, m3, q1111
+%endmacro
+
+%macro BDOF_OUT_ROW 4 ; bpc, width, row, dst
+    mova                 m5, [rsp + %3 * 64]
+    mova                 m6, [rsp + %3 * 64 + 32]
+    punpcklwd            m7, m5, m6
+    punpckhwd            m5, m6
+    pmaddwd              m7, m0
+    pmaddwd              m5, m1
+    movu                 m6, [src0q + %3 * SRC_STRIDE]
+    movu                 m8, [src1q + %3 * SRC_STRIDE]
+    punpcklwd            m9, m6, m8
+    punpckhwd            m6, m8
+    pmaddwd              m9, m10
+    pmaddwd              m6, m10
+    paddd                m7, m9
+    paddd                m5, m6
+    paddd                m7, m11
+    paddd                m5, m11
+    psrad                m7, xm13
+    psrad                m5, xm13
+    packssdw             m7, m5
+%if %1 == 8
+    packuswb             m7, m7
+  %if %2 == 16
+    vpermq               m7, m7, q2020
+    movu                %4, xm7
+  %else
+    movq                %4, xm7
+  %endif
+%else
+    pminsw               m7, m12
+    pxor                 m9, m9
+    pmaxsw               m7, m9
+  %if %2 == 16
+    movu                %4, m7
+  %else
+    movu                %4, xm7
+  %endif
+%endif
+%endmacro
+
+%macro BDOF_OUT 2 ; bpc, width
+    BDOF_OUT_ROW         %1, %2, 0, [dstq]
+    BDOF_OUT_ROW         %1, %2, 1, [dstq + strideq]
+    BDOF_OUT_ROW         %1, %2, 2, [dstq + strideq * 2]
+    BDOF_OUT_ROW         %1, %2, 3, [dstq + stride3q]
+%endmacro
+
+;void ff_vvc_apply_bdof_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, int16_t *src0, int16_t *src1,
+;    int block_w, int block_h, int pixel_max);
+%macro VVC_APPLY_BDOF_AVX2 1
+cglobal vvc_apply_bdof_%1bpc, 7, 10, 16, 4*64, dst, stride, src0, src1, w, h, pixel_max, top, bot, stride3
+    lea                topq, [bdof_w8_weights]
+    cmp                  wd, 8
+    je .w8_masks
+    add                topq, 64
+.w8_masks:
+    mova                m14, [topq]
+    mova                m15, [topq + 32]
+    vpbroadcastd        m10, [pw_1]
+%if %1 > 8
+    movd               xm12, pixel_maxd
+    vpbroadcastw        m12, xm12
+%endif
+
+    inc          pixel_maxd
+    tzcnt        pixel_maxd, pixel_maxd
+    neg          pixel_maxd
+    add          pixel_maxd, 15
+    movd               xm13, pixel_maxd             ; shift4
+    dec          pixel_maxd
+    movd               xm11, pixel_maxd
+    vpbroadcastd         m9, [pd_1]
+    pslld                m9, xm11
+    mova                m11, m9                     ; offset4
+
+    lea            stride3q, [strideq * 3]
+    xor                topd, topd
+.loop:
+    mov                botd, 4 * SRC_STRIDE
+    cmp                  hd, 4
+    jne .bottom
+    mov                botd, 3 * SRC_STRIDE
+.bottom:
+    pxor                 m0, m0
+    pxor                 m1, m1
+    pxor                 m2, m2
+    pxor                 m3, m3
+    pxor                 m4, m4
+    BDOF_ROW           topq, -1
+    BDOF_ROW              0, 0
+    BDOF_ROW     SRC_STRIDE, 1
+    BDOF_ROW 2 * SRC_STRIDE, 2
+    BDOF_ROW 3 * SRC_STRIDE, 3
+    BDOF_ROW           botq, -1
+
+    BDOF_HSUM            0
+    BDOF_HSUM            1
+    BDOF_HSUM            2
+    BDOF_HSUM            3
+    BDOF_HSUM            4
+    BDOF_VX_VY
+
+    cmp                  wd, 8
+    je .w8
+    BDOF_OUT            %1, 16
+    jmp .next
+.w8:
+    BDOF_OUT            %1, 8
+.next:
+    lea                dstq, [dstq + strideq * 4]
+    add               src0q, 4 * SRC_STRIDE
+    add               src1q, 4 * SRC_STRIDE
+    mov                topq, -SRC_STRIDE
+    sub                  hd, 4
+    jg .loop
+    RET
+%endmacro
+
+%macro BDOF_FETCH_ROW 2 ; bpc, register prefix
+%if %1 == 8
+    pmovzxbw          %{2}0, [srcq]
+    pmovzxbw          %{2}1, [srcq + 2]
+%else
+    movu              %{2}0, [srcq]
+    movu              %{2}1, [srcq + 4]
+%endif
+    psllw             %{2}0, xm2
+    psllw             %{2}1, xm2
+    movu             [dstq], %{2}0
+    movu         [dstq + 4], %{2}1
+%endmacro
+
+;void ff_vvc_bdof_fetch_samples_%1bpc_avx2(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride,
+;    int x_frac, int y_frac, int width, int height, int pixel_max);
+%macro VVC_BDOF_FETCH_SAMPLES_AVX2 1
+cglobal vvc_bdof_fetch_samples_%1bpc, 7, 10, 3, dst, src, src_stride, x_frac, y_frac, w, h, shift, left, right
+%if %1 == 8
+    mov              shiftd, 6
+%else
+    mov              shiftd, r7m
+    inc              shiftd
+    tzcnt            shiftd, shiftd
+    neg              shiftd
+    add              shiftd, 14
+%endif
+    movd                xm2, shiftd
+
+    shr             x_fracd, 3
+    dec             x_fracd
+    movsxd          x_fracq, x_fracd
+    shr             y_fracd, 3
+    dec             y_fracd
+    movsxd          y_fracq, y_fracd
+    imul            y_fracq, src_strideq
+    add                srcq, y_fracq
+    lea                srcq, [srcq + x_fracq * (%1 / 8)]
+    sub                dstq, SRC_STRIDE + 2
+    mov                  wd, wd
+    lea              x_fracq, [wq * 2 + 2]          ; right column offset in dst
+%if %1 == 8
+    lea              y_fracq, [wq + 1]              ; right column offset in src
+%else
+    mov              y_fracq, x_fracq
+%endif
+
+    cmp                  wd, 8
+    je .w8
+    BDOF_FETCH_ROW      %1, m
+    jmp .top_done
+.w8:
+    BDOF_FETCH_ROW      %1, xm
+.top_done:
+    add                srcq, src_strideq
+    add                dstq, SRC_STRIDE
+.loop:
+%if %1 == 8
+    movzx             leftd, byte [srcq]
+    movzx            rightd, byte [srcq + y_fracq]
+%else
+    movzx             leftd, word [srcq]
+    movzx            rightd, word [srcq + y_fracq]
+%endif
+    shlx              leftd, leftd, shiftd
+    shlx             rightd, rightd, shiftd
+    mov              [dstq], leftw
+    mov    [dstq + x_fracq], rightw
+    add                srcq, src_strideq
+    add                dstq, SRC_STRIDE
+    dec                  hd
+    jg .loop
+
+    cmp                  wd, 8
+    je .w8_bottom
+    BDOF_FETCH_ROW      %1, m
+    RET
+.w8_bottom:
+    BDOF_FETCH_ROW      %1, xm
+    RET
+%endmacro
+
+; a 4x4 PROF block fits one register, rows 0 and 1 in the low lane, rows 2 and 3 in the high one
+; out: m0: src, m1: clipped diff
+%macro PROF_DI 0
+    movu                xm0, [srcq - 2]
+    vinserti128          m0, m0, [srcq + 2 * SRC_STRIDE - 2], 1
+    movu                xm1, [srcq + SRC_STRIDE - 2]
+    vinserti128          m1, m1, [srcq + 3 * SRC_STRIDE - 2], 1
+    psraw                m0, 6
+    psraw                m1, 6
+    shufps               m2, m0, m1, q2121          ; right
+    punpcklqdq           m0, m1                     ; left
+    psubw                m2, m0                     ; gradient_h
+
+    movq                xm3, [srcq - SRC_STRIDE]
+    movhps              xm3, [srcq]
+    movq                xm4, [srcq + SRC_STRIDE]
+    movhps              xm4, [srcq + 2 * SRC_STRIDE]
+    movq                xm5, [srcq + 3 * SRC_STRIDE]
+    movhps              xm5, [srcq + 4 * SRC_STRIDE]
+    vinserti128          m3, m3, xm4, 1             ; above
+    vinserti128          m4, m4, xm5, 1             ; below
+    palignr              m0, m4, m3, 8              ; src
+    psraw                m3, 6
+    psraw                m4, 6
+    psubw                m4, m3                     ; gradient_v
+
+    movu                 m5, [diff_mv_xq]
+    movu                 m6, [diff_mv_yq]
+    punpcklwd            m3, m2, m4
+    punpckhwd            m2, m4
+    punpcklwd            m4, m5, m6
+    punpckhwd            m5, m6
+    pmaddwd              m3, m4
+    pmaddwd              m2, m5
+    packssdw             m1, m3, m2
+    vpbroadcastd         m2, [pw_8191]
+    vpbroadcastd         m3, [pw_m8192]
+    pminsw               m1, m2
+    pmaxsw               m1, m3
+%endmacro
+
+%macro PROF_STORE 1 ; bpc
+%if %1 == 8
+    packuswb             m0, m0
+    vextracti128        xm1, m0, 1
+    movd             [dstq], xm0
+    pextrd [dstq + dst_strideq], xm0, 1
+    movd [dstq + dst_strideq * 2], xm1
+    pextrd [dstq + ds3q], xm1, 1
+%else
+    pxor                 m1, m1
+    pmaxsw               m0, m1
+    pminsw               m0, m2
+    vextracti128        xm1, m0, 1
+    movq             [dstq], xm0
+    movhps [dstq + dst_strideq], xm0
+    movq [dstq + dst_strideq * 2], xm1
+    movhps     [dstq + ds3q], xm1
+%endif
+%endmacro
+
+;void ff_vvc_apply_prof_avx2(int16_t *dst, const int16_t *src, const int16_t *diff_mv_x, const int16_t *diff_mv_y);
+%macro VVC_APPLY_PROF_AVX2 0
+cglobal vvc_apply_prof, 4, 4, 7, dst, src, diff_mv_x, diff_mv_y
+    PROF_DI
+    paddw                m0, m1
+    vextracti128        xm1, m0, 1
+    movq             [dstq], xm0
+    movhps [dstq + SRC_STRIDE], xm0
+    movq [dstq + 2 * SRC_STRIDE], xm1
+    movhps [dstq + 3 * SRC_STRIDE], xm1
+    RET
+%endmacro
+
+;void ff_vvc_apply_prof_uni_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,
+;    const int16_t *diff_mv_x, const int16_t *diff_mv_y, intptr_t pixel_max);
+%macro VVC_APPLY_PROF_UNI_AVX2 1
+cglobal vvc_apply_prof_uni_%1bpc, 6, 7, 7, dst, dst_stride, src, diff_mv_x, diff_mv_y, pixel_max, ds3
+    PROF_DI
+    paddsw               m0, m1
+    lea                ds3d, [pixel_maxq * 2 + 2]   ; 1 << (15 - shift)
+    movd                xm1, ds3d
+    vpbroadcastw         m1, xm1
+    pmulhrsw             m0, m1
+%if %1 > 8
+    movd                xm2, pixel_maxd
+    vpbroadcastw         m2, xm2
+%endif
+    lea                ds3q, [dst_strideq * 3]
+    PROF_STORE          %1
+    RET
+%endmacro
+
+;void ff_vvc_apply_prof_uni_w_%1bpc_avx2(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,
+;    const int16_t *diff_mv_x, const int16_t *diff_mv_y, int denom, int wx, int ox, intptr_t pixel_max);
+%macro VVC_APPLY_PROF_UNI_W_AVX2 1
+cglobal vvc_apply_prof_uni_w_%1bpc, 9, 10, 7, dst, dst_stride, src, diff_mv_x, diff_mv_y, denom, wx, ox, pixel_max, ds3
+    PROF_DI
+    punpcklwd            m2, m0, m1
+    punpckhwd            m0, m1
+    movd                xm1, wxd
+    vpbroadcastw         m1, xm1
+    pmaddwd              m2, m1
+    pmaddwd              m0, m1                     ; (src + di) * wx
+
+    lea                ds3d, [pixel_maxq + 1]
+    tzcnt              ds3d, ds3d
+    sub                ds3d, 8
+    shlx                oxd, oxd, ds3d              ; ox << (bit_depth - 8)
+    neg                ds3d
+    lea              denomd, [denomq + ds3q + 6]    ; shift
+    movd                xm3, denomd
+    dec              denomd
+    mov                ds3d, 1
+    shlx               ds3d, ds3d, denomd
+    movd                xm4, ds3d
+    vpbroadcastd         m4, xm4
+    paddd                m2, m4
+    paddd                m0, m4
+    psrad                m2, xm3
+    psrad                m0, xm3
+    movd                xm4, oxd
+    vpbroadcastd         m4, xm4
+    paddd                m2, m4
+    paddd                m0, m4
+    packssdw             m0, m2, m0
+%if %1 > 8
+    movd                xm2, pixel_maxd
+    vpbroadcastw         m2, xm2
+%endif
+    lea                ds3q, [dst_strideq * 3]
+    PROF_STORE          %1
+    RET
+%endmacro
+
+INIT_YMM avx2
+
+VVC_APPLY_PROF_AVX2
+
+VVC_APPLY_PROF_UNI_AVX2 8
+VVC_APPLY_PROF_UNI_AVX2 16
+
+VVC_APPLY_PROF_UNI_W_AVX2 8
+VVC_APPLY_PROF_UNI_W_AVX2 16
+
+VVC_APPLY_BDOF_AVX2 8
+VVC_APPLY_BDOF_AVX2 16
+
+VVC_BDOF_FETCH_SAMPLES_AVX2 8
+VVC_BDOF_FETCH_SAMPLES_AVX2 16
+
+%endif
+
+%endif
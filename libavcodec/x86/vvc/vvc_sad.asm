@@ -38,8 +38,12 @@ SECTION .text
 %endmacro
 
 %macro HORIZ_ADD 3  ; xm0, xm1, m1
+%if mmsize == 32
     vextracti128     %1, %3, q0001  ;        3        2      1          0
     paddd            %1, %2         ; xm0 (7 + 3) (6 + 2) (5 + 1)   (4 + 0)
+%else
+    mova             %1, %2
+%endif
     pshufd           %2, %1, q0032  ; xm1    -      -     (7 + 3)   (6 + 2)
     paddd            %1, %1, %2     ; xm0    _      _     (5 1 7 3) (4 0 6 2)
     pshufd           %2, %1, q0001  ; xm1    _      _     (5 1 7 3) (5 1 7 3)
@@ -47,10 +51,8 @@ SECTION .text
 %endmacro
 
 %if ARCH_X86_64
-%if HAVE_AVX2_EXTERNAL
-
-INIT_YMM avx2
 
+%macro VVC_SAD 0
 cglobal vvc_sad, 6, 9, 5, src1, src2, dx, dy, block_w, block_h, off1, off2, row_idx
     movsxdifnidn    dxq, dxd
     movsxdifnidn    dyq, dyd
@@ -74,13 +76,14 @@ cglobal vvc_sad, 6, 9, 5, src1, src2, dx, dy, block_w, block_h, off1, off2, row_
     lea             src2q, [src2q + off2q * 2 + 2 * 2]
 
     pxor               m3, m3
-    vpbroadcastd       m4, [pw_1]
+    VPBROADCASTD       m4, [pw_1]
 
-    cmp          block_wd, 16
-    jge    vvc_sad_16_128
+    cmp          block_wd, mmsize / 2
+    jge          .w16_128
 
-    vvc_sad_8:
-        .loop_height:
+    .w8:
+        .w8_loop_height:
+%if mmsize == 32
         movu              xm0, [src1q]
         vinserti128        m0, m0, [src1q + MAX_PB_SIZE * ROWS * 2], 1
         movu              xm1, [src2q]
@@ -94,40 +97,161 @@ cglobal vvc_sad, 6, 9, 5, src1, src2, dx, dy, block_w, block_h, off1, off2, row_
         add         src2q, 2 * MAX_PB_SIZE * ROWS * 2
 
         sub      block_hd, 4
-        jg   .loop_height
+%else
+        movu               m0, [src1q]
+        movu               m1, [src2q]
+        MIN_MAX_SAD        m1, m0, m2
+        pmaddwd            m1, m4
+        paddd              m3, m1
+
+        add         src1q, MAX_PB_SIZE * ROWS * 2
+        add         src2q, MAX_PB_SIZE * ROWS * 2
+
+        sub      block_hd, 2
+%endif
+        jg   .w8_loop_height
 
         HORIZ_ADD     xm0, xm3, m3
         movd          eax, xm0
     RET
 
-    vvc_sad_16_128:
+    .w16_128:
+%if mmsize == 32
         sar      block_wd, 4
-        .loop_height:
+%else
+        sar      block_wd, 3
+%endif
+        .w16_loop_height:
         mov         off1q, src1q
         mov         off2q, src2q
         mov      row_idxd, block_wd
 
-        .loop_width:
+        .w16_loop_width:
             movu               m0, [src1q]
             movu               m1, [src2q]
             MIN_MAX_SAD        m1, m0, m2
             pmaddwd            m1, m4
             paddd              m3, m1
 
-            add             src1q, 32
-            add             src2q, 32
+            add             src1q, mmsize
+            add             src2q, mmsize
             dec          row_idxd
-            jg        .loop_width
+            jg    .w16_loop_width
 
         lea         src1q, [off1q + ROWS * MAX_PB_SIZE * 2]
         lea         src2q, [off2q + ROWS * MAX_PB_SIZE * 2]
 
         sub      block_hd, 2
-        jg   .loop_height
+        jg  .w16_loop_height
 
         HORIZ_ADD     xm0, xm3, m3
         movd          eax, xm0
     RET
+%endmacro
+
+; accumulate |src1 - src2| of the five dx positions of one dy into m0 - m4
+%macro DMVR_SAD_ROW 1 ; block_w
+    %assign %%dx 0
+    %rep 5
+    %if %1 * 2 == mmsize
+        movu               m5, [off1q + %%dx * 2]
+        movu               m6, [off2q - %%dx * 2]
+    %elif mmsize == 32
+        movu              xm5, [off1q + %%dx * 2]
+        vinserti128        m5, m5, [off1q + %%dx * 2 + MAX_PB_SIZE * ROWS * 2], 1
+        movu              xm6, [off2q - %%dx * 2]
+        vinserti128        m6, m6, [off2q - %%dx * 2 + MAX_PB_SIZE * ROWS * 2], 1
+    %else
+        ; the right half of a 16 wide row goes to the same sums
+        movu               m5, [off1q + %%dx * 2 + 16]
+        movu               m6, [off2q - %%dx * 2 + 16]
+        psubw              m5, m6
+        pabsw              m5, m5
+        paddw         m %+ %%dx, m5
+        movu               m5, [off1q + %%dx * 2]
+        movu               m6, [off2q - %%dx * 2]
+    %endif
+        psubw              m5, m6
+        pabsw              m5, m5
+        paddw         m %+ %%dx, m5
+    %assign %%dx %%dx+1
+    %endrep
+%endmacro
 
+; store the five sums of m0 - m4 to sad[0..4]
+%macro DMVR_SAD_STORE 0
+    pmaddwd            m0, m7
+    pmaddwd            m1, m7
+    pmaddwd            m2, m7
+    pmaddwd            m3, m7
+    pmaddwd            m4, m7
+    phaddd             m0, m1
+    phaddd             m2, m3
+    phaddd             m0, m2
+%if mmsize == 32
+    vextracti128      xm1, m0, 1
+    paddd             xm0, xm1
+%endif
+    movu         [sadq], xm0
+    HORIZ_ADD         xm0, xm4, m4
+    movd    [sadq + 16], xm0
+%endmacro
+
+%macro DMVR_SAD_LOOP 1 ; block_w
+.w%1_dy:
+    pxor               m0, m0
+    pxor               m1, m1
+    pxor               m2, m2
+    pxor               m3, m3
+    pxor               m4, m4
+    mov             off1q, src1q
+    mov             off2q, src2q
+    mov          row_idxd, block_hd
+.w%1_row:
+    DMVR_SAD_ROW       %1
+%if %1 == 16 || mmsize == 16
+    add             off1q, MAX_PB_SIZE * ROWS * 2
+    add             off2q, MAX_PB_SIZE * ROWS * 2
+    sub          row_idxd, ROWS
+%else
+    add             off1q, 2 * MAX_PB_SIZE * ROWS * 2
+    add             off2q, 2 * MAX_PB_SIZE * ROWS * 2
+    sub          row_idxd, 2 * ROWS
+%endif
+    jg            .w%1_row
+
+    DMVR_SAD_STORE
+    add              sadq, 5 * 4
+    add             src1q, MAX_PB_SIZE * 2
+    sub             src2q, MAX_PB_SIZE * 2
+    dec               dyd
+    jg             .w%1_dy
+    RET
+%endmacro
+
+; void ff_vvc_dmvr_sad_{sse4,avx2}(int *sad, const int16_t *src1, const int16_t *src2, int block_w, int block_h);
+%macro VVC_DMVR_SAD 0
+cglobal vvc_dmvr_sad, 5, 9, 8, sad, src1, src2, block_w, block_h, dy, off1, off2, row_idx
+    lea             src2q, [src2q + (4 * MAX_PB_SIZE + 4) * 2]
+    VPBROADCASTD       m7, [pw_1]
+    mov               dyd, 5
+
+    cmp          block_wd, 16
+    jl               .w8
+    DMVR_SAD_LOOP      16
+.w8:
+    DMVR_SAD_LOOP       8
+%endmacro
+
+%if HAVE_SSE4_EXTERNAL
+INIT_XMM sse4
+VVC_SAD
+VVC_DMVR_SAD
+%endif
+
+%if HAVE_AVX2_EXTERNAL
+INIT_YMM avx2
+VVC_SAD
+VVC_DMVR_SAD
 %endif
 %endif
@@ -27,11 +27,15 @@
 #include "libavutil/x86/cpu.h"
 #include "libavcodec/vvc/dec.h"
 #include "libavcodec/vvc/ctu.h"
+#include "libavcodec/vvc/data.h"
 #include "libavcodec/vvc/dsp.h"
+#include "libavcodec/vvc/intra.h"
 #include "libavcodec/x86/h26x/h2656dsp.h"
 
 #define PUT_PROTOTYPE(name, depth, opt) \
-void ff_vvc_put_ ## name ## _ ## depth ## _##opt(int16_t *dst, const uint8_t *src, ptrdiff_t srcstride, int height, const int8_t *hf, const int8_t *vf, int width);
+void ff_vvc_put_ ## name ## _ ## depth ## _##opt(int16_t *dst, const uint8_t *src, ptrdiff_t srcstride, int height, const int8_t *hf, const int8_t *vf, int width); \
+void ff_vvc_put_uni_w_ ## name ## _ ## depth ## _##opt(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride, \
+    int height, int denom, int wx, int ox, const int8_t *hf, const int8_t *vf, int width);
 
 #define PUT_PROTOTYPES(name, bitd, opt) \
         PUT_PROTOTYPE(name##2,   bitd, opt) \
@@ -57,11 +61,14 @@ void ff_vvc_put_ ## name ## _ ## depth ## _##opt(int16_t *dst, const uint8_t *sr
 
 PUT_BPC_PROTOTYPES(pixels, sse4)
 PUT_BPC_PROTOTYPES(pixels, avx2)
+PUT_BPC_PROTOTYPES(pixels, avx512icl)
 
 PUT_TAP_PROTOTYPES(4, sse4)
 PUT_TAP_PROTOTYPES(8, sse4)
 PUT_TAP_PROTOTYPES(4, avx2)
 PUT_TAP_PROTOTYPES(8, avx2)
+PUT_TAP_PROTOTYPES(4, avx512icl)
+PUT_TAP_PROTOTYPES(8, avx512icl)
 
 #define bf(fn, bd,  opt) fn##_##bd##_##opt
 #define BF(fn, bpc, opt) fn##_##bpc##bpc_##opt
@@ -80,13 +87,40 @@ void bf(ff_vvc_w_avg, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,
     const int16_t *src0, const int16_t *src1, int width, int height,                                 \
     int denom, int w0, int w1, int o0, int o1);
 
+AVG_BPC_PROTOTYPES( 8, sse4)
+AVG_BPC_PROTOTYPES(16, sse4)
 AVG_BPC_PROTOTYPES( 8, avx2)
 AVG_BPC_PROTOTYPES(16, avx2)
 
+AVG_PROTOTYPES( 8, sse4)
+AVG_PROTOTYPES(10, sse4)
+AVG_PROTOTYPES(12, sse4)
 AVG_PROTOTYPES( 8, avx2)
 AVG_PROTOTYPES(10, avx2)
 AVG_PROTOTYPES(12, avx2)
 
+#define ITX_RES_BPC_PROTOTYPES(bpc, opt)                                                             \
+void BF(ff_vvc_add_residual, bpc, opt)(uint8_t *dst, const int *res,                                 \
+    intptr_t width, intptr_t height, ptrdiff_t stride, intptr_t pixel_max);                          \
+void BF(ff_vvc_add_residual_joint, bpc, opt)(uint8_t *dst, const int *res,                           \
+    intptr_t width, intptr_t height, ptrdiff_t stride, intptr_t c_sign, intptr_t shift,              \
+    intptr_t pixel_max);
+
+#define ITX_RES_PROTOTYPES(bd, opt)                                                                  \
+void bf(ff_vvc_add_residual, bd, opt)(uint8_t *dst, const int *res,                                  \
+    int width, int height, ptrdiff_t stride);                                                        \
+void bf(ff_vvc_add_residual_joint, bd, opt)(uint8_t *dst, const int *res,                            \
+    int width, int height, ptrdiff_t stride, int c_sign, int shift);
+
+ITX_RES_BPC_PROTOTYPES( 8, avx2)
+ITX_RES_BPC_PROTOTYPES(16, avx2)
+
+ITX_RES_PROTOTYPES( 8, avx2)
+ITX_RES_PROTOTYPES(10, avx2)
+ITX_RES_PROTOTYPES(12, avx2)
+
+void ff_vvc_pred_residual_joint_avx2(int *buf, intptr_t width, intptr_t height, intptr_t c_sign, intptr_t shift);
+
 #define ALF_BPC_PROTOTYPES(bpc, opt)                                                                                     \
 void BF(ff_vvc_alf_filter_luma, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride,                                            \
     const uint8_t *src, ptrdiff_t src_stride, ptrdiff_t width, ptrdiff_t height,                                         \
@@ -98,6 +132,9 @@ void BF(ff_vvc_alf_classify_grad, bpc, opt)(int *gradient_sum,
     const uint8_t *src, ptrdiff_t src_stride, intptr_t width, intptr_t height, intptr_t vb_pos);                         \
 void BF(ff_vvc_alf_classify, bpc, opt)(int *class_idx, int *transpose_idx, const int *gradient_sum,                      \
     intptr_t width, intptr_t height, intptr_t vb_pos, intptr_t bit_depth);                                               \
+void BF(ff_vvc_alf_filter_cc, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *luma, ptrdiff_t luma_stride, \
+    intptr_t width, intptr_t height, intptr_t hs, intptr_t vs, const int16_t *filter, intptr_t vb_pos,                   \
+    ptrdiff_t pixel_max);                                                                                                \
 
 #define ALF_PROTOTYPES(bpc, bd, opt)                                                                                     \
 void bf(ff_vvc_alf_filter_luma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,   \
@@ -106,23 +143,96 @@ void bf(ff_vvc_alf_filter_chroma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, c
     int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos);                                \
 void bf(ff_vvc_alf_classify, bd, opt)(int *class_idx, int *transpose_idx,                                                \
     const uint8_t *src, ptrdiff_t src_stride, int width, int height, int vb_pos, int *gradient_tmp);                     \
+void bf(ff_vvc_alf_filter_cc, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *luma, ptrdiff_t luma_stride,   \
+    int width, int height, int hs, int vs, const int16_t *filter, int vb_pos);                                           \
 
+ALF_BPC_PROTOTYPES(8,  sse4)
+ALF_BPC_PROTOTYPES(16, sse4)
 ALF_BPC_PROTOTYPES(8,  avx2)
 ALF_BPC_PROTOTYPES(16, avx2)
+ALF_BPC_PROTOTYPES(8,  avx512icl)
+ALF_BPC_PROTOTYPES(16, avx512icl)
 
+ALF_PROTOTYPES(8,  8,  sse4)
+ALF_PROTOTYPES(16, 10, sse4)
+ALF_PROTOTYPES(16, 12, sse4)
 ALF_PROTOTYPES(8,  8,  avx2)
 ALF_PROTOTYPES(16, 10, avx2)
 ALF_PROTOTYPES(16, 12, avx2)
 
+#define UNI_W_BPC_PROTOTYPES(bpc, opt)                                                              \
+void BF(ff_vvc_put_uni_w, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,          \
+    intptr_t width, intptr_t height, intptr_t denom, intptr_t wx, intptr_t ox, intptr_t pixel_max);
+
+UNI_W_BPC_PROTOTYPES( 8, sse4)
+UNI_W_BPC_PROTOTYPES(16, sse4)
+UNI_W_BPC_PROTOTYPES( 8, avx2)
+UNI_W_BPC_PROTOTYPES(16, avx2)
+
+#define UNI_W_FUNCS(bpc, bd, opt)                                                                   \
+static void bf(vvc_put_uni_w, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,      \
+    int width, int height, int denom, int wx, int ox)                                               \
+{                                                                                                   \
+    BF(ff_vvc_put_uni_w, bpc, opt)(dst, dst_stride, src, width, height, denom, wx, ox,              \
+        (1 << bd) - 1);                                                                             \
+}
+
+#define AVG_FUNCS(bpc, bd, opt)                                                                     \
+void bf(ff_vvc_avg, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                                    \
+    const int16_t *src0, const int16_t *src1, int width, int height)                                \
+{                                                                                                   \
+    BF(ff_vvc_avg, bpc, opt)(dst, dst_stride, src0, src1, width, height, (1 << bd)  - 1);           \
+}                                                                                                   \
+void bf(ff_vvc_w_avg, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                                  \
+    const int16_t *src0, const int16_t *src1, int width, int height,                                \
+    int denom, int w0, int w1, int o0, int o1)                                                      \
+{                                                                                                   \
+    BF(ff_vvc_w_avg, bpc, opt)(dst, dst_stride, src0, src1, width, height,                          \
+        denom, w0, w1, o0, o1, (1 << bd)  - 1);                                                     \
+}
+
+#define ALF_FUNCS(bpc, bd, opt)                                                                                          \
+void bf(ff_vvc_alf_filter_luma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,   \
+    int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                                 \
+{                                                                                                                        \
+    const int param_stride  = (width >> 2) * ALF_NUM_COEFF_LUMA;                                                         \
+    BF(ff_vvc_alf_filter_luma, bpc, opt)(dst, dst_stride, src, src_stride, width, height,                                \
+        filter, clip, param_stride, vb_pos, (1 << bd)  - 1);                                                             \
+}                                                                                                                        \
+void bf(ff_vvc_alf_filter_chroma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride, \
+    int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                                 \
+{                                                                                                                        \
+    BF(ff_vvc_alf_filter_chroma, bpc, opt)(dst, dst_stride, src, src_stride, width, height,                              \
+        filter, clip, 0, vb_pos,(1 << bd)  - 1);                                                                         \
+}                                                                                                                        \
+void bf(ff_vvc_alf_classify, bd, opt)(int *class_idx, int *transpose_idx,                                                \
+    const uint8_t *src, ptrdiff_t src_stride, int width, int height, int vb_pos, int *gradient_tmp)                      \
+{                                                                                                                        \
+    BF(ff_vvc_alf_classify_grad, bpc, opt)(gradient_tmp, src, src_stride, width, height, vb_pos);                        \
+    BF(ff_vvc_alf_classify, bpc, opt)(class_idx, transpose_idx, gradient_tmp, width, height, vb_pos, bd);                \
+}
+
 #if ARCH_X86_64
 #if HAVE_SSE4_EXTERNAL
-#define FW_PUT(name, depth, opt) \
+// put_uni_w is put into an intermediate buffer followed by the weighting
+#define FW_PUT_W(name, depth, opt, w_opt) \
 void ff_vvc_put_ ## name ## _ ## depth ## _##opt(int16_t *dst, const uint8_t *src, ptrdiff_t srcstride,        \
                                                  int height, const int8_t *hf, const int8_t *vf, int width)    \
 {                                                                                                              \
     ff_h2656_put_## name ## _ ## depth ## _##opt(dst, 2 * MAX_PB_SIZE, src, srcstride, height, hf, vf, width); \
+}                                                                                                              \
+void ff_vvc_put_uni_w_ ## name ## _ ## depth ## _##opt(uint8_t *dst, ptrdiff_t dst_stride,                    \
+    const uint8_t *src, ptrdiff_t src_stride, int height, int denom, int wx, int ox,                           \
+    const int8_t *hf, const int8_t *vf, int width)                                                             \
+{                                                                                                              \
+    DECLARE_ALIGNED(32, int16_t, tmp)[MAX_PB_SIZE * MAX_PB_SIZE];                                              \
+                                                                                                               \
+    ff_vvc_put_ ## name ## _ ## depth ## _##opt(tmp, src, src_stride, height, hf, vf, width);                  \
+    vvc_put_uni_w_ ## depth ## _##w_opt(dst, dst_stride, tmp, width, height, denom, wx, ox);                   \
 }
 
+#define FW_PUT(name, depth, opt) FW_PUT_W(name, depth, opt, opt)
+
 #define FW_PUT_TAP(fname, bitd, opt ) \
     FW_PUT(fname##4,   bitd, opt )    \
     FW_PUT(fname##8,   bitd, opt )    \
@@ -150,12 +260,28 @@ void ff_vvc_put_ ## name ## _ ## depth ## _##opt(int16_t *dst, const uint8_t *sr
     FW_PUT_4TAP_SSE4(bitd) \
     FW_PUT_8TAP_SSE4(bitd)
 
+UNI_W_FUNCS(8,  8,  sse4)
+UNI_W_FUNCS(16, 10, sse4)
+UNI_W_FUNCS(16, 12, sse4)
+
 FW_PUT_SSE4( 8)
 FW_PUT_SSE4(10)
 FW_PUT_SSE4(12)
+
+AVG_FUNCS(8,  8,  sse4)
+AVG_FUNCS(16, 10, sse4)
+AVG_FUNCS(16, 12, sse4)
+
+ALF_FUNCS(8,  8,  sse4)
+ALF_FUNCS(16, 10, sse4)
+ALF_FUNCS(16, 12, sse4)
 #endif
 
 #if HAVE_AVX2_EXTERNAL
+UNI_W_FUNCS(8,  8,  avx2)
+UNI_W_FUNCS(16, 10, avx2)
+UNI_W_FUNCS(16, 12, avx2)
+
 #define FW_PUT_TAP_AVX2(n, bitd)        \
     FW_PUT(n ## tap_h32,   bitd, avx2)  \
     FW_PUT(n ## tap_h64,   bitd, avx2)  \
@@ -191,54 +317,358 @@ FW_PUT_AVX2(12)
 FW_PUT_16BPC_AVX2(10)
 FW_PUT_16BPC_AVX2(12)
 
-#define AVG_FUNCS(bpc, bd, opt)                                                                     \
-void bf(ff_vvc_avg, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                                    \
-    const int16_t *src0, const int16_t *src1, int width, int height)                                \
+AVG_FUNCS(8,  8,  avx2)
+AVG_FUNCS(16, 10, avx2)
+AVG_FUNCS(16, 12, avx2)
+
+#define ITX_RES_FUNCS(bpc, bd, opt)                                                                 \
+void bf(ff_vvc_add_residual, bd, opt)(uint8_t *dst, const int *res,                                 \
+    int width, int height, ptrdiff_t stride)                                                        \
 {                                                                                                   \
-    BF(ff_vvc_avg, bpc, opt)(dst, dst_stride, src0, src1, width, height, (1 << bd)  - 1);           \
+    BF(ff_vvc_add_residual, bpc, opt)(dst, res, width, height, stride, (1 << bd) - 1);              \
 }                                                                                                   \
-void bf(ff_vvc_w_avg, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                                  \
-    const int16_t *src0, const int16_t *src1, int width, int height,                                \
-    int denom, int w0, int w1, int o0, int o1)                                                      \
+void bf(ff_vvc_add_residual_joint, bd, opt)(uint8_t *dst, const int *res,                           \
+    int width, int height, ptrdiff_t stride, int c_sign, int shift)                                 \
 {                                                                                                   \
-    BF(ff_vvc_w_avg, bpc, opt)(dst, dst_stride, src0, src1, width, height,                          \
-        denom, w0, w1, o0, o1, (1 << bd)  - 1);                                                     \
+    BF(ff_vvc_add_residual_joint, bpc, opt)(dst, res, width, height, stride,                        \
+        c_sign, shift, (1 << bd) - 1);                                                              \
 }
 
-AVG_FUNCS(8,  8,  avx2)
-AVG_FUNCS(16, 10, avx2)
-AVG_FUNCS(16, 12, avx2)
+ITX_RES_FUNCS(8,  8,  avx2)
+ITX_RES_FUNCS(16, 10, avx2)
+ITX_RES_FUNCS(16, 12, avx2)
 
-#define ALF_FUNCS(bpc, bd, opt)                                                                                          \
-void bf(ff_vvc_alf_filter_luma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,   \
-    int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                                 \
+#define ALF_CC_FUNCS(bpc, bd, opt)                                                                                       \
+void bf(ff_vvc_alf_filter_cc, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *luma, ptrdiff_t luma_stride,   \
+    int width, int height, int hs, int vs, const int16_t *filter, int vb_pos)                                            \
 {                                                                                                                        \
-    const int param_stride  = (width >> 2) * ALF_NUM_COEFF_LUMA;                                                         \
-    BF(ff_vvc_alf_filter_luma, bpc, opt)(dst, dst_stride, src, src_stride, width, height,                                \
-        filter, clip, param_stride, vb_pos, (1 << bd)  - 1);                                                             \
-}                                                                                                                        \
-void bf(ff_vvc_alf_filter_chroma, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride, \
-    int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                                 \
-{                                                                                                                        \
-    BF(ff_vvc_alf_filter_chroma, bpc, opt)(dst, dst_stride, src, src_stride, width, height,                              \
-        filter, clip, 0, vb_pos,(1 << bd)  - 1);                                                                         \
-}                                                                                                                        \
-void bf(ff_vvc_alf_classify, bd, opt)(int *class_idx, int *transpose_idx,                                                \
-    const uint8_t *src, ptrdiff_t src_stride, int width, int height, int vb_pos, int *gradient_tmp)                      \
-{                                                                                                                        \
-    BF(ff_vvc_alf_classify_grad, bpc, opt)(gradient_tmp, src, src_stride, width, height, vb_pos);                        \
-    BF(ff_vvc_alf_classify, bpc, opt)(class_idx, transpose_idx, gradient_tmp, width, height, vb_pos, bd);                \
-}                                                                                                                        \
+    BF(ff_vvc_alf_filter_cc, bpc, opt)(dst, dst_stride, luma, luma_stride, width, height,                                \
+        hs, vs, filter, vb_pos, (1 << bd) - 1);                                                                          \
+}
 
 ALF_FUNCS(8,  8,  avx2)
 ALF_FUNCS(16, 10, avx2)
 ALF_FUNCS(16, 12, avx2)
+ALF_CC_FUNCS(8,  8,  avx2)
+ALF_CC_FUNCS(16, 10, avx2)
+ALF_CC_FUNCS(16, 12, avx2)
 
 #endif
 
-#define PEL_LINK(dst, C, W, idx1, idx2, name, D, opt)                              \
-    dst[C][W][idx1][idx2] = ff_vvc_put_## name ## _ ## D ## _##opt;                \
-    dst ## _uni[C][W][idx1][idx2] = ff_h2656_put_uni_ ## name ## _ ## D ## _##opt; \
+#define BDOF_BPC_PROTOTYPES(bpc, opt)                                                               \
+void BF(ff_vvc_apply_bdof, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride,                            \
+    int16_t *src0, int16_t *src1, int block_w, int block_h, intptr_t pixel_max);                    \
+void BF(ff_vvc_bdof_fetch_samples, bpc, opt)(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride, \
+    int x_frac, int y_frac, int width, int height, intptr_t pixel_max);
+
+BDOF_BPC_PROTOTYPES( 8, avx2)
+BDOF_BPC_PROTOTYPES(16, avx2)
+
+#define BDOF_FUNCS(bpc, bd, opt)                                                                    \
+static void bf(vvc_apply_bdof, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                         \
+    int16_t *src0, int16_t *src1, int block_w, int block_h)                                         \
+{                                                                                                   \
+    BF(ff_vvc_apply_bdof, bpc, opt)(dst, dst_stride, src0, src1, block_w, block_h, (1 << bd) - 1);  \
+}                                                                                                   \
+static void bf(vvc_bdof_fetch_samples, bd, opt)(int16_t *dst, const uint8_t *src,                   \
+    ptrdiff_t src_stride, int x_frac, int y_frac, int width, int height)                            \
+{                                                                                                   \
+    BF(ff_vvc_bdof_fetch_samples, bpc, opt)(dst, src, src_stride, x_frac, y_frac,                   \
+        width, height, (1 << bd) - 1);                                                              \
+}
+
+BDOF_FUNCS(8,  8,  avx2)
+BDOF_FUNCS(16, 10, avx2)
+BDOF_FUNCS(16, 12, avx2)
+
+void ff_vvc_apply_prof_avx2(int16_t *dst, const int16_t *src, const int16_t *diff_mv_x, const int16_t *diff_mv_y);
+
+#define PROF_BPC_PROTOTYPES(bpc, opt)                                                               \
+void BF(ff_vvc_apply_prof_uni, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,    \
+    const int16_t *diff_mv_x, const int16_t *diff_mv_y, intptr_t pixel_max);                        \
+void BF(ff_vvc_apply_prof_uni_w, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,  \
+    const int16_t *diff_mv_x, const int16_t *diff_mv_y, int denom, int wx, int ox, intptr_t pixel_max);
+
+PROF_BPC_PROTOTYPES( 8, avx2)
+PROF_BPC_PROTOTYPES(16, avx2)
+
+#define PROF_FUNCS(bpc, bd, opt)                                                                    \
+static void bf(vvc_apply_prof_uni, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src, \
+    const int16_t *diff_mv_x, const int16_t *diff_mv_y)                                             \
+{                                                                                                   \
+    BF(ff_vvc_apply_prof_uni, bpc, opt)(dst, dst_stride, src, diff_mv_x, diff_mv_y, (1 << bd) - 1); \
+}                                                                                                   \
+static void bf(vvc_apply_prof_uni_w, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,                   \
+    const int16_t *src, const int16_t *diff_mv_x, const int16_t *diff_mv_y,                         \
+    int denom, int wx, int ox)                                                                      \
+{                                                                                                   \
+    BF(ff_vvc_apply_prof_uni_w, bpc, opt)(dst, dst_stride, src, diff_mv_x, diff_mv_y,               \
+        denom, wx, ox, (1 << bd) - 1);                                                              \
+}
+
+PROF_FUNCS(8,  8,  avx2)
+PROF_FUNCS(16, 10, avx2)
+PROF_FUNCS(16, 12, avx2)
+
+#define DMVR_PROTOTYPE(fn, bpc, opt)                                                                \
+void BF(ff_vvc_##fn, bpc, opt)(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride,              \
+    int height, intptr_t mx, intptr_t my, int width, intptr_t pixel_max);
+
+#define DMVR_BPC_PROTOTYPES(bpc, opt)                                                               \
+    DMVR_PROTOTYPE(dmvr,    bpc, opt)                                                               \
+    DMVR_PROTOTYPE(dmvr_h,  bpc, opt)                                                               \
+    DMVR_PROTOTYPE(dmvr_v,  bpc, opt)                                                               \
+    DMVR_PROTOTYPE(dmvr_hv, bpc, opt)
+
+DMVR_BPC_PROTOTYPES( 8, avx2)
+DMVR_BPC_PROTOTYPES(16, avx2)
+
+#define DMVR_FUNC(fn, bpc, bd, opt)                                                                 \
+static void bf(vvc_##fn, bd, opt)(int16_t *dst, const uint8_t *src, ptrdiff_t src_stride,           \
+    int height, intptr_t mx, intptr_t my, int width)                                                \
+{                                                                                                   \
+    BF(ff_vvc_##fn, bpc, opt)(dst, src, src_stride, height, mx, my, width, (1 << bd) - 1);          \
+}
+
+#define DMVR_FUNCS(bpc, bd, opt)                                                                    \
+    DMVR_FUNC(dmvr,    bpc, bd, opt)                                                                \
+    DMVR_FUNC(dmvr_h,  bpc, bd, opt)                                                                \
+    DMVR_FUNC(dmvr_v,  bpc, bd, opt)                                                                \
+    DMVR_FUNC(dmvr_hv, bpc, bd, opt)
+
+DMVR_FUNCS(8,  8,  avx2)
+DMVR_FUNCS(16, 10, avx2)
+DMVR_FUNCS(16, 12, avx2)
+
+#define BLEND_BPC_PROTOTYPES(bpc, opt)                                                              \
+void BF(ff_vvc_put_gpm, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, int width, int height,        \
+    const int16_t *src0, const int16_t *src1, const uint8_t *weights, int step_x, int step_y,       \
+    intptr_t pixel_max);                                                                            \
+void BF(ff_vvc_put_ciip, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, int width, int height,       \
+    const uint8_t *inter, ptrdiff_t inter_stride, int intra_weight);
+
+BLEND_BPC_PROTOTYPES( 8, avx2)
+BLEND_BPC_PROTOTYPES(16, avx2)
+
+#define BLEND_FUNCS(bpc, bd, opt)                                                                   \
+static void bf(vvc_put_gpm, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride, int width, int height,     \
+    const int16_t *src0, const int16_t *src1, const uint8_t *weights, int step_x, int step_y)       \
+{                                                                                                   \
+    BF(ff_vvc_put_gpm, bpc, opt)(dst, dst_stride, width, height, src0, src1, weights,               \
+        step_x, step_y, (1 << bd) - 1);                                                             \
+}
+
+BLEND_FUNCS(8,  8,  avx2)
+BLEND_FUNCS(16, 10, avx2)
+BLEND_FUNCS(16, 12, avx2)
+
+#define SCALED_BPC_PROTOTYPES(name, bpc, opt)                                                       \
+void BF(ff_vvc_put_scaled_h_##name, bpc, opt)(int16_t *tmp, const uint8_t *src,                     \
+    ptrdiff_t src_stride, int height, const int *pos, const int8_t *filters, int width,             \
+    intptr_t pixel_max);                                                                            \
+void BF(ff_vvc_put_uni_scaled_v_##name, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride,               \
+    const int16_t *tmp, const int *pos, const int8_t *filters, int width, int height,               \
+    intptr_t pixel_max);                                                                            \
+void BF(ff_vvc_put_uni_w_scaled_v_##name, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride,             \
+    const int16_t *tmp, const int *pos, const int8_t *filters, int width, int height,               \
+    int denom, int wx, int ox, intptr_t pixel_max);
+
+#define SCALED_PROTOTYPES(name, opt)                                                                \
+void ff_vvc_put_scaled_v_##name##_##opt(int16_t *dst, ptrdiff_t dst_stride, const int16_t *tmp,     \
+    const int *pos, const int8_t *filters, int width, int height);                                  \
+SCALED_BPC_PROTOTYPES(name,  8, opt)                                                                \
+SCALED_BPC_PROTOTYPES(name, 16, opt)
+
+SCALED_PROTOTYPES(luma,   avx2)
+SCALED_PROTOTYPES(chroma, avx2)
+
+typedef void (*scaled_h_fn)(int16_t *tmp, const uint8_t *src, ptrdiff_t src_stride, int height,
+    const int *pos, const int8_t *filters, int width, intptr_t pixel_max);
+
+#define SCALED_TMP_SIZE (EDGE_EMU_BUFFER_STRIDE_SCALED * MAX_PB_SIZE)
+
+// resolve the integer offset and the filter of each output column or row, padded to 16 entries
+static void scaled_positions(int *pos, int8_t *filters, const int start, const int step, const int n,
+    const int8_t *f, const int is_chroma)
+{
+    const int taps   = is_chroma ? VVC_INTER_CHROMA_TAPS : VVC_INTER_LUMA_TAPS;
+    const int shift1 = 6 - is_chroma;
+    const int shift2 = 4 + is_chroma;
+
+    for (int i = 0; i < FFALIGN(n, 16); i++) {
+        const int t = start + step * FFMIN(i, n - 1);
+        pos[i] = SCALED_INT(t) - SCALED_INT(start);
+        memcpy(filters + i * taps, f + av_mod_uintp2(t >> shift1, shift2) * taps, taps);
+    }
+}
+
+// horizontal pass into tmp, leaves the vertical positions and filters in pos_y and vfilters
+static av_always_inline void scaled_h(const scaled_h_fn h, int16_t *tmp, int *pos_y, int8_t *vfilters,
+    const uint8_t *src, const ptrdiff_t src_stride, const int src_height, const int x, const int y,
+    const int dx, const int dy, const int height, const int8_t *hf, const int8_t *vf, const int width,
+    const int is_chroma, const int bd)
+{
+    const int extra_before = is_chroma ? CHROMA_EXTRA_BEFORE : LUMA_EXTRA_BEFORE;
+    const int extra        = is_chroma ? CHROMA_EXTRA : LUMA_EXTRA;
+    DECLARE_ALIGNED(32, int8_t, hfilters)[MAX_PB_SIZE * VVC_INTER_LUMA_TAPS];
+    int pos_x[MAX_PB_SIZE];
+
+    scaled_positions(pos_x, hfilters, x, dx, width, hf, is_chroma);
+    scaled_positions(pos_y, vfilters, y, dy, height, vf, is_chroma);
+    h(tmp, src - extra_before * src_stride - (extra_before << (bd > 8)), src_stride, src_height + extra,
+        pos_x, hfilters, FFALIGN(width, 16), (1 << bd) - 1);
+}
+
+#define SCALED_FUNC(name, is_chroma, bpc, bd, opt)                                                  \
+static void bf(vvc_put_##name##_scaled, bd, opt)(int16_t *dst,                                      \
+    const uint8_t *src, ptrdiff_t src_stride, int src_height, int x, int y, int dx, int dy,         \
+    int height, const int8_t *hf, const int8_t *vf, int width)                                      \
+{                                                                                                   \
+    DECLARE_ALIGNED(32, int16_t, tmp)[SCALED_TMP_SIZE];                                             \
+    DECLARE_ALIGNED(32, int8_t, vfilters)[MAX_PB_SIZE * VVC_INTER_LUMA_TAPS];                       \
+    int pos_y[MAX_PB_SIZE];                                                                         \
+                                                                                                    \
+    scaled_h(BF(ff_vvc_put_scaled_h_##name, bpc, opt), tmp, pos_y, vfilters, src, src_stride,       \
+        src_height, x, y, dx, dy, height, hf, vf, width, is_chroma, bd);                            \
+    ff_vvc_put_scaled_v_##name##_##opt(dst, MAX_PB_SIZE * sizeof(int16_t), tmp, pos_y, vfilters,    \
+        width, height);                                                                             \
+}                                                                                                   \
+                                                                                                    \
+static void bf(vvc_put_uni_##name##_scaled, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,            \
+    const uint8_t *src, ptrdiff_t src_stride, int src_height, int x, int y, int dx, int dy,         \
+    int height, const int8_t *hf, const int8_t *vf, int width)                                      \
+{                                                                                                   \
+    DECLARE_ALIGNED(32, int16_t, tmp)[SCALED_TMP_SIZE];                                             \
+    DECLARE_ALIGNED(32, int8_t, vfilters)[MAX_PB_SIZE * VVC_INTER_LUMA_TAPS];                       \
+    int pos_y[MAX_PB_SIZE];                                                                         \
+                                                                                                    \
+    scaled_h(BF(ff_vvc_put_scaled_h_##name, bpc, opt), tmp, pos_y, vfilters, src, src_stride,       \
+        src_height, x, y, dx, dy, height, hf, vf, width, is_chroma, bd);                            \
+    BF(ff_vvc_put_uni_scaled_v_##name, bpc, opt)(dst, dst_stride, tmp, pos_y, vfilters,             \
+        width, height, (1 << bd) - 1);                                                              \
+}                                                                                                   \
+                                                                                                    \
+static void bf(vvc_put_uni_##name##_w_scaled, bd, opt)(uint8_t *dst, ptrdiff_t dst_stride,          \
+    const uint8_t *src, ptrdiff_t src_stride, int src_height, int x, int y, int dx, int dy,         \
+    int height, int denom, int wx, int ox, const int8_t *hf, const int8_t *vf, int width)           \
+{                                                                                                   \
+    DECLARE_ALIGNED(32, int16_t, tmp)[SCALED_TMP_SIZE];                                             \
+    DECLARE_ALIGNED(32, int8_t, vfilters)[MAX_PB_SIZE * VVC_INTER_LUMA_TAPS];                       \
+    int pos_y[MAX_PB_SIZE];                                                                         \
+                                                                                                    \
+    scaled_h(BF(ff_vvc_put_scaled_h_##name, bpc, opt), tmp, pos_y, vfilters, src, src_stride,       \
+        src_height, x, y, dx, dy, height, hf, vf, width, is_chroma, bd);                            \
+    BF(ff_vvc_put_uni_w_scaled_v_##name, bpc, opt)(dst, dst_stride, tmp, pos_y, vfilters,           \
+        width, height, denom, wx, ox, (1 << bd) - 1);                                               \
+}
+
+#define SCALED_FUNCS(bpc, bd, opt)                                                                  \
+    SCALED_FUNC(luma,   0, bpc, bd, opt)                                                            \
+    SCALED_FUNC(chroma, 1, bpc, bd, opt)
+
+SCALED_FUNCS(8,  8,  avx2)
+SCALED_FUNCS(16, 10, avx2)
+SCALED_FUNCS(16, 12, avx2)
+
+static void vvc_pred_residual_joint_avx2(int *buf, int width, int height, int c_sign, int shift)
+{
+    ff_vvc_pred_residual_joint_avx2(buf, width, height, c_sign, shift);
+}
+
+#define LMCS_BPC_PROTOTYPES(bpc, opt)                                                               \
+void BF(ff_vvc_lmcs_filter_luma, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride,                      \
+    int width, int height, const void *lut);
+
+LMCS_BPC_PROTOTYPES( 8, avx2)
+LMCS_BPC_PROTOTYPES(16, avx2)
+
+void ff_vvc_lmcs_scale_chroma_avx2(int *dst, const int *coeff, intptr_t size, intptr_t chroma_scale,
+    intptr_t pixel_max);
+
+#define LMCS_FUNCS(bd, opt)                                                                         \
+static void bf(vvc_lmcs_scale_chroma, bd, opt)(int *dst, const int *coeff,                          \
+    int width, int height, int chroma_scale)                                                        \
+{                                                                                                   \
+    ff_vvc_lmcs_scale_chroma_##opt(dst, coeff, width * height, chroma_scale, (1 << bd) - 1);        \
+}
+
+LMCS_FUNCS(8,  avx2)
+LMCS_FUNCS(10, avx2)
+LMCS_FUNCS(12, avx2)
+
+#if HAVE_AVX512ICL_EXTERNAL
+// the zmm filters work on 32 pixels, the remaining 4 to 28 columns at the right picture edge go to avx2
+#define ALF_FUNCS_AVX512ICL(bpc, bd)                                                                                           \
+static void bf(vvc_alf_filter_luma, bd, avx512icl)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src,                     \
+    ptrdiff_t src_stride, int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                 \
+{                                                                                                                              \
+    const int param_stride  = (width >> 2) * ALF_NUM_COEFF_LUMA;                                                               \
+    const int w32           = width & ~31;                                                                                     \
+    const int param_offset  = (w32 >> 2) * ALF_NUM_COEFF_LUMA;                                                                 \
+    if (w32)                                                                                                                   \
+        BF(ff_vvc_alf_filter_luma, bpc, avx512icl)(dst, dst_stride, src, src_stride, w32, height,                              \
+            filter, clip, param_stride, vb_pos, (1 << bd) - 1);                                                                \
+    if (width > w32)                                                                                                           \
+        BF(ff_vvc_alf_filter_luma, bpc, avx2)(dst + w32 * (bpc / 8), dst_stride, src + w32 * (bpc / 8), src_stride,            \
+            width - w32, height, filter + param_offset, clip + param_offset, param_stride, vb_pos, (1 << bd) - 1);             \
+}                                                                                                                              \
+static void bf(vvc_alf_filter_chroma, bd, avx512icl)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src,                   \
+    ptrdiff_t src_stride, int width, int height, const int16_t *filter, const int16_t *clip, const int vb_pos)                 \
+{                                                                                                                              \
+    const int w32           = width & ~31;                                                                                     \
+    if (w32)                                                                                                                   \
+        BF(ff_vvc_alf_filter_chroma, bpc, avx512icl)(dst, dst_stride, src, src_stride, w32, height,                            \
+            filter, clip, 0, vb_pos, (1 << bd) - 1);                                                                           \
+    if (width > w32)                                                                                                           \
+        BF(ff_vvc_alf_filter_chroma, bpc, avx2)(dst + w32 * (bpc / 8), dst_stride, src + w32 * (bpc / 8), src_stride,          \
+            width - w32, height, filter, clip, 0, vb_pos, (1 << bd) - 1);                                                      \
+}
+
+ALF_FUNCS_AVX512ICL(8,  8)
+ALF_FUNCS_AVX512ICL(16, 10)
+ALF_FUNCS_AVX512ICL(16, 12)
+#endif
+
+#if HAVE_AVX512ICL_EXTERNAL
+// the weighting of put_uni_w is shared with AVX2
+#define FW_PUT_AVX512ICL(name, bitd) FW_PUT_W(name, bitd, avx512icl, avx2)
+
+#define FW_PUT_TAP_AVX512ICL(n, bitd)            \
+    FW_PUT_AVX512ICL(n ## tap_h64,   bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_h128,  bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_v64,   bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_v128,  bitd)
+
+#define FW_PUT_8BPC_AVX512ICL(bitd)              \
+    FW_PUT_AVX512ICL(pixels64,  bitd)            \
+    FW_PUT_AVX512ICL(pixels128, bitd)            \
+    FW_PUT_TAP_AVX512ICL(4, bitd)                \
+    FW_PUT_TAP_AVX512ICL(8, bitd)
+
+#define FW_PUT_TAP_16BPC_AVX512ICL(n, bitd)      \
+    FW_PUT_AVX512ICL(n ## tap_h32,   bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_v32,   bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_hv32,  bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_hv64,  bitd)       \
+    FW_PUT_AVX512ICL(n ## tap_hv128, bitd)       \
+    FW_PUT_TAP_AVX512ICL(n, bitd)
+
+#define FW_PUT_16BPC_AVX512ICL(bitd)             \
+    FW_PUT_AVX512ICL(pixels32,  bitd)            \
+    FW_PUT_AVX512ICL(pixels64,  bitd)            \
+    FW_PUT_AVX512ICL(pixels128, bitd)            \
+    FW_PUT_TAP_16BPC_AVX512ICL(4, bitd)          \
+    FW_PUT_TAP_16BPC_AVX512ICL(8, bitd)
+
+FW_PUT_8BPC_AVX512ICL(8)
+FW_PUT_16BPC_AVX512ICL(10)
+FW_PUT_16BPC_AVX512ICL(12)
+#endif
+
+#define PEL_LINK(dst, C, W, idx1, idx2, name, D, opt)                               \
+    dst[C][W][idx1][idx2] = ff_vvc_put_## name ## _ ## D ## _##opt;                 \
+    dst ## _uni[C][W][idx1][idx2] = ff_h2656_put_uni_ ## name ## _ ## D ## _##opt;  \
+    dst ## _uni_w[C][W][idx1][idx2] = ff_vvc_put_uni_w_ ## name ## _ ## D ## _##opt; \
 
 #define MC_TAP_LINKS(pointer, C, my, mx, fname, bitd, opt )          \
     PEL_LINK(pointer, C, 1, my , mx , fname##4 ,  bitd, opt );       \
@@ -301,19 +731,455 @@ ALF_FUNCS(16, 12, avx2)
     MC_TAP_LINKS_16BPC_AVX2(LUMA,   8, bd);                          \
     MC_TAP_LINKS_16BPC_AVX2(CHROMA, 4, bd);
 
+#define MC_TAP_LINKS_AVX512ICL(C, tap, bd) do {                           \
+        PEL_LINK(c->inter.put, C, 5, 0, 0, pixels64,      bd, avx512icl)  \
+        PEL_LINK(c->inter.put, C, 6, 0, 0, pixels128,     bd, avx512icl)  \
+        PEL_LINK(c->inter.put, C, 5, 0, 1, tap##tap_h64,  bd, avx512icl)  \
+        PEL_LINK(c->inter.put, C, 6, 0, 1, tap##tap_h128, bd, avx512icl)  \
+        PEL_LINK(c->inter.put, C, 5, 1, 0, tap##tap_v64,  bd, avx512icl)  \
+        PEL_LINK(c->inter.put, C, 6, 1, 0, tap##tap_v128, bd, avx512icl)  \
+    } while (0)
+
+#define MC_LINKS_AVX512ICL(bd)                                            \
+    MC_TAP_LINKS_AVX512ICL(LUMA,   8, bd);                                \
+    MC_TAP_LINKS_AVX512ICL(CHROMA, 4, bd);
+
+#define MC_TAP_LINKS_16BPC_AVX512ICL(C, tap, bd) do {                     \
+        PEL_LINK(c->inter.put, C, 4, 0, 0, pixels32,       bd, avx512icl) \
+        PEL_LINK(c->inter.put, C, 4, 0, 1, tap##tap_h32,   bd, avx512icl) \
+        PEL_LINK(c->inter.put, C, 4, 1, 0, tap##tap_v32,   bd, avx512icl) \
+        PEL_LINK(c->inter.put, C, 4, 1, 1, tap##tap_hv32,  bd, avx512icl) \
+        PEL_LINK(c->inter.put, C, 5, 1, 1, tap##tap_hv64,  bd, avx512icl) \
+        PEL_LINK(c->inter.put, C, 6, 1, 1, tap##tap_hv128, bd, avx512icl) \
+    } while (0)
+
+#define MC_LINKS_16BPC_AVX512ICL(bd)                                      \
+    MC_LINKS_AVX512ICL(bd)                                                \
+    MC_TAP_LINKS_16BPC_AVX512ICL(LUMA,   8, bd);                          \
+    MC_TAP_LINKS_16BPC_AVX512ICL(CHROMA, 4, bd);
+
 #define AVG_INIT(bd, opt) do {                                       \
     c->inter.avg    = bf(ff_vvc_avg, bd, opt);                       \
     c->inter.w_avg  = bf(ff_vvc_w_avg, bd, opt);                     \
 } while (0)
 
-#define ALF_INIT(bd) do {                                            \
-    c->alf.filter[LUMA]   = ff_vvc_alf_filter_luma_##bd##_avx2;      \
-    c->alf.filter[CHROMA] = ff_vvc_alf_filter_chroma_##bd##_avx2;    \
-    c->alf.classify       = ff_vvc_alf_classify_##bd##_avx2;         \
+#define BDOF_INIT(bd, opt) do {                                          \
+    c->inter.apply_bdof         = bf(vvc_apply_bdof, bd, opt);           \
+    c->inter.bdof_fetch_samples = bf(vvc_bdof_fetch_samples, bd, opt);   \
+} while (0)
+
+#define PROF_INIT(bd, opt) do {                                          \
+    c->inter.apply_prof         = ff_vvc_apply_prof_##opt;               \
+    c->inter.apply_prof_uni     = bf(vvc_apply_prof_uni, bd, opt);       \
+    c->inter.apply_prof_uni_w   = bf(vvc_apply_prof_uni_w, bd, opt);     \
+} while (0)
+
+#define DMVR_INIT(bd, opt) do {                                          \
+    c->inter.dmvr[0][0]         = bf(vvc_dmvr, bd, opt);                 \
+    c->inter.dmvr[0][1]         = bf(vvc_dmvr_h, bd, opt);               \
+    c->inter.dmvr[1][0]         = bf(vvc_dmvr_v, bd, opt);               \
+    c->inter.dmvr[1][1]         = bf(vvc_dmvr_hv, bd, opt);              \
+} while (0)
+
+#define BLEND_INIT(bpc, bd, opt) do {                                    \
+    c->inter.put_gpm            = bf(vvc_put_gpm, bd, opt);              \
+    c->inter.put_ciip           = BF(ff_vvc_put_ciip, bpc, opt);         \
+} while (0)
+
+#define SCALED_INIT(bd, opt) do {                                                        \
+    for (int i = 0; i < FF_ARRAY_ELEMS(c->inter.put_scaled[LUMA]); i++) {                \
+        c->inter.put_scaled[LUMA][i]         = bf(vvc_put_luma_scaled, bd, opt);         \
+        c->inter.put_scaled[CHROMA][i]       = bf(vvc_put_chroma_scaled, bd, opt);       \
+        c->inter.put_uni_scaled[LUMA][i]     = bf(vvc_put_uni_luma_scaled, bd, opt);     \
+        c->inter.put_uni_scaled[CHROMA][i]   = bf(vvc_put_uni_chroma_scaled, bd, opt);   \
+        c->inter.put_uni_w_scaled[LUMA][i]   = bf(vvc_put_uni_luma_w_scaled, bd, opt);   \
+        c->inter.put_uni_w_scaled[CHROMA][i] = bf(vvc_put_uni_chroma_w_scaled, bd, opt); \
+    }                                                                                    \
+} while (0)
+
+#define ITX_RES_INIT(bd, opt) do {                                       \
+    c->itx.add_residual        = bf(ff_vvc_add_residual, bd, opt);       \
+    c->itx.add_residual_joint  = bf(ff_vvc_add_residual_joint, bd, opt); \
+    c->itx.pred_residual_joint = vvc_pred_residual_joint_##opt;          \
+} while (0)
+
+#define LMCS_INIT(bpc, bd, opt) do {                                     \
+    c->lmcs.filter       = BF(ff_vvc_lmcs_filter_luma, bpc, opt);    \
+    c->lmcs.scale_chroma = bf(vvc_lmcs_scale_chroma, bd, opt);       \
+} while (0)
+
+#define ALF_INIT_AVX512ICL(bd) do {                                  \
+    c->alf.filter[LUMA]   = vvc_alf_filter_luma_##bd##_avx512icl;    \
+    c->alf.filter[CHROMA] = vvc_alf_filter_chroma_##bd##_avx512icl;  \
+} while (0)
+
+#define ALF_INIT(bd, opt) do {                                       \
+    c->alf.filter[LUMA]   = ff_vvc_alf_filter_luma_##bd##_##opt;     \
+    c->alf.filter[CHROMA] = ff_vvc_alf_filter_chroma_##bd##_##opt;   \
+    c->alf.classify       = ff_vvc_alf_classify_##bd##_##opt;        \
+} while (0)
+
+#define ALF_CC_INIT(bd) do {                                         \
+    c->alf.filter_cc      = ff_vvc_alf_filter_cc_##bd##_avx2;        \
+} while (0)
+
+#define SAD_PROTOTYPES(opt)                                                                                \
+int ff_vvc_sad_##opt(const int16_t *src0, const int16_t *src1, int dx, int dy, int block_w, int block_h); \
+void ff_vvc_dmvr_sad_##opt(int *sad, const int16_t *src0, const int16_t *src1, int block_w, int block_h);
+
+SAD_PROTOTYPES(sse4)
+SAD_PROTOTYPES(avx2)
+
+#define SAD_INIT(opt) do {                      \
+    c->inter.sad      = ff_vvc_sad_##opt;       \
+    c->inter.dmvr_sad = ff_vvc_dmvr_sad_##opt;  \
+} while (0)
+
+#define ITX_PROTOTYPE(type, size, opt) \
+void ff_vvc_inv_##type##_##size##_##opt(int *coeffs, ptrdiff_t stride, size_t nz);
+
+#define ITX_MTS_PROTOTYPES(type, opt) \
+    ITX_PROTOTYPE(type,  4, opt)      \
+    ITX_PROTOTYPE(type,  8, opt)      \
+    ITX_PROTOTYPE(type, 16, opt)      \
+    ITX_PROTOTYPE(type, 32, opt)
+
+ITX_PROTOTYPE(dct2,  8, avx2)
+ITX_PROTOTYPE(dct2, 16, avx2)
+ITX_PROTOTYPE(dct2, 32, avx2)
+ITX_PROTOTYPE(dct2, 64, avx2)
+ITX_MTS_PROTOTYPES(dst7, sse4)
+ITX_MTS_PROTOTYPES(dct8, sse4)
+ITX_MTS_PROTOTYPES(dst7, avx2)
+ITX_MTS_PROTOTYPES(dct8, avx2)
+
+void ff_vvc_inv_lfnst_16_avx2(int *v, const int *u, intptr_t no_zero_size, const int8_t *tr_mat, intptr_t max);
+void ff_vvc_inv_lfnst_48_avx2(int *v, const int *u, intptr_t no_zero_size, const int8_t *tr_mat, intptr_t max);
+
+static void vvc_inv_lfnst_avx2(int *v, const int *u, int no_zero_size, int n_tr_s,
+    int pred_mode_intra, int lfnst_idx, int log2_transform_range)
+{
+    const int tr_set_idx = pred_mode_intra < 0 ? 1 : ff_vvc_lfnst_tr_set_index[pred_mode_intra];
+    const int max        = (1 << log2_transform_range) - 1;
+
+    if (n_tr_s > 16)
+        ff_vvc_inv_lfnst_48_avx2(v, u, no_zero_size, ff_vvc_lfnst_8x8[tr_set_idx][lfnst_idx - 1][0], max);
+    else
+        ff_vvc_inv_lfnst_16_avx2(v, u, no_zero_size, ff_vvc_lfnst_4x4[tr_set_idx][lfnst_idx - 1][0], max);
+}
+
+void ff_vvc_dequant_avx2(int *coeffs, ptrdiff_t stride, intptr_t width, intptr_t height, const uint8_t *scale_m,
+    intptr_t scale, intptr_t bd_shift, intptr_t bd_offset, intptr_t max);
+
+static void vvc_dequant_avx2(int *coeffs, ptrdiff_t stride, int width, int height, const uint8_t *scale_m,
+    int scale, int bd_shift, int log2_transform_range)
+{
+    ff_vvc_dequant_avx2(coeffs, stride, width, height, scale_m, scale, bd_shift,
+        (1 << bd_shift) >> 1, (1 << log2_transform_range) - 1);
+}
+
+void ff_vvc_transform_bdpcm_avx2(int *coeffs, intptr_t width, intptr_t height, intptr_t vertical, intptr_t max);
+
+static void vvc_transform_bdpcm_avx2(int *coeffs, int width, int height, int vertical, int log2_transform_range)
+{
+    ff_vvc_transform_bdpcm_avx2(coeffs, width, height, vertical, (1 << log2_transform_range) - 1);
+}
+
+#define ITX_LINK(TYPE, type, size, opt) \
+    c->itx.itx[TYPE][TX_SIZE_##size] = ff_vvc_inv_##type##_##size##_##opt
+
+#define ITX_MTS_LINKS(TYPE, type, opt)                               \
+    ITX_LINK(TYPE, type,  4, opt);                                   \
+    ITX_LINK(TYPE, type,  8, opt);                                   \
+    ITX_LINK(TYPE, type, 16, opt);                                   \
+    ITX_LINK(TYPE, type, 32, opt)
+
+#define ITX_INIT_SSE4() do {                                         \
+    ITX_MTS_LINKS(DST7, dst7, sse4);                                 \
+    ITX_MTS_LINKS(DCT8, dct8, sse4);                                 \
+} while (0)
+
+// the 4-point DCT-II stays on C, a matrix multiply kernel for it benchmarks slower
+#define ITX_INIT() do {                                              \
+    ITX_LINK(DCT2, dct2,  8, avx2);                                  \
+    ITX_LINK(DCT2, dct2, 16, avx2);                                  \
+    ITX_LINK(DCT2, dct2, 32, avx2);                                  \
+    ITX_LINK(DCT2, dct2, 64, avx2);                                  \
+    ITX_MTS_LINKS(DST7, dst7, avx2);                                 \
+    ITX_MTS_LINKS(DCT8, dct8, avx2);                                 \
+    c->itx.inv_lfnst = vvc_inv_lfnst_avx2;                           \
+    c->itx.dequant   = vvc_dequant_avx2;                             \
+    c->itx.transform_bdpcm = vvc_transform_bdpcm_avx2;               \
+} while (0)
+
+#define LF_PROTOTYPES(dir, bd, opt)                                                                  \
+void ff_vvc_##dir##_loop_filter_luma_##bd##_##opt(uint8_t *pix, ptrdiff_t stride,                     \
+    const int32_t *beta, const int32_t *tc, const uint8_t *no_p, const uint8_t *no_q,                \
+    const uint8_t *max_len_p, const uint8_t *max_len_q, int hor_ctu_edge);                           \
+void ff_vvc_##dir##_loop_filter_chroma_##bd##_##opt(uint8_t *pix, ptrdiff_t stride,                   \
+    const int32_t *beta, const int32_t *tc, const uint8_t *no_p, const uint8_t *no_q,                \
+    const uint8_t *max_len_p, const uint8_t *max_len_q, int shift);
+
+#define LF_BPC_PROTOTYPES(bd, opt) \
+    LF_PROTOTYPES(h, bd, opt)      \
+    LF_PROTOTYPES(v, bd, opt)
+
+LF_BPC_PROTOTYPES( 8, avx2)
+LF_BPC_PROTOTYPES(10, avx2)
+LF_BPC_PROTOTYPES(12, avx2)
+
+#define LF_INIT(bd) do {                                                 \
+    c->lf.filter_luma[0]   = ff_vvc_h_loop_filter_luma_##bd##_avx2;      \
+    c->lf.filter_luma[1]   = ff_vvc_v_loop_filter_luma_##bd##_avx2;      \
+    c->lf.filter_chroma[0] = ff_vvc_h_loop_filter_chroma_##bd##_avx2;    \
+    c->lf.filter_chroma[1] = ff_vvc_v_loop_filter_chroma_##bd##_avx2;    \
+} while (0)
+
+#define SAO_EDGE_PROTOTYPE(w, bd, opt) \
+void ff_vvc_sao_edge_filter_##w##_##bd##_##opt(uint8_t *dst, const uint8_t *src, ptrdiff_t stride_dst, \
+    const int16_t *sao_offset_val, int eo, int width, int height);
+
+#define SAO_EDGE_PROTOTYPES(bd, opt)     \
+    SAO_EDGE_PROTOTYPE(8,   bd, opt)     \
+    SAO_EDGE_PROTOTYPE(16,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(32,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(48,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(64,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(80,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(96,  bd, opt)     \
+    SAO_EDGE_PROTOTYPE(112, bd, opt)     \
+    SAO_EDGE_PROTOTYPE(128, bd, opt)
+
+SAO_EDGE_PROTOTYPES( 8, ssse3)
+SAO_EDGE_PROTOTYPES( 8, avx2)
+SAO_EDGE_PROTOTYPES(10, sse2)
+SAO_EDGE_PROTOTYPES(10, avx2)
+SAO_EDGE_PROTOTYPES(12, sse2)
+SAO_EDGE_PROTOTYPES(12, avx2)
+
+#define SAO_BAND_INIT(bd, opt) do {                                  \
+    c->sao.band_filter[0] = ff_h2656_sao_band_filter_8_##bd##_##opt;   \
+    c->sao.band_filter[1] = ff_h2656_sao_band_filter_16_##bd##_##opt;  \
+    c->sao.band_filter[2] = ff_h2656_sao_band_filter_32_##bd##_##opt;  \
+    c->sao.band_filter[3] = ff_h2656_sao_band_filter_48_##bd##_##opt;  \
+    c->sao.band_filter[4] = ff_h2656_sao_band_filter_64_##bd##_##opt;  \
+    c->sao.band_filter[5] = ff_h2656_sao_band_filter_80_##bd##_##opt;  \
+    c->sao.band_filter[6] = ff_h2656_sao_band_filter_96_##bd##_##opt;  \
+    c->sao.band_filter[7] = ff_h2656_sao_band_filter_112_##bd##_##opt; \
+    c->sao.band_filter[8] = ff_h2656_sao_band_filter_128_##bd##_##opt; \
+} while (0)
+
+// the 8-bit AVX2 edge filters only exist for widths of 32 and up
+#define SAO_EDGE_INIT_32(bd, opt) do {                               \
+    c->sao.edge_filter[2] = ff_vvc_sao_edge_filter_32_##bd##_##opt;    \
+    c->sao.edge_filter[3] = ff_vvc_sao_edge_filter_48_##bd##_##opt;    \
+    c->sao.edge_filter[4] = ff_vvc_sao_edge_filter_64_##bd##_##opt;    \
+    c->sao.edge_filter[5] = ff_vvc_sao_edge_filter_80_##bd##_##opt;    \
+    c->sao.edge_filter[6] = ff_vvc_sao_edge_filter_96_##bd##_##opt;    \
+    c->sao.edge_filter[7] = ff_vvc_sao_edge_filter_112_##bd##_##opt;   \
+    c->sao.edge_filter[8] = ff_vvc_sao_edge_filter_128_##bd##_##opt;   \
+} while (0)
+
+#define SAO_EDGE_INIT(bd, opt) do {                                  \
+    c->sao.edge_filter[0] = ff_vvc_sao_edge_filter_8_##bd##_##opt;     \
+    c->sao.edge_filter[1] = ff_vvc_sao_edge_filter_16_##bd##_##opt;    \
+    SAO_EDGE_INIT_32(bd, opt);                                       \
+} while (0)
+
+#define INTRA_BPC_PROTOTYPES(bpc, opt)                                                              \
+void BF(ff_vvc_pred_angular, bpc, opt)(uint8_t *dst, ptrdiff_t stride, const uint8_t *ref,          \
+    intptr_t w, intptr_t h, intptr_t pos, intptr_t angle, const int8_t *filter,                     \
+    const uint8_t *side, const int32_t *pdpc, intptr_t pixel_max);                                  \
+void BF(ff_vvc_transpose, bpc, opt)(uint8_t *dst, ptrdiff_t stride, const uint8_t *src,             \
+    ptrdiff_t src_stride, intptr_t w, intptr_t h);                                                  \
+void BF(ff_vvc_pred_planar, bpc, opt)(uint8_t *src, const uint8_t *top, const uint8_t *left,        \
+    int w, int h, ptrdiff_t stride);                                                                \
+void BF(ff_vvc_pred_dc, bpc, opt)(uint8_t *src, const uint8_t *top, const uint8_t *left,            \
+    int w, int h, ptrdiff_t stride);                                                                \
+void BF(ff_vvc_pred_v, bpc, opt)(uint8_t *src, const uint8_t *top, int w, int h, ptrdiff_t stride); \
+void BF(ff_vvc_pred_h, bpc, opt)(uint8_t *src, const uint8_t *left, int w, int h, ptrdiff_t stride); \
+void BF(ff_vvc_ibc_copy, bpc, opt)(uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src,           \
+    ptrdiff_t src_stride, int w, int h);
+
+INTRA_BPC_PROTOTYPES( 8, avx2)
+INTRA_BPC_PROTOTYPES(16, avx2)
+
+// INTRA_CHROMA_FILTER() as a 4-tap filter with the luma rounding
+#define CHROMA_TAPS(fact) { 0, 64 - 2 * (fact), 2 * (fact), 0 }
+static const int8_t intra_chroma_filter[32][4] = {
+    CHROMA_TAPS( 0), CHROMA_TAPS( 1), CHROMA_TAPS( 2), CHROMA_TAPS( 3), CHROMA_TAPS( 4), CHROMA_TAPS( 5),
+    CHROMA_TAPS( 6), CHROMA_TAPS( 7), CHROMA_TAPS( 8), CHROMA_TAPS( 9), CHROMA_TAPS(10), CHROMA_TAPS(11),
+    CHROMA_TAPS(12), CHROMA_TAPS(13), CHROMA_TAPS(14), CHROMA_TAPS(15), CHROMA_TAPS(16), CHROMA_TAPS(17),
+    CHROMA_TAPS(18), CHROMA_TAPS(19), CHROMA_TAPS(20), CHROMA_TAPS(21), CHROMA_TAPS(22), CHROMA_TAPS(23),
+    CHROMA_TAPS(24), CHROMA_TAPS(25), CHROMA_TAPS(26), CHROMA_TAPS(27), CHROMA_TAPS(28), CHROMA_TAPS(29),
+    CHROMA_TAPS(30), CHROMA_TAPS(31),
+};
+
+static const int8_t *intra_angular_filter(const int c_idx, const int filter_flag)
+{
+    return c_idx ? intra_chroma_filter[0] : ff_vvc_intra_luma_filter[filter_flag][0];
+}
+
+// offsets into the side reference and weights << 9 of the first 16 PDPC samples of a row,
+// zero past the len samples of the row and past the filtered range
+static void intra_angular_pdpc(int32_t *pdpc, const int len, const int mode, const int w, const int h)
+{
+    const int inv_angle = ff_vvc_intra_inv_angle_derive(ff_vvc_intra_pred_angle_derive(mode));
+    const int nscale    = ff_vvc_nscale_derive(w, h, mode);
+    const int n         = FFMIN(len, 3 << nscale);
+    int16_t *weight     = (int16_t *)(pdpc + 16);
+
+    for (int i = 0; i < 16; i++) {
+        pdpc[i]   = i < n ? (256 + (i + 1) * inv_angle) >> 9 : 0;
+        weight[i] = i < n ? (32 >> ((i << 1) >> nscale)) << 9 : 0;
+    }
+}
+
+// pred_angular_h() is pred_angular_v() with top and left swapped, so the transpose of the
+// block is predicted into a temporary buffer first
+#define INTRA_FUNCS(bpc, bd, opt)                                                                   \
+static void bf(vvc_pred_angular_v, bd, opt)(uint8_t *src, const uint8_t *top, const uint8_t *left, \
+    int w, int h, ptrdiff_t stride, int c_idx, int mode, int ref_idx, int filter_flag,              \
+    int need_pdpc)                                                                                  \
+{                                                                                                   \
+    const int angle = ff_vvc_intra_pred_angle_derive(mode);                                         \
+    DECLARE_ALIGNED(32, int32_t, pdpc)[24];                                                         \
+                                                                                                    \
+    if (need_pdpc)                                                                                  \
+        intra_angular_pdpc(pdpc, w, mode, w, h);                                                    \
+    BF(ff_vvc_pred_angular, bpc, opt)(src, stride * bpc / 8, top - bpc / 8, w, h,                   \
+        (1 + ref_idx) * angle, angle, intra_angular_filter(c_idx, filter_flag),                     \
+        need_pdpc ? left : NULL, pdpc, (1 << bd) - 1);                                              \
+}                                                                                                   \
+static void bf(vvc_pred_angular_h, bd, opt)(uint8_t *src, const uint8_t *top, const uint8_t *left, \
+    int w, int h, ptrdiff_t stride, int c_idx, int mode, int ref_idx, int filter_flag,              \
+    int need_pdpc)                                                                                  \
+{                                                                                                   \
+    const int angle = ff_vvc_intra_pred_angle_derive(mode);                                         \
+    DECLARE_ALIGNED(32, int32_t, pdpc)[24];                                                         \
+    DECLARE_ALIGNED(32, uint8_t, tmp)[MAX_TB_SIZE * MAX_TB_SIZE * bpc / 8];                         \
+                                                                                                    \
+    if (need_pdpc)                                                                                  \
+        intra_angular_pdpc(pdpc, h, mode, w, h);                                                    \
+    BF(ff_vvc_pred_angular, bpc, opt)(tmp, MAX_TB_SIZE * bpc / 8, left - bpc / 8, FFMAX(h, 4), w,   \
+        (1 + ref_idx) * angle, angle, intra_angular_filter(c_idx, filter_flag),                     \
+        need_pdpc ? top : NULL, pdpc, (1 << bd) - 1);                                               \
+    BF(ff_vvc_transpose, bpc, opt)(src, stride * bpc / 8, tmp, MAX_TB_SIZE * bpc / 8, w, h);    \
+}
+
+INTRA_FUNCS( 8,  8, avx2)
+INTRA_FUNCS(16, 10, avx2)
+INTRA_FUNCS(16, 12, avx2)
+
+void ff_vvc_mip_matmul_avx2(int32_t *pred, const int16_t *reduced, const uint8_t *matrix, intptr_t size_id,
+    intptr_t ow, intptr_t temp0, intptr_t pixel_max);
+
+#define MIP_BPC_PROTOTYPES(bpc, opt)                                                                \
+void BF(ff_vvc_mip_upsample, bpc, opt)(uint8_t *dst, ptrdiff_t stride, const uint8_t *top,          \
+    const uint8_t *left, intptr_t w, intptr_t up_hor, intptr_t up_ver, const int32_t *pred,         \
+    intptr_t pred_size, intptr_t transposed);
+
+MIP_BPC_PROTOTYPES( 8, avx2)
+MIP_BPC_PROTOTYPES(16, avx2)
+
+// 8.4.5.2.3, the average of each n_tb_s / boundary_size samples of ref
+static av_always_inline void mip_downsampling(int *reduced, const int boundary_size,
+    const uint8_t *ref, const int n_tb_s, const int bpc)
+{
+    const int b_dwn = n_tb_s / boundary_size;
+    const int log2  = av_log2(b_dwn);
+
+    for (int i = 0; i < boundary_size; i++) {
+        int r = 0;
+        for (int j = 0; j < b_dwn; j++, ref += bpc / 8)
+            r += bpc == 8 ? *ref : *(const uint16_t *)ref;
+        reduced[i] = (r + (1 << log2 >> 1)) >> log2;
+    }
+}
+
+// the input of the matrix product of pred_mip(), returns ow
+static av_always_inline int mip_reduce(int16_t *input, int *temp0, const uint8_t *top,
+    const uint8_t *left, const int w, const int h, const int size_id, const int is_transposed,
+    const int bpc, const int bd)
+{
+    const int boundary_size = size_id ? 4 : 2;
+    const int in_size       = 2 * boundary_size - (size_id == 2);
+    const int off           = size_id == 2;
+    int reduced[8];
+    int ow;
+
+    mip_downsampling(reduced + is_transposed * boundary_size, boundary_size, top, w, bpc);
+    mip_downsampling(reduced + !is_transposed * boundary_size, boundary_size, left, h, bpc);
+    *temp0   = reduced[0];
+    ow       = size_id == 2 ? reduced[1] - *temp0 : (1 << (bd - 1)) - *temp0;
+    input[0] = ow;
+    for (int i = 1; i < in_size; i++) {
+        input[i] = reduced[i + off] - *temp0;
+        ow += input[i];
+    }
+    return 32 - 32 * ow;
+}
+
+#define MIP_FUNCS(bpc, bd, opt)                                                                     \
+static void bf(vvc_pred_mip, bd, opt)(uint8_t *src, const uint8_t *top, const uint8_t *left,       \
+    int w, int h, ptrdiff_t stride, int mode_id, int is_transposed)                                 \
+{                                                                                                   \
+    const int size_id   = ff_vvc_get_mip_size_id(w, h);                                             \
+    const int pred_size = size_id == 2 ? 8 : 4;                                                     \
+    DECLARE_ALIGNED(16, int16_t, input)[8] = { 0 };                                                 \
+    DECLARE_ALIGNED(32, int32_t, pred)[64];                                                         \
+    int temp0;                                                                                      \
+    const int ow = mip_reduce(input, &temp0, top, left, w, h, size_id, is_transposed, bpc, bd);     \
+                                                                                                    \
+    ff_vvc_mip_matmul_avx2(pred, input, ff_vvc_get_mip_matrix(size_id, mode_id), size_id,          \
+        ow, temp0, (1 << bd) - 1);                                                                  \
+    BF(ff_vvc_mip_upsample, bpc, opt)(src, stride * bpc / 8, top, left, w, w / pred_size,           \
+        h / pred_size, pred, pred_size, is_transposed);                                             \
+}
+
+MIP_FUNCS( 8,  8, avx2)
+MIP_FUNCS(16, 10, avx2)
+MIP_FUNCS(16, 12, avx2)
+
+#define CCLM_BPC_PROTOTYPES(bpc, opt)                                                               \
+void BF(ff_vvc_cclm_downsample_422, bpc, opt)(uint8_t *pdsy, const uint8_t *src, ptrdiff_t stride,  \
+    int w, int h, int avail_t, int avail_l);                                                        \
+void BF(ff_vvc_cclm_downsample_420c, bpc, opt)(uint8_t *pdsy, const uint8_t *src, ptrdiff_t stride, \
+    int w, int h, int avail_t, int avail_l);                                                        \
+void BF(ff_vvc_cclm_downsample_420, bpc, opt)(uint8_t *pdsy, const uint8_t *src, ptrdiff_t stride,  \
+    int w, int h, int avail_t, int avail_l);                                                        \
+void BF(ff_vvc_cclm_linear_pred, bpc, opt)(uint8_t *dst, ptrdiff_t stride, const uint8_t *pdsy,     \
+    intptr_t w, intptr_t h, intptr_t a, intptr_t b, intptr_t k, intptr_t pixel_max);
+
+CCLM_BPC_PROTOTYPES( 8, avx2)
+CCLM_BPC_PROTOTYPES(16, avx2)
+
+#define CCLM_FUNCS(bpc, bd, opt)                                                                    \
+static void bf(vvc_cclm_linear_pred, bd, opt)(uint8_t *dst, ptrdiff_t stride, const uint8_t *pdsy, \
+    int w, int h, int a, int b, int k)                                                              \
+{                                                                                                   \
+    BF(ff_vvc_cclm_linear_pred, bpc, opt)(dst, stride, pdsy, w, h, a, b, k, (1 << bd) - 1);         \
+}
+
+CCLM_FUNCS( 8,  8, avx2)
+CCLM_FUNCS(16, 10, avx2)
+CCLM_FUNCS(16, 12, avx2)
+
+#define INTRA_INIT(bpc, bd) do {                                                   \
+    c->intra.pred_planar             = ff_vvc_pred_planar_##bpc##bpc_avx2;         \
+    c->intra.pred_dc                 = ff_vvc_pred_dc_##bpc##bpc_avx2;             \
+    c->intra.pred_v                  = ff_vvc_pred_v_##bpc##bpc_avx2;              \
+    c->intra.pred_h                  = ff_vvc_pred_h_##bpc##bpc_avx2;              \
+    c->intra.pred_angular_v          = vvc_pred_angular_v_##bd##_avx2;             \
+    c->intra.pred_angular_h          = vvc_pred_angular_h_##bd##_avx2;             \
+    c->intra.pred_mip                = vvc_pred_mip_##bd##_avx2;                   \
+    c->intra.cclm_downsample_luma[0] = ff_vvc_cclm_downsample_422_##bpc##bpc_avx2; \
+    c->intra.cclm_downsample_luma[1] = ff_vvc_cclm_downsample_420c_##bpc##bpc_avx2; \
+    c->intra.cclm_downsample_luma[2] = ff_vvc_cclm_downsample_420_##bpc##bpc_avx2; \
+    c->intra.cclm_linear_pred        = vvc_cclm_linear_pred_##bd##_avx2;           \
+    c->intra.ibc_copy                = ff_vvc_ibc_copy_##bpc##bpc_avx2;            \
 } while (0)
 
-int ff_vvc_sad_avx2(const int16_t *src0, const int16_t *src1, int dx, int dy, int block_w, int block_h);
-#define SAD_INIT() c->inter.sad = ff_vvc_sad_avx2
 #endif
 
 void ff_vvc_dsp_init_x86(VVCDSPContext *const c, const int bd)
@@ -323,38 +1189,130 @@ void ff_vvc_dsp_init_x86(VVCDSPContext *const c, const int bd)
 
     switch (bd) {
     case 8:
+        if (EXTERNAL_SSE2(cpu_flags)) {
+            SAO_BAND_INIT(8, sse2);
+        }
+        if (EXTERNAL_SSSE3(cpu_flags)) {
+            SAO_EDGE_INIT(8, ssse3);
+        }
         if (EXTERNAL_SSE4(cpu_flags)) {
+            ALF_INIT(8, sse4);
+            AVG_INIT(8, sse4);
+            SAD_INIT(sse4);
             MC_LINK_SSE4(8);
+            ITX_INIT_SSE4();
+        }
+        if (EXTERNAL_AVX(cpu_flags)) {
+            SAO_BAND_INIT(8, avx);
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
-            ALF_INIT(8);
+            ALF_INIT(8, avx2);
+            ALF_CC_INIT(8);
             AVG_INIT(8, avx2);
+            BDOF_INIT(8, avx2);
+            DMVR_INIT(8, avx2);
+            PROF_INIT(8, avx2);
+            BLEND_INIT(8, 8, avx2);
+            SCALED_INIT(8, avx2);
+            ITX_RES_INIT(8, avx2);
+            LMCS_INIT(8, 8, avx2);
             MC_LINKS_AVX2(8);
-            SAD_INIT();
+            SAD_INIT(avx2);
+            ITX_INIT();
+            INTRA_INIT(8, 8);
+            LF_INIT(8);
+            SAO_BAND_INIT(8, avx2);
+            SAO_EDGE_INIT_32(8, avx2);
+        }
+        if (EXTERNAL_AVX512ICL(cpu_flags)) {
+            MC_LINKS_AVX512ICL(8);
+#if HAVE_AVX512ICL_EXTERNAL
+            ALF_INIT_AVX512ICL(8);
+#endif
         }
         break;
     case 10:
+        if (EXTERNAL_SSE2(cpu_flags)) {
+            SAO_BAND_INIT(10, sse2);
+            SAO_EDGE_INIT(10, sse2);
+        }
         if (EXTERNAL_SSE4(cpu_flags)) {
+            ALF_INIT(10, sse4);
+            AVG_INIT(10, sse4);
+            SAD_INIT(sse4);
             MC_LINK_SSE4(10);
+            ITX_INIT_SSE4();
+        }
+        if (EXTERNAL_AVX(cpu_flags)) {
+            SAO_BAND_INIT(10, avx);
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
-            ALF_INIT(10);
+            ALF_INIT(10, avx2);
+            ALF_CC_INIT(10);
             AVG_INIT(10, avx2);
+            BDOF_INIT(10, avx2);
+            DMVR_INIT(10, avx2);
+            PROF_INIT(10, avx2);
+            BLEND_INIT(16, 10, avx2);
+            SCALED_INIT(10, avx2);
+            ITX_RES_INIT(10, avx2);
+            LMCS_INIT(16, 10, avx2);
             MC_LINKS_AVX2(10);
             MC_LINKS_16BPC_AVX2(10);
-            SAD_INIT();
+            SAD_INIT(avx2);
+            ITX_INIT();
+            INTRA_INIT(16, 10);
+            LF_INIT(10);
+            SAO_BAND_INIT(10, avx2);
+            SAO_EDGE_INIT(10, avx2);
+        }
+        if (EXTERNAL_AVX512ICL(cpu_flags)) {
+            MC_LINKS_16BPC_AVX512ICL(10);
+#if HAVE_AVX512ICL_EXTERNAL
+            ALF_INIT_AVX512ICL(10);
+#endif
         }
         break;
     case 12:
+        if (EXTERNAL_SSE2(cpu_flags)) {
+            SAO_BAND_INIT(12, sse2);
+            SAO_EDGE_INIT(12, sse2);
+        }
         if (EXTERNAL_SSE4(cpu_flags)) {
+            ALF_INIT(12, sse4);
+            AVG_INIT(12, sse4);
+            SAD_INIT(sse4);
             MC_LINK_SSE4(12);
+            ITX_INIT_SSE4();
+        }
+        if (EXTERNAL_AVX(cpu_flags)) {
+            SAO_BAND_INIT(12, avx);
         }
         if (EXTERNAL_AVX2_FAST(cpu_flags)) {
-            ALF_INIT(12);
+            ALF_INIT(12, avx2);
+            ALF_CC_INIT(12);
             AVG_INIT(12, avx2);
+            BDOF_INIT(12, avx2);
+            DMVR_INIT(12, avx2);
+            PROF_INIT(12, avx2);
+            BLEND_INIT(16, 12, avx2);
+            SCALED_INIT(12, avx2);
+            ITX_RES_INIT(12, avx2);
+            LMCS_INIT(16, 12, avx2);
             MC_LINKS_AVX2(12);
             MC_LINKS_16BPC_AVX2(12);
-            SAD_INIT();
+            SAD_INIT(avx2);
+            ITX_INIT();
+            INTRA_INIT(16, 12);
+            LF_INIT(12);
+            SAO_BAND_INIT(12, avx2);
+            SAO_EDGE_INIT(12, avx2);
+        }
+        if (EXTERNAL_AVX512ICL(cpu_flags)) {
+            MC_LINKS_16BPC_AVX512ICL(12);
+#if HAVE_AVX512ICL_EXTERNAL
+            ALF_INIT_AVX512ICL(12);
+#endif
         }
         break;
     default:
@@ -208,7 +208,12 @@ static const struct {
     #endif
     #if CONFIG_VVC_DECODER
         { "vvc_alf", checkasm_check_vvc_alf },
+        { "vvc_deblock", checkasm_check_vvc_deblock },
+        { "vvc_intra", checkasm_check_vvc_intra },
+        { "vvc_itx", checkasm_check_vvc_itx },
+        { "vvc_lmcs", checkasm_check_vvc_lmcs },
         { "vvc_mc",  checkasm_check_vvc_mc  },
+        { "vvc_sao", checkasm_check_vvc_sao },
     #endif
 #endif
 #if CONFIG_AVFILTER
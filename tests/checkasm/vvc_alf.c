@@ -124,6 +124,52 @@ static void check_alf_filter(VVCDSPContext *c, const int bit_depth)
     }
 }
 
+static void check_alf_filter_cc(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, luma, [SRC_BUF_SIZE]);
+    int16_t filter[ALF_NUM_COEFF_CC];
+
+    static const struct {
+        const char *name;
+        int hs, vs;
+    } formats[] = { { "444", 0, 0 }, { "422", 1, 0 }, { "420", 1, 1 } };
+
+    ptrdiff_t luma_stride = SRC_PIXEL_STRIDE * SIZEOF_PIXEL;
+    ptrdiff_t dst_stride  = DST_PIXEL_STRIDE * SIZEOF_PIXEL;
+    int offset = (3 * SRC_PIXEL_STRIDE + 3) * SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *luma, ptrdiff_t luma_stride,
+        int width, int height, int hs, int vs, const int16_t *filter, int vb_pos);
+
+    randomize_buffers(luma, luma, SRC_BUF_SIZE);
+    for (int i = 0; i < ALF_NUM_COEFF_CC; i++)
+        filter[i] = (int)(rnd() % 129) - 64;
+
+    for (int f = 0; f < FF_ARRAY_ELEMS(formats); f++) {
+        const int hs = formats[f].hs;
+        const int vs = formats[f].vs;
+        const int ctu_size_v = MAX_CTU_SIZE >> vs;
+        const int vb_pos = (ctu_size_v << vs) - ALF_VB_POS_ABOVE_LUMA;
+
+        for (int h = 4; h <= ctu_size_v; h += 4) {
+            for (int w = 4; w <= MAX_CTU_SIZE >> hs; w += 4) {
+                if (check_func(c->alf.filter_cc, "vvc_alf_filter_cc_%s_%dx%d_%d", formats[f].name, w, h, bit_depth)) {
+                    randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                    call_ref(dst0, dst_stride, luma + offset, luma_stride, w, h, hs, vs, filter, vb_pos);
+                    call_new(dst1, dst_stride, luma + offset, luma_stride, w, h, hs, vs, filter, vb_pos);
+                    if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                        fail();
+                    // Bench only square sizes, and ones with dimensions being a power of two.
+                    if (w == h && (w & (w - 1)) == 0)
+                        bench_new(dst1, dst_stride, luma + offset, luma_stride, w, h, hs, vs, filter, vb_pos);
+                }
+            }
+        }
+    }
+}
+
 static void check_alf_classify(VVCDSPContext *c, const int bit_depth)
 {
     LOCAL_ALIGNED_32(int, class_idx0, [SRC_BUF_SIZE]);
@@ -177,6 +223,12 @@ void checkasm_check_vvc_alf(void)
     }
     report("alf_filter");
 
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_alf_filter_cc(&h, bit_depth);
+    }
+    report("alf_filter_cc");
+
     for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
         ff_vvc_dsp_init(&h, bit_depth);
         check_alf_classify(&h, bit_depth);
@@ -0,0 +1,208 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/vvc/dsp.h"
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mem_internal.h"
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define BUF_STRIDE 32
+#define BUF_LINES 32
+#define BUF_SIZE (BUF_STRIDE * BUF_LINES * 2)
+// the edge is at sample (8, 8) of the buffer
+#define BUF_OFFSET ((8 * BUF_STRIDE + 8) * SIZEOF_PIXEL)
+#define NB_TESTS 256
+
+static void set_pixel(uint8_t *buf, const int x, const int y, const int v, const int bit_depth)
+{
+    const int off = (y * BUF_STRIDE + x) * SIZEOF_PIXEL;
+
+    if (bit_depth == 8)
+        buf[off] = v;
+    else
+        AV_WN16A(buf + off, v);
+}
+
+// sample k of line l, p(i) is k = -i - 1 and q(i) is k = i
+static void set_sample(uint8_t *buf, const int vertical, const int l, const int k, const int v, const int bit_depth)
+{
+    const int pixel_max = (1 << bit_depth) - 1;
+
+    if (vertical)
+        set_pixel(buf, 8 + k, 8 + l, av_clip(v, 0, pixel_max), bit_depth);
+    else
+        set_pixel(buf, 8 + l, 8 + k, av_clip(v, 0, pixel_max), bit_depth);
+}
+
+// A step across the edge on top of a ramp with some noise. The segments get different
+// amounts of noise, so the decisions pick the long, strong, weak or no filter at random.
+// Without noise the edge is smooth enough for the long and strong filters.
+static void randomize_edge(uint8_t *buf, const int vertical, const int segs, const int seg_lines,
+    const int32_t *tc, const int noisy, const int bit_depth)
+{
+    const int pixel_max = (1 << bit_depth) - 1;
+
+    for (int k = 0; k < BUF_SIZE; k++)
+        buf[k] = rnd();
+    if (bit_depth > 8) {
+        for (int k = 0; k < BUF_SIZE; k += 2)
+            AV_WN16A(buf + k, AV_RN16A(buf + k) & pixel_max);
+    }
+
+    for (int s = 0; s < segs; s++) {
+        const int noise = noisy ? (1 << (rnd() % (bit_depth - 2))) >> 1 : 0;
+        const int tc_bd = bit_depth < 10 ? tc[s] >> (10 - bit_depth) : tc[s] << (bit_depth - 10);
+        const int step  = (int)(rnd() % (3 * tc_bd + 1)) - (3 * tc_bd) / 2;
+        const int slope = (int)(rnd() % 5) - 2;
+        const int base  = rnd() % (pixel_max + 1);
+
+        for (int l = s * seg_lines; l < (s + 1) * seg_lines; l++) {
+            for (int k = -8; k < 8; k++) {
+                int v = base + slope * k + (k >= 0 ? step : 0);
+                if (noise)
+                    v += (int)(rnd() % (2 * noise + 1)) - noise;
+                set_sample(buf, vertical, l, k, v, bit_depth);
+            }
+        }
+    }
+}
+
+static void check_deblock_luma(VVCDSPContext *c, const int bit_depth)
+{
+    static const uint8_t max_len[] = { 1, 2, 3, 5, 7 };
+    LOCAL_ALIGNED_32(uint8_t, buf0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, buf1, [BUF_SIZE]);
+    const ptrdiff_t stride = BUF_STRIDE * SIZEOF_PIXEL;
+    int32_t beta[4], tc[4];
+    uint8_t no_p[4], no_q[4], max_len_p[4], max_len_q[4];
+
+    declare_func(void, uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+        const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q,
+        int hor_ctu_edge);
+
+    for (int vertical = 0; vertical <= 1; vertical++) {
+        if (check_func(c->lf.filter_luma[vertical], "vvc_%s_loop_filter_luma_%d",
+                vertical ? "v" : "h", bit_depth)) {
+            for (int i = 0; i < NB_TESTS; i++) {
+                const int hor_ctu_edge = !vertical && !(rnd() & 3);
+
+                for (int s = 0; s < 2; s++) {
+                    // see tctable[] and betatable[] in filter.c
+                    tc[s]        = rnd() & 7 ? rnd() % 396 : 0;
+                    beta[s]      = rnd() % 89;
+                    no_p[s]      = !(rnd() & 7);
+                    no_q[s]      = !(rnd() & 7);
+                    max_len_p[s] = max_len[rnd() % FF_ARRAY_ELEMS(max_len)];
+                    max_len_q[s] = max_len[rnd() % FF_ARRAY_ELEMS(max_len)];
+                }
+                randomize_edge(buf0, vertical, 2, 4, tc, 1, bit_depth);
+                memcpy(buf1, buf0, BUF_SIZE);
+
+                call_ref(buf0 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, hor_ctu_edge);
+                call_new(buf1 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, hor_ctu_edge);
+                if (memcmp(buf0, buf1, BUF_SIZE))
+                    fail();
+            }
+            // bench the long filter on both sides
+            for (int s = 0; s < 2; s++) {
+                tc[s]        = 395;
+                beta[s]      = 88;
+                no_p[s]      = no_q[s]      = 0;
+                max_len_p[s] = max_len_q[s] = 7;
+            }
+            randomize_edge(buf1, vertical, 2, 4, tc, 0, bit_depth);
+            bench_new(buf1 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, 0);
+        }
+    }
+}
+
+static void check_deblock_chroma(VVCDSPContext *c, const int bit_depth)
+{
+    // max_len_p and max_len_q as set by max_filter_length_chroma()
+    static const uint8_t max_len[][2] = { { 0, 0 }, { 1, 1 }, { 1, 3 }, { 3, 3 } };
+    LOCAL_ALIGNED_32(uint8_t, buf0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, buf1, [BUF_SIZE]);
+    const ptrdiff_t stride = BUF_STRIDE * SIZEOF_PIXEL;
+    int32_t beta[4], tc[4];
+    uint8_t no_p[4], no_q[4], max_len_p[4], max_len_q[4];
+
+    declare_func(void, uint8_t *pix, ptrdiff_t stride, const int32_t *beta, const int32_t *tc,
+        const uint8_t *no_p, const uint8_t *no_q, const uint8_t *max_len_p, const uint8_t *max_len_q,
+        int shift);
+
+    for (int vertical = 0; vertical <= 1; vertical++) {
+        // shift is set for 4:2:0 and for 4:2:2 vertical edges, the edge then has 4 segments of 2 lines
+        for (int shift = 0; shift <= 1; shift++) {
+            const int segs = shift ? 4 : 2;
+
+            if (check_func(c->lf.filter_chroma[vertical], "vvc_%s_loop_filter_chroma_%d%s",
+                    vertical ? "v" : "h", bit_depth, shift ? "_shift" : "")) {
+                for (int i = 0; i < NB_TESTS; i++) {
+                    for (int s = 0; s < segs; s++) {
+                        const int len = rnd() % FF_ARRAY_ELEMS(max_len);
+
+                        tc[s]        = rnd() & 7 ? rnd() % 396 : 0;
+                        beta[s]      = rnd() % 89;
+                        no_p[s]      = !(rnd() & 7);
+                        no_q[s]      = !(rnd() & 7);
+                        max_len_p[s] = max_len[len][0];
+                        max_len_q[s] = max_len[len][1];
+                    }
+                    randomize_edge(buf0, vertical, segs, 8 / segs, tc, 1, bit_depth);
+                    memcpy(buf1, buf0, BUF_SIZE);
+
+                    call_ref(buf0 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, shift);
+                    call_new(buf1 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, shift);
+                    if (memcmp(buf0, buf1, BUF_SIZE))
+                        fail();
+                }
+                // bench the strong filter on both sides
+                for (int s = 0; s < segs; s++) {
+                    tc[s]        = 395;
+                    beta[s]      = 88;
+                    no_p[s]      = no_q[s]      = 0;
+                    max_len_p[s] = max_len_q[s] = 3;
+                }
+                randomize_edge(buf1, vertical, segs, 8 / segs, tc, 0, bit_depth);
+                bench_new(buf1 + BUF_OFFSET, stride, beta, tc, no_p, no_q, max_len_p, max_len_q, shift);
+            }
+        }
+    }
+}
+
+void checkasm_check_vvc_deblock(void)
+{
+    VVCDSPContext h;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_deblock_luma(&h, bit_depth);
+    }
+    report("luma");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_deblock_chroma(&h, bit_depth);
+    }
+    report("chroma");
+}
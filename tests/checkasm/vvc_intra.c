@@ -0,0 +1,347 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/vvc/ctu.h"
+#include "libavcodec/vvc/dsp.h"
+#include "libavcodec/vvc/intra.h"
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mem_internal.h"
+
+static const uint32_t pixel_mask[3] = { 0xffffffff, 0x03ff03ff, 0x0fff0fff };
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define DST_STRIDE (MAX_TB_SIZE * 2)
+#define DST_BUF_SIZE (DST_STRIDE * MAX_TB_SIZE)
+// same layout as the arrays of IntraEdgeParams
+#define EDGE_SIZE (6 * MAX_TB_SIZE + 5)
+#define EDGE_OFFSET ((MAX_TB_SIZE + 3) * SIZEOF_PIXEL)
+#define NB_TESTS 512
+// luma around a chroma block of up to MAX_TB_SIZE / 2 x MAX_TB_SIZE, with the top row and left column
+#define LUMA_STRIDE (MAX_TB_SIZE * 2 + 16)
+#define LUMA_BUF_SIZE (LUMA_STRIDE * (MAX_TB_SIZE + 1) * 2)
+#define LUMA_OFFSET ((LUMA_STRIDE + 8) * SIZEOF_PIXEL)
+
+#define randomize_buffers(buf0, buf1, size)                 \
+    do {                                                    \
+        uint32_t mask = pixel_mask[(bit_depth - 8) >> 1];   \
+        for (int k = 0; k < size; k += 4) {                 \
+            uint32_t r = rnd() & mask;                      \
+            AV_WN32A(buf0 + k, r);                          \
+            AV_WN32A(buf1 + k, r);                          \
+        }                                                   \
+    } while (0)
+
+// ff_vvc_wide_angle_mode_mapping(), blocks with a height below 4 are ISP splits of a CU of height 4 or more
+static int wide_angle_mode(const int w, const int tb_h, const int mode)
+{
+    const int h        = FFMAX(tb_h, 4);
+    const int wh_ratio = FFABS(av_log2(w) - av_log2(h));
+    const int max      = wh_ratio > 1 ? 8  + 2 * wh_ratio : 8;
+    const int min      = wh_ratio > 1 ? 60 - 2 * wh_ratio : 60;
+
+    if (w > h && mode < max)
+        return mode + 65;
+    if (h > w && mode > min)
+        return mode - 67;
+    return mode;
+}
+
+static void check_pred_planar_dc(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, top, [EDGE_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, left, [EDGE_SIZE]);
+    // in samples
+    const ptrdiff_t stride = DST_STRIDE / SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left, int w, int h, ptrdiff_t stride);
+
+    for (int dc = 0; dc <= 1; dc++) {
+        if (check_func(dc ? c->intra.pred_dc : c->intra.pred_planar, "vvc_pred_%s_%d",
+                dc ? "dc" : "planar", bit_depth)) {
+            for (int w = 4; w <= MAX_TB_SIZE; w *= 2) {
+                for (int h = 1; h <= MAX_TB_SIZE; h *= 2) {
+                    randomize_buffers((uint8_t *)top, (uint8_t *)top, EDGE_SIZE * 2);
+                    randomize_buffers((uint8_t *)left, (uint8_t *)left, EDGE_SIZE * 2);
+                    randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                    call_ref(dst0, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h, stride);
+                    call_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h, stride);
+                    if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                        fail();
+                }
+            }
+            bench_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, 32, 32, stride);
+        }
+    }
+}
+
+static void check_pred_v_h(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, edge, [EDGE_SIZE]);
+    // in samples
+    const ptrdiff_t stride = DST_STRIDE / SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *src, const uint8_t *edge, int w, int h, ptrdiff_t stride);
+
+    for (int vertical = 0; vertical <= 1; vertical++) {
+        if (check_func(vertical ? c->intra.pred_v : c->intra.pred_h, "vvc_pred_%s_%d",
+                vertical ? "v" : "h", bit_depth)) {
+            for (int w = 4; w <= MAX_TB_SIZE; w *= 2) {
+                for (int h = 1; h <= MAX_TB_SIZE; h *= 2) {
+                    randomize_buffers((uint8_t *)edge, (uint8_t *)edge, EDGE_SIZE * 2);
+                    randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                    call_ref(dst0, (uint8_t *)edge + EDGE_OFFSET, w, h, stride);
+                    call_new(dst1, (uint8_t *)edge + EDGE_OFFSET, w, h, stride);
+                    if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                        fail();
+                }
+            }
+            bench_new(dst1, (uint8_t *)edge + EDGE_OFFSET, 32, 32, stride);
+        }
+    }
+}
+
+static void check_pred_angular(VVCDSPContext *c, const int bit_depth)
+{
+    static const int ref_idxs[] = { 0, 1, 3 };
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, top, [EDGE_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, left, [EDGE_SIZE]);
+    // in samples
+    const ptrdiff_t stride = DST_STRIDE / SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left, int w, int h,
+        ptrdiff_t stride, int c_idx, int mode, int ref_idx, int filter_flag, int need_pdpc);
+
+    for (int vertical = 0; vertical <= 1; vertical++) {
+        if (check_func(vertical ? c->intra.pred_angular_v : c->intra.pred_angular_h,
+                "vvc_pred_angular_%s_%d", vertical ? "v" : "h", bit_depth)) {
+            for (int i = 0; i < NB_TESTS; i++) {
+                // chroma and ISP blocks may have a height of 1 or 2, but the width is padded to 4
+                const int c_idx   = rnd() & 1;
+                const int w       = 4 << (rnd() % 5);
+                const int h       = 1 << (rnd() % 7);
+                const int ref_idx = c_idx ? 0 : ref_idxs[rnd() % FF_ARRAY_ELEMS(ref_idxs)];
+                int mode, filter_flag, need_pdpc;
+
+                do {
+                    mode = wide_angle_mode(w, h, 2 + rnd() % 65);
+                } while (mode == INTRA_HORZ || mode == INTRA_VERT || (mode >= INTRA_DIAG) != vertical);
+                filter_flag = !c_idx && !ref_idx && (rnd() & 1);
+                need_pdpc   = ff_vvc_need_pdpc(w, h, 0, mode, ref_idx);
+
+                randomize_buffers((uint8_t *)top, (uint8_t *)top, EDGE_SIZE * 2);
+                randomize_buffers((uint8_t *)left, (uint8_t *)left, EDGE_SIZE * 2);
+                randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                call_ref(dst0, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h, stride,
+                    c_idx, mode, ref_idx, filter_flag, need_pdpc);
+                call_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h, stride,
+                    c_idx, mode, ref_idx, filter_flag, need_pdpc);
+                if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                    fail();
+            }
+            // a steep luma mode with fractional positions and PDPC
+            bench_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, 32, 32, stride,
+                0, vertical ? 60 : 8, 0, 1, 1);
+        }
+    }
+}
+
+static void check_pred_mip(VVCDSPContext *c, const int bit_depth)
+{
+    static const int nb_modes[] = { 16, 8, 6 };
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, top, [EDGE_SIZE]);
+    LOCAL_ALIGNED_32(uint16_t, left, [EDGE_SIZE]);
+    // in samples
+    const ptrdiff_t stride = DST_STRIDE / SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left, int w, int h,
+        ptrdiff_t stride, int mode_id, int is_transposed);
+
+    if (check_func(c->intra.pred_mip, "vvc_pred_mip_%d", bit_depth)) {
+        for (int log2_w = 2; log2_w <= 6; log2_w++) {
+            for (int log2_h = 2; log2_h <= 6; log2_h++) {
+                const int w       = 1 << log2_w;
+                const int h       = 1 << log2_h;
+                const int size_id = ff_vvc_get_mip_size_id(w, h);
+
+                for (int mode_id = 0; mode_id < nb_modes[size_id]; mode_id++) {
+                    for (int is_transposed = 0; is_transposed <= 1; is_transposed++) {
+                        randomize_buffers((uint8_t *)top, (uint8_t *)top, EDGE_SIZE * 2);
+                        randomize_buffers((uint8_t *)left, (uint8_t *)left, EDGE_SIZE * 2);
+                        randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                        call_ref(dst0, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h,
+                            stride, mode_id, is_transposed);
+                        call_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, w, h,
+                            stride, mode_id, is_transposed);
+                        if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                            fail();
+                    }
+                }
+            }
+        }
+        bench_new(dst1, (uint8_t *)top + EDGE_OFFSET, (uint8_t *)left + EDGE_OFFSET, 32, 32, stride, 0, 0);
+    }
+}
+
+static void check_cclm_downsample_luma(VVCDSPContext *c, const int bit_depth)
+{
+    static const char *const names[] = { "422", "420_collocated", "420" };
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src, [LUMA_BUF_SIZE]);
+
+    declare_func(void, uint8_t *pdsy, const uint8_t *src, ptrdiff_t stride, int w, int h,
+        int avail_t, int avail_l);
+
+    for (int i = 0; i < FF_ARRAY_ELEMS(names); i++) {
+        if (check_func(c->intra.cclm_downsample_luma[i], "vvc_cclm_downsample_luma_%s_%d", names[i], bit_depth)) {
+            for (int j = 0; j < NB_TESTS; j++) {
+                // the chroma blocks of a luma transform block, at least 4 samples wide
+                const int w       = 4 << (rnd() % 4);
+                const int h       = (i ? 2 : 4) << (rnd() % 5);
+                const int avail_t = rnd() & 1;
+                const int avail_l = rnd() & 1;
+
+                randomize_buffers(src, src, LUMA_BUF_SIZE);
+                randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+                call_ref(dst0, src + LUMA_OFFSET, LUMA_STRIDE, w, h, avail_t, avail_l);
+                call_new(dst1, src + LUMA_OFFSET, LUMA_STRIDE, w, h, avail_t, avail_l);
+                if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                    fail();
+            }
+            bench_new(dst1, src + LUMA_OFFSET, LUMA_STRIDE, 16, 16, 1, 1);
+        }
+    }
+}
+
+static void check_cclm_linear_pred(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, pdsy, [DST_BUF_SIZE]);
+    // in samples
+    const ptrdiff_t stride = DST_STRIDE / SIZEOF_PIXEL;
+
+    declare_func(void, uint8_t *dst, ptrdiff_t stride, const uint8_t *pdsy, int w, int h, int a, int b, int k);
+
+    if (check_func(c->intra.cclm_linear_pred, "vvc_cclm_linear_pred_%d", bit_depth)) {
+        for (int i = 0; i < NB_TESTS; i++) {
+            const int w = 4 << (rnd() % 5);
+            const int h = 2 << (rnd() % 6);
+            // the ranges of cclm_get_params(), a is at most 15 in magnitude after the normalization
+            const int a = (int)(rnd() % 33) - 16;
+            const int k = rnd() % 17;
+            const int b = (int)(rnd() % (4 << bit_depth)) - (2 << bit_depth);
+
+            randomize_buffers(pdsy, pdsy, DST_BUF_SIZE);
+            randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+            call_ref(dst0, stride, pdsy, w, h, a, b, k);
+            call_new(dst1, stride, pdsy, w, h, a, b, k);
+            if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                fail();
+        }
+        bench_new(dst1, stride, pdsy, 16, 16, -5, 1 << (bit_depth - 1), 4);
+    }
+}
+
+static void check_ibc_copy(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+
+    declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride, int w, int h);
+
+    if (check_func(c->intra.ibc_copy, "vvc_ibc_copy_%d", bit_depth)) {
+        for (int i = 0; i < NB_TESTS; i++) {
+            // blocks are split at any column where they wrap around the IBC buffer,
+            // so both the source and the destination of a part may start at any column
+            const int w     = 1 + rnd() % MAX_TB_SIZE;
+            const int h     = 1 + rnd() % MAX_TB_SIZE;
+            const int src_x = rnd() % (MAX_TB_SIZE - w + 1);
+            const int dst_x = rnd() % (MAX_TB_SIZE - w + 1);
+
+            randomize_buffers(src, src, DST_BUF_SIZE);
+            randomize_buffers(dst0, dst1, DST_BUF_SIZE);
+            call_ref(dst0 + dst_x * SIZEOF_PIXEL, DST_STRIDE, src + src_x * SIZEOF_PIXEL, DST_STRIDE, w, h);
+            call_new(dst1 + dst_x * SIZEOF_PIXEL, DST_STRIDE, src + src_x * SIZEOF_PIXEL, DST_STRIDE, w, h);
+            if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                fail();
+        }
+        bench_new(dst1, DST_STRIDE, src, DST_STRIDE, 16, 16);
+    }
+}
+
+void checkasm_check_vvc_intra(void)
+{
+    VVCDSPContext h;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_pred_planar_dc(&h, bit_depth);
+    }
+    report("pred_planar_dc");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_pred_v_h(&h, bit_depth);
+    }
+    report("pred_v_h");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_pred_angular(&h, bit_depth);
+    }
+    report("pred_angular");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_pred_mip(&h, bit_depth);
+    }
+    report("pred_mip");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_cclm_downsample_luma(&h, bit_depth);
+    }
+    report("cclm_downsample_luma");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_cclm_linear_pred(&h, bit_depth);
+    }
+    report("cclm_linear_pred");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_ibc_copy(&h, bit_depth);
+    }
+    report("ibc_copy");
+}
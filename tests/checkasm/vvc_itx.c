@@ -0,0 +1,300 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/vvc/dsp.h"
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mem_internal.h"
+
+static const uint32_t pixel_mask[3] = { 0xffffffff, 0x03ff03ff, 0x0fff0fff };
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define MAX_TB_SIZE 64
+#define PIXEL_STRIDE (MAX_TB_SIZE * 2)
+#define PIXEL_BUF_SIZE (PIXEL_STRIDE * MAX_TB_SIZE)
+
+#define randomize_pixels(buf0, buf1, size)                  \
+    do {                                                    \
+        uint32_t mask = pixel_mask[(bit_depth - 8) >> 1];   \
+        for (int k = 0; k < size; k += 4) {                 \
+            uint32_t r = rnd() & mask;                      \
+            AV_WN32A(buf0 + k, r);                          \
+            AV_WN32A(buf1 + k, r);                          \
+        }                                                   \
+    } while (0)
+
+// residuals span the whole 16-bit range, so both clipping bounds are hit
+#define randomize_residuals(buf, size)                      \
+    do {                                                    \
+        for (int k = 0; k < size; k++)                      \
+            buf[k] = (int16_t)rnd();                        \
+    } while (0)
+
+// coefficients are clipped to 16 bits before any inverse transform pass
+#define randomize_coeffs(buf, size)                         \
+    do {                                                    \
+        for (int k = 0; k < size; k++)                      \
+            buf[k] = (int16_t)rnd();                        \
+    } while (0)
+
+static void check_itx_1d(VVCDSPContext *c, const enum TxType type, const char *name)
+{
+    LOCAL_ALIGNED_32(int, coeffs0, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    LOCAL_ALIGNED_32(int, coeffs1, [MAX_TB_SIZE * MAX_TB_SIZE]);
+
+    declare_func(void, int *coeffs, ptrdiff_t stride, size_t nz);
+
+    // DST-VII and DCT-VIII only exist for 4 to 32 points
+    const int min_log2_size = type == DCT2 ? 1 : 2;
+    const int max_log2_size = type == DCT2 ? 6 : 5;
+
+    for (int log2_size = min_log2_size; log2_size <= max_log2_size; log2_size++) {
+        const int size   = 1 << log2_size;
+        // zero-out leaves at most 32 (DCT-II) or 16 (DST-VII, DCT-VIII) coefficients
+        const int max_nz = FFMIN(size, type == DCT2 ? 32 : 16);
+
+        if (check_func(c->itx.itx[type][log2_size - 1], "vvc_inv_%s_%d", name, size)) {
+            for (int nz = 1; nz <= max_nz; nz++) {
+                // stride 1 for rows, stride size for columns
+                for (int stride = 1; stride <= size; stride *= size) {
+                    memset(coeffs0, 0, sizeof(*coeffs0) * size * size);
+                    for (int i = 0; i < nz; i++)
+                        coeffs0[i * stride] = (int16_t)rnd();
+                    memcpy(coeffs1, coeffs0, sizeof(*coeffs0) * size * size);
+
+                    call_ref(coeffs0, stride, nz);
+                    call_new(coeffs1, stride, nz);
+                    if (memcmp(coeffs0, coeffs1, sizeof(*coeffs0) * size * size))
+                        fail();
+                }
+            }
+            randomize_coeffs(coeffs1, max_nz);
+            bench_new(coeffs1, 1, max_nz);
+        }
+    }
+}
+
+static void check_inv_lfnst(VVCDSPContext *c)
+{
+    int u[16], v0[48], v1[48];
+
+    declare_func(void, int *v, const int *u, int no_zero_size, int n_tr_s,
+        int pred_mode_intra, int lfnst_idx, int log2_transform_range);
+
+    for (int n_tr_s = 16; n_tr_s <= 48; n_tr_s += 32) {
+        if (check_func(c->itx.inv_lfnst, "vvc_inv_lfnst_%d", n_tr_s)) {
+            for (int no_zero_size = 8; no_zero_size <= 16; no_zero_size += 8) {
+                for (int lfnst_idx = 1; lfnst_idx <= 2; lfnst_idx++) {
+                    // -1 selects the CCLM/MIP set, wide angles go up to 80
+                    for (int pred_mode_intra = -1; pred_mode_intra <= 80; pred_mode_intra++) {
+                        const int log2_transform_range = 15 + rnd() % 6;
+
+                        randomize_coeffs(u, no_zero_size);
+                        memset(v0, 0, sizeof(v0));
+                        memset(v1, 0, sizeof(v1));
+                        call_ref(v0, u, no_zero_size, n_tr_s, pred_mode_intra, lfnst_idx, log2_transform_range);
+                        call_new(v1, u, no_zero_size, n_tr_s, pred_mode_intra, lfnst_idx, log2_transform_range);
+                        if (memcmp(v0, v1, sizeof(v0)))
+                            fail();
+                    }
+                }
+            }
+            randomize_coeffs(u, 16);
+            bench_new(v1, u, 16, n_tr_s, 0, 1, 15);
+        }
+    }
+}
+
+static void check_add_residual(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [PIXEL_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [PIXEL_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int, res, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    const ptrdiff_t stride = PIXEL_STRIDE;
+
+    for (int h = 1; h <= MAX_TB_SIZE; h *= 2) {
+        for (int w = 1; w <= MAX_TB_SIZE; w *= 2) {
+            {
+                declare_func(void, uint8_t *dst, const int *res, int width, int height, ptrdiff_t stride);
+
+                if (check_func(c->itx.add_residual, "vvc_add_residual_%dx%d_%d", w, h, bit_depth)) {
+                    randomize_pixels(dst0, dst1, PIXEL_BUF_SIZE);
+                    randomize_residuals(res, w * h);
+                    call_ref(dst0, res, w, h, stride);
+                    call_new(dst1, res, w, h, stride);
+                    if (memcmp(dst0, dst1, PIXEL_BUF_SIZE))
+                        fail();
+                    if (w == h)
+                        bench_new(dst1, res, w, h, stride);
+                }
+            }
+            {
+                declare_func(void, uint8_t *dst, const int *res, int width, int height, ptrdiff_t stride,
+                    int c_sign, int shift);
+
+                if (check_func(c->itx.add_residual_joint, "vvc_add_residual_joint_%dx%d_%d", w, h, bit_depth)) {
+                    for (int c_sign = -1; c_sign <= 1; c_sign += 2) {
+                        for (int shift = 0; shift <= 1; shift++) {
+                            randomize_pixels(dst0, dst1, PIXEL_BUF_SIZE);
+                            randomize_residuals(res, w * h);
+                            call_ref(dst0, res, w, h, stride, c_sign, shift);
+                            call_new(dst1, res, w, h, stride, c_sign, shift);
+                            if (memcmp(dst0, dst1, PIXEL_BUF_SIZE))
+                                fail();
+                        }
+                    }
+                    if (w == h)
+                        bench_new(dst1, res, w, h, stride, -1, 1);
+                }
+            }
+        }
+    }
+}
+
+static void check_pred_residual_joint(VVCDSPContext *c)
+{
+    LOCAL_ALIGNED_32(int, buf0, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    LOCAL_ALIGNED_32(int, buf1, [MAX_TB_SIZE * MAX_TB_SIZE]);
+
+    declare_func(void, int *buf, int width, int height, int c_sign, int shift);
+
+    for (int h = 1; h <= MAX_TB_SIZE; h *= 2) {
+        for (int w = 1; w <= MAX_TB_SIZE; w *= 2) {
+            // the smallest chroma residual has 4 samples
+            if (w * h < 4)
+                continue;
+            if (check_func(c->itx.pred_residual_joint, "vvc_pred_residual_joint_%dx%d", w, h)) {
+                for (int c_sign = -1; c_sign <= 1; c_sign += 2) {
+                    for (int shift = 0; shift <= 1; shift++) {
+                        randomize_residuals(buf0, MAX_TB_SIZE * MAX_TB_SIZE);
+                        memcpy(buf1, buf0, sizeof(*buf0) * MAX_TB_SIZE * MAX_TB_SIZE);
+                        call_ref(buf0, w, h, c_sign, shift);
+                        call_new(buf1, w, h, c_sign, shift);
+                        if (memcmp(buf0, buf1, sizeof(*buf0) * MAX_TB_SIZE * MAX_TB_SIZE))
+                            fail();
+                    }
+                }
+                if (w == h)
+                    bench_new(buf1, w, h, -1, 1);
+            }
+        }
+    }
+}
+
+static void check_dequant(VVCDSPContext *c)
+{
+    LOCAL_ALIGNED_32(int, coeffs0, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    LOCAL_ALIGNED_32(int, coeffs1, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    // the asm reads scale_m in groups of 8
+    uint8_t scale_m[MAX_TB_SIZE * MAX_TB_SIZE + 8];
+    const ptrdiff_t stride = MAX_TB_SIZE;
+
+    declare_func(void, int *coeffs, ptrdiff_t stride, int width, int height, const uint8_t *scale_m,
+        int scale, int bd_shift, int log2_transform_range);
+
+    if (check_func(c->itx.dequant, "vvc_dequant")) {
+        for (int h = 1; h <= MAX_TB_SIZE; h++) {
+            for (int w = 1; w <= MAX_TB_SIZE; w++) {
+                // levelScale << (qp / 6)
+                const int scale                = (rnd() % 72 + 1) << (rnd() % 15);
+                const int bd_shift             = rnd() % 24 + 1;
+                const int log2_transform_range = 15 + rnd() % 6;
+
+                for (int i = 0; i < MAX_TB_SIZE * MAX_TB_SIZE; i++) {
+                    // coefficients are at most 2^20 in magnitude, a quarter of them zero
+                    coeffs0[i] = rnd() & 3 ? (int)(rnd() % (2 << 20)) - (1 << 20) : 0;
+                    scale_m[i] = rnd();
+                }
+                memcpy(coeffs1, coeffs0, sizeof(*coeffs0) * MAX_TB_SIZE * MAX_TB_SIZE);
+                call_ref(coeffs0, stride, w, h, scale_m, scale, bd_shift, log2_transform_range);
+                call_new(coeffs1, stride, w, h, scale_m, scale, bd_shift, log2_transform_range);
+                if (memcmp(coeffs0, coeffs1, sizeof(*coeffs0) * MAX_TB_SIZE * MAX_TB_SIZE))
+                    fail();
+            }
+        }
+        bench_new(coeffs1, stride, 32, 32, scale_m, 40, 10, 15);
+    }
+}
+
+static void check_transform_bdpcm(VVCDSPContext *c)
+{
+    LOCAL_ALIGNED_32(int, coeffs0, [MAX_TB_SIZE * MAX_TB_SIZE]);
+    LOCAL_ALIGNED_32(int, coeffs1, [MAX_TB_SIZE * MAX_TB_SIZE]);
+
+    declare_func(void, int *coeffs, int width, int height, int vertical, int log2_transform_range);
+
+    // BDPCM is only allowed up to the max transform skip size of 32
+    for (int h = 4; h <= 32; h *= 2) {
+        for (int w = 4; w <= 32; w *= 2) {
+            for (int vertical = 0; vertical <= 1; vertical++) {
+                if (check_func(c->itx.transform_bdpcm, "transform_bdpcm_%dx%d_%s", w, h, vertical ? "v" : "h")) {
+                    const int log2_transform_range = 15 + rnd() % 6;
+
+                    // residual coding limits the coefficients to 16 bits, the sums hit the clipping
+                    for (int i = 0; i < w * h; i++)
+                        coeffs0[i] = (int16_t)rnd();
+                    memcpy(coeffs1, coeffs0, sizeof(*coeffs0) * w * h);
+                    call_ref(coeffs0, w, h, vertical, log2_transform_range);
+                    call_new(coeffs1, w, h, vertical, log2_transform_range);
+                    if (memcmp(coeffs0, coeffs1, sizeof(*coeffs0) * w * h))
+                        fail();
+                    if (w == h)
+                        bench_new(coeffs1, w, h, vertical, 15);
+                }
+            }
+        }
+    }
+}
+
+void checkasm_check_vvc_itx(void)
+{
+    VVCDSPContext h;
+
+    ff_vvc_dsp_init(&h, 8);
+
+    check_itx_1d(&h, DCT2, "dct2");
+    report("inv_dct2");
+
+    check_itx_1d(&h, DST7, "dst7");
+    report("inv_dst7");
+
+    check_itx_1d(&h, DCT8, "dct8");
+    report("inv_dct8");
+
+    check_inv_lfnst(&h);
+    report("inv_lfnst");
+
+    check_dequant(&h);
+    report("dequant");
+
+    check_transform_bdpcm(&h);
+    report("transform_bdpcm");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_add_residual(&h, bit_depth);
+    }
+    report("add_residual");
+
+    check_pred_residual_joint(&h);
+    report("pred_residual_joint");
+}
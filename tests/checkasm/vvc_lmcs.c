@@ -0,0 +1,131 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/vvc/ctu.h"
+#include "libavcodec/vvc/dsp.h"
+#include "libavcodec/vvc/ps.h"
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mem_internal.h"
+
+static const uint32_t pixel_mask[3] = { 0xffffffff, 0x03ff03ff, 0x0fff0fff };
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define PIXEL_STRIDE (MAX_CTU_SIZE * 2)
+#define BUF_SIZE (PIXEL_STRIDE * MAX_CTU_SIZE)
+#define COEFF_BUF_SIZE (MAX_TB_SIZE * MAX_TB_SIZE)
+
+#define randomize_pixels(buf0, buf1, size)                  \
+    do {                                                    \
+        uint32_t mask = pixel_mask[(bit_depth - 8) >> 1];   \
+        for (int k = 0; k < size; k += 4) {                 \
+            uint32_t r = rnd() & mask;                      \
+            AV_WN32A(buf0 + k, r);                          \
+            AV_WN32A(buf1 + k, r);                          \
+        }                                                   \
+    } while (0)
+
+static void randomize_lut(VVCLMCS *lmcs, const int bit_depth)
+{
+    const int pixel_max = (1 << bit_depth) - 1;
+
+    for (int i = 0; i <= pixel_max; i++) {
+        if (bit_depth > 8)
+            lmcs->fwd_lut.u16[i] = rnd() & pixel_max;
+        else
+            lmcs->fwd_lut.u8[i]  = rnd() & pixel_max;
+    }
+}
+
+static void check_lmcs_filter(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [BUF_SIZE]);
+    // the lut is passed inside a VVCLMCS as the decoder does
+    VVCLMCS lmcs;
+    VVCDSPContext c;
+
+    declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, int width, int height, const void *lut);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        randomize_lut(&lmcs, bit_depth);
+        for (int h = 4; h <= MAX_CTU_SIZE; h *= 2) {
+            for (int w = 4; w <= MAX_CTU_SIZE; w *= 2) {
+                // CTUs at the right picture edge have any width that is a multiple of 8
+                const int width = w > 8 ? w - 8 * (rnd() & 1) : w;
+
+                if (check_func(c.lmcs.filter, "lmcs_filter_luma_%d_%dx%d", bit_depth, w, h)) {
+                    randomize_pixels(dst0, dst1, BUF_SIZE);
+                    call_ref(dst0, PIXEL_STRIDE, width, h, &lmcs.fwd_lut);
+                    call_new(dst1, PIXEL_STRIDE, width, h, &lmcs.fwd_lut);
+                    if (memcmp(dst0, dst1, BUF_SIZE))
+                        fail();
+                    if (w == h)
+                        bench_new(dst1, PIXEL_STRIDE, w, h, &lmcs.fwd_lut);
+                }
+            }
+        }
+    }
+    report("lmcs_filter");
+}
+
+static void check_lmcs_scale_chroma(void)
+{
+    LOCAL_ALIGNED_32(int, coeff, [COEFF_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int, dst0, [COEFF_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int, dst1, [COEFF_BUF_SIZE]);
+    VVCDSPContext c;
+
+    declare_func(void, int *dst, const int *coeff, int width, int height, int chroma_scale);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        for (int h = 2; h <= MAX_TB_SIZE; h *= 2) {
+            for (int w = 2; w <= MAX_TB_SIZE; w *= 2) {
+                // ChromaScaleCoeff is up to (1 << 11) * OrgCW, limited to where c * chroma_scale fits an int
+                const int chroma_scale = rnd() % (1 << FFMIN(bit_depth + 7, 18));
+
+                if (check_func(c.lmcs.scale_chroma, "lmcs_scale_chroma_%d_%dx%d", bit_depth, w, h)) {
+                    // residuals out of the clipping range as well
+                    for (int i = 0; i < COEFF_BUF_SIZE; i++)
+                        coeff[i] = (int)(rnd() % (1 << (bit_depth + 3))) - (1 << (bit_depth + 2));
+                    memset(dst0, 0, COEFF_BUF_SIZE * sizeof(*dst0));
+                    memset(dst1, 0, COEFF_BUF_SIZE * sizeof(*dst1));
+                    call_ref(dst0, coeff, w, h, chroma_scale);
+                    call_new(dst1, coeff, w, h, chroma_scale);
+                    if (memcmp(dst0, dst1, COEFF_BUF_SIZE * sizeof(*dst0)))
+                        fail();
+                    if (w == h)
+                        bench_new(dst1, coeff, w, h, chroma_scale);
+                }
+            }
+        }
+    }
+    report("lmcs_scale_chroma");
+}
+
+void checkasm_check_vvc_lmcs(void)
+{
+    check_lmcs_filter();
+    check_lmcs_scale_chroma();
+}
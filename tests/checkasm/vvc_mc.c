@@ -265,6 +265,163 @@ static void check_put_vvc_chroma_uni(void)
 #define AVG_SRC_BUF_SIZE (MAX_CTU_SIZE * MAX_CTU_SIZE)
 #define AVG_DST_BUF_SIZE (MAX_PB_SIZE * MAX_PB_SIZE * 2)
 
+static void check_put_vvc_uni_w(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src0, [SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src1, [SRC_BUF_SIZE]);
+
+    VVCDSPContext c;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride,
+        const uint8_t *src, ptrdiff_t srcstride, int height,
+        int denom, int wx, int ox, const int8_t *hf, const int8_t *vf, int width);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        randomize_pixels(src0, src1, SRC_BUF_SIZE);
+        for (int is_chroma = 0; is_chroma <= 1; is_chroma++) {
+            const char *name = is_chroma ? "chroma" : "luma";
+
+            for (int i = 0; i < 2; i++) {
+                for (int j = 0; j < 2; j++) {
+                    for (int h = 4 >> is_chroma; h <= MAX_CTU_SIZE; h *= 2) {
+                        for (int w = 4 >> is_chroma; w <= MAX_CTU_SIZE; w *= 2) {
+                            const int idx       = av_log2(w) - 1;
+                            const int denom     = rnd() % 8;
+                            const int wx        = (1 << denom) + rnd() % 256 - 128;
+                            const int ox        = rnd() % 256 - 128;
+                            const int8_t *hf    = is_chroma ?
+                                ff_vvc_inter_chroma_filters[rnd() % VVC_INTER_CHROMA_FILTER_TYPES][rnd() % VVC_INTER_CHROMA_FACTS] :
+                                ff_vvc_inter_luma_filters[rnd() % VVC_INTER_LUMA_FILTER_TYPES][rnd() % VVC_INTER_LUMA_FACTS];
+                            const int8_t *vf    = is_chroma ?
+                                ff_vvc_inter_chroma_filters[rnd() % VVC_INTER_CHROMA_FILTER_TYPES][rnd() % VVC_INTER_CHROMA_FACTS] :
+                                ff_vvc_inter_luma_filters[rnd() % VVC_INTER_LUMA_FILTER_TYPES][rnd() % VVC_INTER_LUMA_FACTS];
+                            const char *type;
+
+                            switch ((j << 1) | i) {
+                                case 0: type = "put_uni_w_pixels"; break; // 0 0
+                                case 1: type = "put_uni_w_h"; break; // 0 1
+                                case 2: type = "put_uni_w_v"; break; // 1 0
+                                case 3: type = "put_uni_w_hv"; break; // 1 1
+                            }
+
+                            if (check_func(c.inter.put_uni_w[is_chroma][idx][j][i], "%s_%s_%d_%dx%d", type, name, bit_depth, w, h)) {
+                                memset(dst0, 0, DST_BUF_SIZE);
+                                memset(dst1, 0, DST_BUF_SIZE);
+                                call_ref(dst0, PIXEL_STRIDE, src0 + SRC_OFFSET, PIXEL_STRIDE, h, denom, wx, ox, hf, vf, w);
+                                call_new(dst1, PIXEL_STRIDE, src1 + SRC_OFFSET, PIXEL_STRIDE, h, denom, wx, ox, hf, vf, w);
+                                if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                                    fail();
+                                if (w == h)
+                                    bench_new(dst1, PIXEL_STRIDE, src1 + SRC_OFFSET, PIXEL_STRIDE, h, denom, wx, ox, hf, vf, w);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    report("put_uni_w");
+}
+
+#define SCALED_SRC_STRIDE   ((MAX_CTU_SIZE * 2 + SRC_EXTRA) * 2)
+#define SCALED_SRC_BUF_SIZE (SCALED_SRC_STRIDE * (MAX_CTU_SIZE * 2 + SRC_EXTRA))
+#define SCALED_SRC_OFFSET   ((SCALED_SRC_STRIDE + EXTRA_BEFORE * 2) * EXTRA_BEFORE)
+
+static void check_put_vvc_scaled(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src, [SCALED_SRC_BUF_SIZE]);
+    VVCDSPContext c;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        randomize_pixels(src, src, SCALED_SRC_BUF_SIZE);
+        for (int is_chroma = 0; is_chroma <= 1; is_chroma++) {
+            const char *name = is_chroma ? "chroma" : "luma";
+
+            for (int h = 4 >> is_chroma; h <= MAX_CTU_SIZE; h *= 2) {
+                for (int w = 4 >> is_chroma; w <= MAX_CTU_SIZE; w *= 2) {
+                    const int idx        = av_log2(w) - 1;
+                    // from 8x upsampling to 2x downsampling, see SCALED_STEP()
+                    const int dx         = 128 + rnd() % (2048 - 128 + 1);
+                    const int dy         = 128 + rnd() % (2048 - 128 + 1);
+                    const int x          = rnd() & 1023;
+                    const int y          = rnd() & 1023;
+                    const int y_end      = (y + h * dy) >> 10;
+                    const int y_last     = (y + (h - 1) * dy) >> 10;
+                    const int src_height = y_end + (y_end == y_last);
+                    const int8_t *hf     = is_chroma ? ff_vvc_inter_chroma_filters[rnd() % VVC_INTER_CHROMA_FILTER_TYPES][0] :
+                        ff_vvc_inter_luma_filters[rnd() % VVC_INTER_LUMA_FILTER_TYPES][0];
+                    const int8_t *vf     = is_chroma ? ff_vvc_inter_chroma_filters[rnd() % VVC_INTER_CHROMA_FILTER_TYPES][0] :
+                        ff_vvc_inter_luma_filters[rnd() % VVC_INTER_LUMA_FILTER_TYPES][0];
+
+                    {
+                        declare_func(void, int16_t *dst, const uint8_t *src, ptrdiff_t src_stride, int src_height,
+                            int x, int y, int dx, int dy, int height, const int8_t *hf, const int8_t *vf, int width);
+
+                        if (check_func(c.inter.put_scaled[is_chroma][idx], "put_%s_scaled_%d_%dx%d", name, bit_depth, w, h)) {
+                            memset(dst0, 0, DST_BUF_SIZE);
+                            memset(dst1, 0, DST_BUF_SIZE);
+                            call_ref((int16_t *)dst0, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height, x, y, dx, dy, h, hf, vf, w);
+                            call_new((int16_t *)dst1, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height, x, y, dx, dy, h, hf, vf, w);
+                            if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                                fail();
+                            if (w == h)
+                                bench_new((int16_t *)dst1, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height, x, y, dx, dy, h, hf, vf, w);
+                        }
+                    }
+
+                    {
+                        declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,
+                            int src_height, int x, int y, int dx, int dy, int height, const int8_t *hf, const int8_t *vf, int width);
+
+                        if (check_func(c.inter.put_uni_scaled[is_chroma][idx], "put_uni_%s_scaled_%d_%dx%d", name, bit_depth, w, h)) {
+                            memset(dst0, 0, DST_BUF_SIZE);
+                            memset(dst1, 0, DST_BUF_SIZE);
+                            call_ref(dst0, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                x, y, dx, dy, h, hf, vf, w);
+                            call_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                x, y, dx, dy, h, hf, vf, w);
+                            if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                                fail();
+                            if (w == h)
+                                bench_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                    x, y, dx, dy, h, hf, vf, w);
+                        }
+                    }
+
+                    {
+                        const int denom = rnd() % 8;
+                        const int wx    = rnd() % 256 - 128;
+                        const int ox    = rnd() % 256 - 128;
+                        declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const uint8_t *src, ptrdiff_t src_stride,
+                            int src_height, int x, int y, int dx, int dy, int height, int denom, int wx, int ox,
+                            const int8_t *hf, const int8_t *vf, int width);
+
+                        if (check_func(c.inter.put_uni_w_scaled[is_chroma][idx], "put_uni_w_%s_scaled_%d_%dx%d", name, bit_depth, w, h)) {
+                            memset(dst0, 0, DST_BUF_SIZE);
+                            memset(dst1, 0, DST_BUF_SIZE);
+                            call_ref(dst0, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                x, y, dx, dy, h, denom, wx, ox, hf, vf, w);
+                            call_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                x, y, dx, dy, h, denom, wx, ox, hf, vf, w);
+                            if (memcmp(dst0, dst1, DST_BUF_SIZE))
+                                fail();
+                            if (w == h)
+                                bench_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, src + SCALED_SRC_OFFSET, SCALED_SRC_STRIDE, src_height,
+                                    x, y, dx, dy, h, denom, wx, ox, hf, vf, w);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    report("put_scaled");
+}
+
 static void check_avg(void)
 {
     LOCAL_ALIGNED_32(int16_t, src00, [AVG_SRC_BUF_SIZE]);
@@ -324,6 +481,243 @@ static void check_avg(void)
     report("avg");
 }
 
+#define BDOF_MAX_SIZE       16
+#define BDOF_SRC_OFFSET     (MAX_PB_SIZE + 16)
+#define BDOF_SRC_BUF_SIZE   (BDOF_SRC_OFFSET + (BDOF_MAX_SIZE + 2) * MAX_PB_SIZE)
+#define BDOF_DST_STRIDE     (BDOF_MAX_SIZE * 2)
+
+static void check_apply_bdof(void)
+{
+    LOCAL_ALIGNED_32(int16_t, src00, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, src01, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, src10, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, src11, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [BDOF_DST_STRIDE * BDOF_MAX_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [BDOF_DST_STRIDE * BDOF_MAX_SIZE]);
+    VVCDSPContext c;
+
+    declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, int16_t *src0, int16_t *src1,
+        int block_w, int block_h);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        for (int h = 8; h <= BDOF_MAX_SIZE; h *= 2) {
+            for (int w = 8; w <= BDOF_MAX_SIZE; w *= 2) {
+                if (check_func(c.inter.apply_bdof, "apply_bdof_%d_%dx%d", bit_depth, w, h)) {
+                    // the C version pads the sources in place, so both sides get their own copy
+                    randomize_avg_src((uint8_t*)src00, (uint8_t*)src10, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                    randomize_avg_src((uint8_t*)src01, (uint8_t*)src11, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                    memset(dst0, 0, BDOF_DST_STRIDE * BDOF_MAX_SIZE);
+                    memset(dst1, 0, BDOF_DST_STRIDE * BDOF_MAX_SIZE);
+                    call_ref(dst0, BDOF_DST_STRIDE, src00 + BDOF_SRC_OFFSET, src01 + BDOF_SRC_OFFSET, w, h);
+                    call_new(dst1, BDOF_DST_STRIDE, src10 + BDOF_SRC_OFFSET, src11 + BDOF_SRC_OFFSET, w, h);
+                    if (memcmp(dst0, dst1, BDOF_DST_STRIDE * BDOF_MAX_SIZE))
+                        fail();
+                    bench_new(dst1, BDOF_DST_STRIDE, src10 + BDOF_SRC_OFFSET, src11 + BDOF_SRC_OFFSET, w, h);
+                }
+            }
+        }
+    }
+    report("apply_bdof");
+}
+
+static void check_bdof_fetch_samples(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, src, [SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, dst0, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, dst1, [BDOF_SRC_BUF_SIZE]);
+    VVCDSPContext c;
+
+    declare_func(void, int16_t *dst, const uint8_t *src, ptrdiff_t src_stride, int x_frac, int y_frac,
+        int width, int height);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        const ptrdiff_t src_stride = PIXEL_STRIDE * SIZEOF_PIXEL;
+
+        ff_vvc_dsp_init(&c, bit_depth);
+        randomize_pixels(src, src, SRC_BUF_SIZE);
+        for (int h = 8; h <= BDOF_MAX_SIZE; h *= 2) {
+            for (int w = 8; w <= BDOF_MAX_SIZE; w *= 2) {
+                if (check_func(c.inter.bdof_fetch_samples, "bdof_fetch_samples_%d_%dx%d", bit_depth, w, h)) {
+                    const int x_frac = rnd() % 16;
+                    const int y_frac = rnd() % 16;
+
+                    memset(dst0, 0, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                    memset(dst1, 0, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                    call_ref(dst0 + BDOF_SRC_OFFSET, src + SRC_OFFSET, src_stride, x_frac, y_frac, w, h);
+                    call_new(dst1 + BDOF_SRC_OFFSET, src + SRC_OFFSET, src_stride, x_frac, y_frac, w, h);
+                    if (memcmp(dst0, dst1, BDOF_SRC_BUF_SIZE * sizeof(int16_t)))
+                        fail();
+                    bench_new(dst1 + BDOF_SRC_OFFSET, src + SRC_OFFSET, src_stride, x_frac, y_frac, w, h);
+                }
+            }
+        }
+    }
+    report("bdof_fetch_samples");
+}
+
+#define PROF_DST_STRIDE     (AFFINE_MIN_BLOCK_SIZE * 2)
+#define PROF_DST_BUF_SIZE   (PROF_DST_STRIDE * AFFINE_MIN_BLOCK_SIZE)
+
+static void randomize_diff_mv(int16_t *diff_mv_x, int16_t *diff_mv_y)
+{
+    // clipped to the dmv_limit of 1 << 5, see derive_subblock_diff_mvs()
+    for (int i = 0; i < AFFINE_MIN_BLOCK_SIZE * AFFINE_MIN_BLOCK_SIZE; i++) {
+        diff_mv_x[i] = rnd() % 63 - 31;
+        diff_mv_y[i] = rnd() % 63 - 31;
+    }
+}
+
+static void check_prof(void)
+{
+    LOCAL_ALIGNED_32(int16_t, tmp, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, tmp0, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, tmp1, [BDOF_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [PROF_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [PROF_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, diff_mv_x, [AFFINE_MIN_BLOCK_SIZE * AFFINE_MIN_BLOCK_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, diff_mv_y, [AFFINE_MIN_BLOCK_SIZE * AFFINE_MIN_BLOCK_SIZE]);
+    VVCDSPContext c;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+
+        randomize_avg_src((uint8_t *)tmp, (uint8_t *)tmp, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+        randomize_diff_mv(diff_mv_x, diff_mv_y);
+
+        {
+            declare_func(void, int16_t *dst, const int16_t *src, const int16_t *diff_mv_x, const int16_t *diff_mv_y);
+
+            if (check_func(c.inter.apply_prof, "apply_prof_%d", bit_depth)) {
+                memset(tmp0, 0, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                memset(tmp1, 0, BDOF_SRC_BUF_SIZE * sizeof(int16_t));
+                call_ref(tmp0, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+                call_new(tmp1, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+                if (memcmp(tmp0, tmp1, BDOF_SRC_BUF_SIZE * sizeof(int16_t)))
+                    fail();
+                bench_new(tmp1, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+            }
+        }
+
+        {
+            declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,
+                const int16_t *diff_mv_x, const int16_t *diff_mv_y);
+
+            if (check_func(c.inter.apply_prof_uni, "apply_prof_uni_%d", bit_depth)) {
+                memset(dst0, 0, PROF_DST_BUF_SIZE);
+                memset(dst1, 0, PROF_DST_BUF_SIZE);
+                call_ref(dst0, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+                call_new(dst1, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+                if (memcmp(dst0, dst1, PROF_DST_BUF_SIZE))
+                    fail();
+                bench_new(dst1, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y);
+            }
+        }
+
+        {
+            const int denom = rnd() % 8;
+            const int wx    = rnd() % 256 - 128;
+            const int ox    = rnd() % 256 - 128;
+            declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *src,
+                const int16_t *diff_mv_x, const int16_t *diff_mv_y, int denom, int wx, int ox);
+
+            if (check_func(c.inter.apply_prof_uni_w, "apply_prof_uni_w_%d", bit_depth)) {
+                memset(dst0, 0, PROF_DST_BUF_SIZE);
+                memset(dst1, 0, PROF_DST_BUF_SIZE);
+                call_ref(dst0, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y, denom, wx, ox);
+                call_new(dst1, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y, denom, wx, ox);
+                if (memcmp(dst0, dst1, PROF_DST_BUF_SIZE))
+                    fail();
+                bench_new(dst1, PROF_DST_STRIDE, tmp + BDOF_SRC_OFFSET, diff_mv_x, diff_mv_y, denom, wx, ox);
+            }
+        }
+    }
+    report("prof");
+}
+
+#define GPM_MAX_SIZE 64
+
+static void check_put_gpm(void)
+{
+    static const int steps_x[] = { 1, -1, 2, -2 };
+    LOCAL_ALIGNED_32(int16_t, src0, [AVG_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, src1, [AVG_SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [AVG_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [AVG_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, weights, [VVC_GPM_WEIGHT_SIZE * VVC_GPM_WEIGHT_SIZE]);
+    VVCDSPContext c;
+
+    for (int i = 0; i < VVC_GPM_WEIGHT_SIZE * VVC_GPM_WEIGHT_SIZE; i++)
+        weights[i] = rnd() % 9;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        randomize_avg_src((uint8_t*)src0, (uint8_t*)src1, AVG_SRC_BUF_SIZE * sizeof(int16_t));
+        ff_vvc_dsp_init(&c, bit_depth);
+        for (int h = 4; h <= GPM_MAX_SIZE; h *= 2) {
+            for (int w = 4; w <= GPM_MAX_SIZE; w *= 2) {
+                declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, int width, int height,
+                    const int16_t *src0, const int16_t *src1, const uint8_t *weights, int step_x, int step_y);
+
+                if (check_func(c.inter.put_gpm, "put_gpm_%d_%dx%d", bit_depth, w, h)) {
+                    for (int i = 0; i < FF_ARRAY_ELEMS(steps_x); i++) {
+                        const int step_x = steps_x[i];
+                        const int step_y = (rnd() & 1 ? 1 : -1) * VVC_GPM_WEIGHT_SIZE * FFABS(step_x);
+                        const uint8_t *wt = weights + (step_x < 0) * (VVC_GPM_WEIGHT_SIZE - 1) +
+                            (step_y < 0) * (VVC_GPM_WEIGHT_SIZE - 1) * VVC_GPM_WEIGHT_SIZE;
+
+                        // only subsampled chroma blocks are 4 wide
+                        if (w == 4 && FFABS(step_x) == 1)
+                            continue;
+                        memset(dst0, 0, AVG_DST_BUF_SIZE);
+                        memset(dst1, 0, AVG_DST_BUF_SIZE);
+                        call_ref(dst0, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, src0, src1, wt, step_x, step_y);
+                        call_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, src0, src1, wt, step_x, step_y);
+                        if (memcmp(dst0, dst1, AVG_DST_BUF_SIZE))
+                            fail();
+                    }
+                    if (w == h) {
+                        const int step = w == 4 ? 2 : 1;
+                        bench_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, src0, src1, weights,
+                            step, step * VVC_GPM_WEIGHT_SIZE);
+                    }
+                }
+            }
+        }
+    }
+    report("put_gpm");
+}
+
+static void check_put_ciip(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, inter, [AVG_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [AVG_DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [AVG_DST_BUF_SIZE]);
+    VVCDSPContext c;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&c, bit_depth);
+        for (int h = 4; h <= GPM_MAX_SIZE; h *= 2) {
+            for (int w = 4; w <= GPM_MAX_SIZE; w *= 2) {
+                const int intra_weight = rnd() % 3 + 1;
+                declare_func(void, uint8_t *dst, ptrdiff_t dst_stride, int width, int height,
+                    const uint8_t *inter, ptrdiff_t inter_stride, int intra_weight);
+
+                if (check_func(c.inter.put_ciip, "put_ciip_%d_%dx%d", bit_depth, w, h)) {
+                    randomize_pixels(dst0, dst1, AVG_DST_BUF_SIZE);
+                    randomize_pixels(inter, inter, AVG_DST_BUF_SIZE);
+                    call_ref(dst0, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, inter, MAX_PB_SIZE * SIZEOF_PIXEL, intra_weight);
+                    call_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, inter, MAX_PB_SIZE * SIZEOF_PIXEL, intra_weight);
+                    if (memcmp(dst0, dst1, AVG_DST_BUF_SIZE))
+                        fail();
+                    if (w == h)
+                        bench_new(dst1, MAX_CTU_SIZE * SIZEOF_PIXEL, w, h, inter, MAX_PB_SIZE * SIZEOF_PIXEL, intra_weight);
+                }
+            }
+        }
+    }
+    report("put_ciip");
+}
+
 static void check_vvc_sad(void)
 {
     const int bit_depth = 10;
@@ -361,12 +755,90 @@ static void check_vvc_sad(void)
     report("sad");
 }
 
+static void check_vvc_dmvr_sad(void)
+{
+    const int bit_depth = 10;
+    VVCDSPContext c;
+    LOCAL_ALIGNED_32(uint16_t, src0, [MAX_CTU_SIZE * MAX_CTU_SIZE * 4]);
+    LOCAL_ALIGNED_32(uint16_t, src1, [MAX_CTU_SIZE * MAX_CTU_SIZE * 4]);
+    int sad0[25], sad1[25];
+    declare_func(void, int *sad, const int16_t *src0, const int16_t *src1, int block_w, int block_h);
+
+    ff_vvc_dsp_init(&c, bit_depth);
+    randomize_pixels(src0, src1, MAX_CTU_SIZE * MAX_CTU_SIZE * 4);
+    randomize_pixels(src1, src1, MAX_CTU_SIZE * MAX_CTU_SIZE * 4);
+    for (int h = 8; h <= 16; h *= 2) {
+        for (int w = 8; w <= 16; w *= 2) {
+            if (check_func(c.inter.dmvr_sad, "dmvr_sad_%dx%d", w, h)) {
+                call_ref(sad0, (int16_t *)src0, (int16_t *)src1, w, h);
+                call_new(sad1, (int16_t *)src0, (int16_t *)src1, w, h);
+                // the centre is unspecified
+                sad0[12] = sad1[12] = 0;
+                if (memcmp(sad0, sad1, sizeof(sad0)))
+                    fail();
+                bench_new(sad1, (int16_t *)src0, (int16_t *)src1, w, h);
+            }
+        }
+    }
+    report("dmvr_sad");
+}
+
+static void check_dmvr(void)
+{
+    static const char *const type[2][2] = { { "pixels", "h" }, { "v", "hv" } };
+    LOCAL_ALIGNED_32(uint8_t, src, [SRC_BUF_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, dst0, [MAX_PB_SIZE * MAX_PB_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, dst1, [MAX_PB_SIZE * MAX_PB_SIZE]);
+    VVCDSPContext c;
+
+    declare_func(void, int16_t *dst, const uint8_t *src, ptrdiff_t src_stride, int height,
+        intptr_t mx, intptr_t my, int width);
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        const ptrdiff_t src_stride = PIXEL_STRIDE * SIZEOF_PIXEL;
+
+        ff_vvc_dsp_init(&c, bit_depth);
+        randomize_pixels(src, src, SRC_BUF_SIZE);
+        for (int j = 0; j < 2; j++) {
+            for (int i = 0; i < 2; i++) {
+                // the DMVR block is the 8 or 16 sample sub-block plus the search range of 2 on each side
+                for (int h = 12; h <= 20; h += 8) {
+                    for (int w = 12; w <= 20; w += 8) {
+                        const int mx = i ? rnd() % 15 + 1 : 0;
+                        const int my = j ? rnd() % 15 + 1 : 0;
+
+                        if (check_func(c.inter.dmvr[j][i], "dmvr_%s_%d_%dx%d", type[j][i], bit_depth, w, h)) {
+                            memset(dst0, 0, MAX_PB_SIZE * MAX_PB_SIZE * sizeof(int16_t));
+                            memset(dst1, 0, MAX_PB_SIZE * MAX_PB_SIZE * sizeof(int16_t));
+                            call_ref(dst0, src + SRC_OFFSET, src_stride, h, mx, my, w);
+                            call_new(dst1, src + SRC_OFFSET, src_stride, h, mx, my, w);
+                            if (memcmp(dst0, dst1, MAX_PB_SIZE * MAX_PB_SIZE * sizeof(int16_t)))
+                                fail();
+                            bench_new(dst1, src + SRC_OFFSET, src_stride, h, mx, my, w);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    report("dmvr");
+}
+
 void checkasm_check_vvc_mc(void)
 {
     check_vvc_sad();
+    check_vvc_dmvr_sad();
+    check_dmvr();
     check_put_vvc_luma();
     check_put_vvc_luma_uni();
     check_put_vvc_chroma();
     check_put_vvc_chroma_uni();
+    check_put_vvc_uni_w();
+    check_put_vvc_scaled();
     check_avg();
+    check_apply_bdof();
+    check_bdof_fetch_samples();
+    check_prof();
+    check_put_gpm();
+    check_put_ciip();
 }
@@ -0,0 +1,150 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/vvc/ctu.h"
+#include "libavcodec/vvc/dsp.h"
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/mem_internal.h"
+
+static const uint32_t pixel_mask[3] = { 0xffffffff, 0x03ff03ff, 0x0fff0fff };
+static const int sao_size[9] = { 8, 16, 32, 48, 64, 80, 96, 112, 128 };
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define DST_STRIDE (MAX_CTU_SIZE * 2)
+#define DST_BUF_SIZE (DST_STRIDE * MAX_CTU_SIZE)
+// same as the implicit source stride of the edge filter, see ff_vvc_sao_filter()
+#define SRC_STRIDE (2 * MAX_PB_SIZE + AV_INPUT_BUFFER_PADDING_SIZE)
+#define SRC_BUF_SIZE (SRC_STRIDE * (MAX_CTU_SIZE + 2)) // +2 for the top and bottom rows
+#define SRC_OFFSET (SRC_STRIDE + AV_INPUT_BUFFER_PADDING_SIZE)
+
+#define randomize_pixels(buf0, buf1, size)                  \
+    do {                                                    \
+        uint32_t mask = pixel_mask[(bit_depth - 8) >> 1];   \
+        for (int k = 0; k < size; k += 4) {                 \
+            uint32_t r = rnd() & mask;                      \
+            AV_WN32A(buf0 + k, r);                          \
+            AV_WN32A(buf1 + k, r);                          \
+        }                                                   \
+    } while (0)
+
+// SaoOffsetVal as derived in hls_sao(), offset_val[0] is always 0
+static void randomize_offsets(int16_t *offset_val, const int bit_depth)
+{
+    const int shift      = bit_depth - FFMIN(bit_depth, 10);
+    const int max_offset = (1 << (FFMIN(bit_depth, 10) - 5)) - 1;
+
+    offset_val[0] = 0;
+    for (int i = 1; i < 5; i++)
+        offset_val[i] = ((int)(rnd() % (2 * max_offset + 1)) - max_offset) * (1 << shift);
+}
+
+static int cmp_rows(const uint8_t *buf0, const uint8_t *buf1, ptrdiff_t stride, int width, int height)
+{
+    for (int y = 0; y < height; y++) {
+        if (memcmp(buf0 + y * stride, buf1 + y * stride, width))
+            return 1;
+    }
+    return 0;
+}
+
+static void check_sao_band(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, buf1, [DST_BUF_SIZE]);
+    const ptrdiff_t stride = DST_STRIDE;
+    int16_t offset_val[5];
+
+    declare_func(void, uint8_t *dst, const uint8_t *src, ptrdiff_t dst_stride, ptrdiff_t src_stride,
+        const int16_t *sao_offset_val, int sao_left_class, int width, int height);
+
+    for (int i = 0; i < FF_ARRAY_ELEMS(sao_size); i++) {
+        const int block_size = sao_size[i];
+        const int prev_size  = i > 0 ? sao_size[i - 1] : 0;
+
+        if (check_func(c->sao.band_filter[i], "vvc_sao_band_%d_%d", block_size, bit_depth)) {
+            // the filter is run in place on the frame, and only the first width samples count
+            for (int w = prev_size + 4; w <= block_size; w += 4) {
+                const int h          = rnd() % MAX_CTU_SIZE + 1;
+                const int left_class = rnd() % 32;
+
+                randomize_pixels(buf0, buf1, DST_BUF_SIZE);
+                randomize_offsets(offset_val, bit_depth);
+                call_ref(buf0, buf0, stride, stride, offset_val, left_class, w, h);
+                call_new(buf1, buf1, stride, stride, offset_val, left_class, w, h);
+                if (cmp_rows(buf0, buf1, stride, w * SIZEOF_PIXEL, h))
+                    fail();
+            }
+            bench_new(buf1, buf1, stride, stride, offset_val, 0, block_size, block_size);
+        }
+    }
+}
+
+static void check_sao_edge(VVCDSPContext *c, const int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src, [SRC_BUF_SIZE]);
+    const ptrdiff_t stride = DST_STRIDE;
+    int16_t offset_val[5];
+
+    declare_func(void, uint8_t *dst, const uint8_t *src, ptrdiff_t stride_dst,
+        const int16_t *sao_offset_val, int eo, int width, int height);
+
+    for (int i = 0; i < FF_ARRAY_ELEMS(sao_size); i++) {
+        const int block_size = sao_size[i];
+        const int prev_size  = i > 0 ? sao_size[i - 1] : 0;
+
+        if (check_func(c->sao.edge_filter[i], "vvc_sao_edge_%d_%d", block_size, bit_depth)) {
+            for (int w = prev_size + 4; w <= block_size; w += 4) {
+                const int h  = rnd() % MAX_CTU_SIZE + 1;
+                const int eo = rnd() % 4;
+
+                randomize_pixels(src, src, SRC_BUF_SIZE);
+                randomize_pixels(dst0, dst1, DST_BUF_SIZE);
+                randomize_offsets(offset_val, bit_depth);
+                call_ref(dst0, src + SRC_OFFSET, stride, offset_val, eo, w, h);
+                call_new(dst1, src + SRC_OFFSET, stride, offset_val, eo, w, h);
+                if (cmp_rows(dst0, dst1, stride, w * SIZEOF_PIXEL, h))
+                    fail();
+            }
+            bench_new(dst1, src + SRC_OFFSET, stride, offset_val, 0, block_size, block_size);
+        }
+    }
+}
+
+void checkasm_check_vvc_sao(void)
+{
+    VVCDSPContext h;
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_sao_band(&h, bit_depth);
+    }
+    report("sao_band");
+
+    for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_vvc_dsp_init(&h, bit_depth);
+        check_sao_edge(&h, bit_depth);
+    }
+    report("sao_edge");
+}
@@ -57,7 +57,7 @@ cextern fail_func
 
 ; max number of args used by any asm function.
 ; (max_args % 4) must equal 3 for stack alignment
-%define max_args 15
+%define max_args 19
 
 %if ARCH_X86_64
 